@@ -0,0 +1,53 @@
+# Locate FFTW library (double precision)
+# This module defines
+#  FFTW_FOUND
+#  FFTW_LIBRARIES
+#  FFTW_INCLUDE_DIR
+#
+
+#=============================================================================
+# Copyright 2026 The HALMD developers
+#
+# Distributed under the OSI-approved BSD License (the "License");
+# see accompanying file Copyright.txt for details.
+#
+# This software is distributed WITHOUT ANY WARRANTY; without even the
+# implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+# See the License for more information.
+#=============================================================================
+# (To distribute this file outside of CMake, substitute the full
+#  License text for the above reference.)
+
+find_path(FFTW_INCLUDE_DIR fftw3.h
+  HINTS
+    ENV FFTW_DIR
+  PATH_SUFFIXES include
+)
+
+if(FFTW_USE_STATIC_LIBS)
+  set( _FFTW_ORIG_CMAKE_FIND_LIBRARY_SUFFIXES ${CMAKE_FIND_LIBRARY_SUFFIXES})
+  set(CMAKE_FIND_LIBRARY_SUFFIXES .a ${CMAKE_FIND_LIBRARY_SUFFIXES})
+endif()
+
+find_library(FFTW_LIBRARY
+  NAMES fftw3
+  HINTS
+    ENV FFTW_DIR
+  PATH_SUFFIXES lib64 lib
+)
+
+if(FFTW_USE_STATIC_LIBS)
+  set(CMAKE_FIND_LIBRARY_SUFFIXES ${_FFTW_ORIG_CMAKE_FIND_LIBRARY_SUFFIXES})
+endif()
+
+if(FFTW_LIBRARY)
+  set(FFTW_LIBRARIES "${FFTW_LIBRARY}")
+endif()
+
+include(FindPackageHandleStandardArgs)
+# handle the QUIETLY and REQUIRED arguments and set FFTW_FOUND to TRUE if
+# all listed variables are TRUE
+find_package_handle_standard_args(FFTW
+                                  REQUIRED_VARS FFTW_LIBRARIES FFTW_INCLUDE_DIR)
+
+mark_as_advanced(FFTW_INCLUDE_DIR FFTW_LIBRARY)
@@ -25,6 +25,10 @@ if(HALMD_WITH_GPU)
 
 endif(HALMD_WITH_GPU)
 
+if(HALMD_WITH_FFTW)
+  add_definitions(-DHALMD_WITH_FFTW)
+endif(HALMD_WITH_FFTW)
+
 #
 # The following option only works on x86-64 by default, which always uses the
 # SSE instruction set for floating-point math. On i386, the x87 floating-point
@@ -41,3 +45,17 @@ set(HALMD_VARIANT_HOST_SINGLE_PRECISION FALSE CACHE BOOL
 if(HALMD_VARIANT_HOST_SINGLE_PRECISION)
   add_definitions(-DUSE_HOST_SINGLE_PRECISION)
 endif(HALMD_VARIANT_HOST_SINGLE_PRECISION)
+
+set(HALMD_VARIANT_HOST_OPENMP TRUE CACHE BOOL
+  "Use OpenMP thread parallelism in host implementation")
+if(HALMD_VARIANT_HOST_OPENMP)
+  find_package(OpenMP QUIET)
+endif(HALMD_VARIANT_HOST_OPENMP)
+if(HALMD_VARIANT_HOST_OPENMP AND OPENMP_FOUND)
+  set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} ${OpenMP_CXX_FLAGS}")
+  set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} ${OpenMP_CXX_FLAGS}")
+  set(CMAKE_SHARED_LINKER_FLAGS "${CMAKE_SHARED_LINKER_FLAGS} ${OpenMP_CXX_FLAGS}")
+elseif(CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+  # host loops are annotated with OpenMP pragmas regardless
+  set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -Wno-unknown-pragmas")
+endif()
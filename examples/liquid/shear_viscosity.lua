@@ -86,7 +86,7 @@ local function shear_viscosity(args)
       , every = 500
       , start = math.floor(equi_steps / 2)
       , desc = "averaged internal energy"
-      , aux_enable = {particle}
+      , aux_enable = {msv}
     })
 
     -- sample initial state
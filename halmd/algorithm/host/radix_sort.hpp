@@ -22,23 +22,117 @@
 #define HALMD_ALGORITHM_HOST_RADIX_SORT_HPP
 
 #include <algorithm>
-#include <array>
+#include <cstddef>
 #include <iterator>
 #include <limits>
+#include <type_traits>
 #include <vector>
 
 namespace halmd {
+namespace detail {
+namespace radix_sort {
+
+/** number of bits per radix sort pass */
+unsigned int constexpr radix_bits = 8;
+/** number of buckets per radix sort pass */
+std::size_t constexpr radix_size = 1 << radix_bits;
+/** minimum number of elements per parallel chunk */
+std::size_t constexpr chunk_min = 1 << 15;
+/** maximum number of parallel chunks */
+std::size_t constexpr chunk_max = 64;
+
+/**
+ * Stable counting sort of keys by one digit.
+ *
+ * The input is divided into contiguous chunks, which are processed in
+ * parallel. Each chunk counts the digits of its keys, and the output offsets
+ * of the buckets follow from an exclusive prefix sum over the counts in the
+ * order (digit, chunk). The number of chunks depends on the number of
+ * elements only, which renders the result independent of the number of
+ * threads.
+ *
+ * The functor move(i, j) moves the element with input index i to output
+ * index j.
+ *
+ * Returns false if all keys share the same digit, in which case no element
+ * is moved.
+ */
+template <typename KeyIterator, typename Move>
+bool pass(
+    KeyIterator key
+  , std::size_t count
+  , unsigned int shift
+  , std::vector<std::size_t>& offset
+  , Move move
+)
+{
+    std::size_t const nchunk = std::max(std::size_t(1), std::min(chunk_max, count / chunk_min));
+    std::size_t const chunk_size = (count + nchunk - 1) / nchunk;
+    std::size_t const mask = radix_size - 1;
+
+    offset.assign(radix_size * nchunk, 0);
+
+#pragma omp parallel for if(nchunk > 1)
+    for (long c = 0; c < long(nchunk); ++c) {
+        std::size_t const first = c * chunk_size;
+        std::size_t const last = std::min(count, first + chunk_size);
+        for (std::size_t i = first; i < last; ++i) {
+            ++offset[((key[i] >> shift) & mask) * nchunk + c];
+        }
+    }
+
+    // skip pass if all keys fall into a single bucket
+    for (std::size_t d = 0; d < radix_size; ++d) {
+        std::size_t n = 0;
+        for (std::size_t c = 0; c < nchunk; ++c) {
+            n += offset[d * nchunk + c];
+        }
+        if (n == count) {
+            return false;
+        }
+        if (n > 0) {
+            break;
+        }
+    }
+
+    // exclusive prefix sum
+    std::size_t sum = 0;
+    for (std::size_t& n : offset) {
+        std::size_t const m = n;
+        n = sum;
+        sum += m;
+    }
+
+#pragma omp parallel for if(nchunk > 1)
+    for (long c = 0; c < long(nchunk); ++c) {
+        std::size_t const first = c * chunk_size;
+        std::size_t const last = std::min(count, first + chunk_size);
+        for (std::size_t i = first; i < last; ++i) {
+            move(i, offset[((key[i] >> shift) & mask) * nchunk + c]++);
+        }
+    }
+    return true;
+}
+
+} // namespace radix_sort
+} // namespace detail
 
 /**
  * In-place radix sort.
  *
+ * This function implements a least-significant-digit radix sort of unsigned
+ * integer keys, using 8-bit digits. Each pass is a stable counting sort
+ * between the input range and a single scratch buffer, parallelised over
+ * chunks of the input. Passes over digits that are equal for all keys are
+ * skipped.
+ *
  * Refer to the unit test for a performance comparison with std::sort.
  */
 template <typename Iterator>
 typename std::enable_if<
-    std::is_convertible<
+    std::is_same<
         typename std::iterator_traits<Iterator>::iterator_category
-      , std::forward_iterator_tag
+      , std::random_access_iterator_tag
     >::value
     && std::numeric_limits<
         typename std::iterator_traits<Iterator>::value_type
@@ -46,32 +140,88 @@ typename std::enable_if<
   , void>::type radix_sort(Iterator const& first, Iterator const& last)
 {
     typedef typename std::iterator_traits<Iterator>::value_type value_type;
-    typedef std::vector<value_type> bucket_type;
 
     unsigned int constexpr digits = std::numeric_limits<value_type>::digits;
-    unsigned int constexpr shift = 8;
-    unsigned int constexpr size = 1 << shift;
-    unsigned int constexpr mask = size - 1;
-
-    std::array<bucket_type, size> buckets;
-    for (unsigned int offset = 0; offset < digits; offset += shift) {
-        std::for_each(
-            first
-          , last
-          , [&](value_type const& value) {
-                buckets[(value >> offset) & mask].push_back(value);
-            }
-        );
-        Iterator output = first;
-        for (bucket_type& bucket : buckets) {
-            output = std::copy(
-                bucket.begin()
-              , bucket.end()
-              , output
-            );
-            bucket.clear();
+    std::size_t const count = last - first;
+
+    std::vector<value_type> buffer(count);
+    std::vector<std::size_t> offset;
+    bool in_buffer = false;
+
+    for (unsigned int shift = 0; shift < digits; shift += detail::radix_sort::radix_bits) {
+        bool moved;
+        if (!in_buffer) {
+            moved = detail::radix_sort::pass(first, count, shift, offset, [&](std::size_t i, std::size_t j) {
+                buffer[j] = first[i];
+            });
+        }
+        else {
+            moved = detail::radix_sort::pass(buffer.begin(), count, shift, offset, [&](std::size_t i, std::size_t j) {
+                first[j] = buffer[i];
+            });
+        }
+        in_buffer ^= moved;
+    }
+    if (in_buffer) {
+        std::copy(buffer.begin(), buffer.end(), first);
+    }
+}
+
+/**
+ * In-place radix sort of keys and values.
+ *
+ * The values are reordered along with the keys. The sort is stable, i.e.
+ * values with equal keys retain their order.
+ *
+ * Returns iterator to the end of the value range.
+ */
+template <typename KeyIterator, typename ValueIterator>
+typename std::enable_if<
+    std::is_same<
+        typename std::iterator_traits<KeyIterator>::iterator_category
+      , std::random_access_iterator_tag
+    >::value
+    && std::is_same<
+        typename std::iterator_traits<ValueIterator>::iterator_category
+      , std::random_access_iterator_tag
+    >::value
+    && std::numeric_limits<
+        typename std::iterator_traits<KeyIterator>::value_type
+    >::is_integer
+  , ValueIterator>::type radix_sort(KeyIterator const& first, KeyIterator const& last, ValueIterator const& value)
+{
+    typedef typename std::iterator_traits<KeyIterator>::value_type key_type;
+    typedef typename std::iterator_traits<ValueIterator>::value_type value_type;
+
+    unsigned int constexpr digits = std::numeric_limits<key_type>::digits;
+    std::size_t const count = last - first;
+
+    std::vector<key_type> key_buffer(count);
+    std::vector<value_type> value_buffer(count);
+    std::vector<std::size_t> offset;
+    bool in_buffer = false;
+
+    for (unsigned int shift = 0; shift < digits; shift += detail::radix_sort::radix_bits) {
+        bool moved;
+        if (!in_buffer) {
+            moved = detail::radix_sort::pass(first, count, shift, offset, [&](std::size_t i, std::size_t j) {
+                key_buffer[j] = first[i];
+                value_buffer[j] = value[i];
+            });
+        }
+        else {
+            moved = detail::radix_sort::pass(key_buffer.begin(), count, shift, offset, [&](std::size_t i, std::size_t j) {
+                first[j] = key_buffer[i];
+                value[j] = value_buffer[i];
+            });
         }
+        in_buffer ^= moved;
+    }
+    if (in_buffer) {
+        std::copy(key_buffer.begin(), key_buffer.end(), first);
+        std::copy(value_buffer.begin(), value_buffer.end(), value);
     }
+    return value + count;
 }
 
 } // namespace halmd
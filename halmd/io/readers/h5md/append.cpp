@@ -24,7 +24,9 @@
 #include <boost/algorithm/string/join.hpp> // boost::join
 #include <cmath> // std::signbit
 #include <limits>
+#include <stdint.h> // int32_t, int64_t, uint64_t
 #include <tuple>
+#include <type_traits>
 #include <luaponte/luaponte.hpp>
 #include <luaponte/out_value_policy.hpp>
 #include <stdexcept>
@@ -42,6 +44,218 @@ namespace io {
 namespace readers {
 namespace h5md {
 
+/**
+ * Index of the step and time datasets of a time series group
+ *
+ * The datasets are read upon the first lookup. If the steps or times are
+ * regularly spaced, the index of a sample is computed arithmetically.
+ *
+ * A group with the attribute piecewise_constant holds samples that are
+ * written only upon changes. A lookup then yields the last sample at or
+ * before the given step or time.
+ */
+class append::series_index
+{
+public:
+    explicit series_index(H5::Group const& group)
+      : group_(group), loaded_(false), constant_(false), step_stride_(0), time_stride_(0), next_(0) {}
+
+    /** returns index of given step, or throws domain_error */
+    hsize_t find_step(step_difference_type offset);
+    /** returns index of given time, or throws domain_error */
+    hsize_t find_time(time_difference_type offset);
+    /** returns index following the last index found */
+    hsize_t find_next();
+    /** returns step of sample following the last index found, or throws domain_error */
+    step_type next_step();
+
+    /** returns true if samples hold until the next sample */
+    bool constant()
+    {
+        load();
+        return constant_;
+    }
+
+    H5::Group const& group() const
+    {
+        return group_;
+    }
+
+private:
+    /** read step and time datasets and detect regular spacing */
+    void load();
+
+    /** time series group */
+    H5::Group group_;
+    /** true if step and time datasets have been read */
+    bool loaded_;
+    /** true if samples hold until the next sample */
+    bool constant_;
+    /** steps of samples */
+    std::vector<step_type> steps_;
+    /** times of samples */
+    std::vector<time_type> times_;
+    /** difference of regularly spaced steps, or 0 */
+    step_type step_stride_;
+    /** difference of regularly spaced times, or 0 */
+    time_type time_stride_;
+    /** index following the last index found */
+    hsize_t next_;
+};
+
+/**
+ * Compare two floating-point time values with a tolerance for rounding
+ * errors, see read_time_index().
+ */
+static bool time_less(append::time_type time1, append::time_type time2)
+{
+    return (time1 * (1 + 100 * numeric_limits<append::time_type>::epsilon()) < time2);
+}
+
+void append::series_index::load()
+{
+    if (loaded_) {
+        return;
+    }
+    h5xx::read_dataset(group_.openDataSet("step"), steps_);
+    if (steps_.size() < 1) {
+        throw runtime_error("empty step dataset");
+    }
+    h5xx::read_dataset(group_.openDataSet("time"), times_);
+    if (times_.size() != steps_.size()) {
+        throw runtime_error("mismatching extents of step and time datasets");
+    }
+
+    size_t const size = steps_.size();
+    if (size > 1 && steps_[1] > steps_[0]) {
+        step_stride_ = steps_[1] - steps_[0];
+        for (size_t i = 2; i < size && step_stride_ > 0; ++i) {
+            if (steps_[i] != steps_[0] + i * step_stride_) {
+                step_stride_ = 0;
+            }
+        }
+    }
+    if (size > 1 && times_.back() > times_.front()) {
+        time_stride_ = (times_.back() - times_.front()) / (size - 1);
+        for (size_t i = 1; i < size && time_stride_ > 0; ++i) {
+            time_type time = times_[0] + i * time_stride_;
+            if (time_less(time, times_[i]) || time_less(times_[i], time)) {
+                time_stride_ = 0;
+            }
+        }
+    }
+    constant_ = h5xx::exists_attribute(group_, "piecewise_constant")
+        && h5xx::read_attribute<bool>(group_, "piecewise_constant");
+    LOG_DEBUG("read " << size << " steps of " << h5xx::path(group_)
+              << (step_stride_ > 0 ? " with regular spacing" : "")
+              << (constant_ ? " of piecewise constant data" : ""));
+    loaded_ = true;
+}
+
+hsize_t append::series_index::find_step(step_difference_type offset)
+{
+    load();
+    step_type step = (offset < 0) ? (offset + steps_.back() + 1) : offset;
+    if (constant_) {
+        // the sample holds until the next sample
+        auto last = upper_bound(steps_.begin(), steps_.end(), step);
+        if (last == steps_.begin()) {
+            LOG_ERROR("no step " << step << " or earlier in dataset " << h5xx::path(group_) << "/step");
+            throw domain_error("nonexistent step");
+        }
+        hsize_t index = (last - steps_.begin()) - 1;
+        LOG("reading " << h5xx::path(group_) << " at step " << steps_[index]);
+        next_ = index + 1;
+        return index;
+    }
+    if (step_stride_ > 0) {
+        if (step >= steps_.front() && (step - steps_.front()) % step_stride_ == 0) {
+            hsize_t index = (step - steps_.front()) / step_stride_;
+            if (index < steps_.size()) {
+                LOG("reading " << h5xx::path(group_) << " at step " << step);
+                next_ = index + 1;
+                return index;
+            }
+        }
+        LOG_ERROR("no step " << step << " in dataset " << h5xx::path(group_) << "/step");
+        throw domain_error("nonexistent step");
+    }
+    std::vector<step_type>::const_iterator first, last;
+    tie(first, last) = equal_range(steps_.begin(), steps_.end(), step);
+    if (first == last) {
+        LOG_ERROR("no step " << step << " in dataset " << h5xx::path(group_) << "/step");
+        throw domain_error("nonexistent step");
+    }
+    if (last - first > 1) {
+        LOG_ERROR("ambiguous step " << step << " in dataset " << h5xx::path(group_) << "/step");
+        throw domain_error("ambiguous step");
+    }
+    LOG("reading " << h5xx::path(group_) << " at step " << *first);
+    next_ = (first - steps_.begin()) + 1;
+    return first - steps_.begin();
+}
+
+hsize_t append::series_index::find_time(time_difference_type offset)
+{
+    load();
+    time_type time = signbit(offset) ? (offset + times_.back()) : offset;
+    if (constant_) {
+        auto last = upper_bound(times_.begin(), times_.end(), time, time_less);
+        if (last == times_.begin()) {
+            LOG_ERROR("no time " << time << " or earlier in dataset " << h5xx::path(group_) << "/time");
+            throw domain_error("nonexistent time");
+        }
+        hsize_t index = (last - times_.begin()) - 1;
+        LOG("reading " << h5xx::path(group_) << " at time " << times_[index]);
+        next_ = index + 1;
+        return index;
+    }
+    if (time_stride_ > 0) {
+        double position = round((time - times_.front()) / time_stride_);
+        if (position >= 0 && position < times_.size()) {
+            hsize_t index = position;
+            time_type found = times_[index];
+            if (!time_less(found, time) && !time_less(time, found)) {
+                LOG("reading " << h5xx::path(group_) << " at time " << found);
+                next_ = index + 1;
+                return index;
+            }
+        }
+        LOG_ERROR("no time " << time << " in dataset " << h5xx::path(group_) << "/time");
+        throw domain_error("nonexistent time");
+    }
+    std::vector<time_type>::const_iterator first, last;
+    tie(first, last) = equal_range(times_.begin(), times_.end(), time, time_less);
+    if (first == last) {
+        LOG_ERROR("no time " << time << " in dataset " << h5xx::path(group_) << "/time");
+        throw domain_error("nonexistent time");
+    }
+    if (last - first > 1) {
+        LOG_ERROR("ambiguous time " << time << " in dataset " << h5xx::path(group_) << "/time");
+        throw domain_error("ambiguous time");
+    }
+    LOG("reading " << h5xx::path(group_) << " at time " << *first);
+    next_ = (first - times_.begin()) + 1;
+    return first - times_.begin();
+}
+
+hsize_t append::series_index::find_next()
+{
+    next_step();
+    LOG_DEBUG("reading " << h5xx::path(group_) << " at step " << steps_[next_]);
+    return next_++;
+}
+
+append::step_type append::series_index::next_step()
+{
+    load();
+    if (next_ >= steps_.size()) {
+        LOG_ERROR("no further sample in " << h5xx::path(group_));
+        throw domain_error("no further sample");
+    }
+    return steps_[next_];
+}
+
 append::append(
     H5::Group const& root
   , vector<string> const& location
@@ -59,12 +273,68 @@ connection append::on_read(
   , std::function<T ()> const& slot
   , vector<string> const& location
 )
+{
+    return connect_dataset(group, slot, location, nullptr);
+}
+
+template <typename T>
+connection append::on_read_index(
+    subgroup_type& group
+  , std::function<T ()> const& slot
+  , vector<string> const& location
+  , vector<unsigned int> const& index
+)
+{
+    // merge sorted indices into runs of consecutive rows
+    vector<unsigned int> sorted(index);
+    sort(sorted.begin(), sorted.end());
+    sorted.erase(unique(sorted.begin(), sorted.end()), sorted.end());
+    auto rows = std::make_shared<selection_type>();
+    for (unsigned int i : sorted) {
+        if (!rows->empty() && rows->back().first + rows->back().second == i) {
+            ++rows->back().second;
+        }
+        else {
+            rows->push_back(make_pair(i, 1));
+        }
+    }
+    return connect_dataset(group, slot, location, rows);
+}
+
+template <typename T>
+connection append::on_read_range(
+    subgroup_type& group
+  , std::function<T ()> const& slot
+  , vector<string> const& location
+  , unsigned int first
+  , unsigned int last
+)
+{
+    if (last < first) {
+        throw invalid_argument("invalid range of rows");
+    }
+    auto rows = std::make_shared<selection_type>();
+    if (last > first) {
+        rows->push_back(make_pair(first, last - first));
+    }
+    return connect_dataset(group, slot, location, rows);
+}
+
+template <typename T>
+connection append::connect_dataset(
+    subgroup_type& group
+  , std::function<T ()> const& slot
+  , vector<string> const& location
+  , std::shared_ptr<selection_type const> rows
+)
 {
     if (location.size() < 1) {
         throw invalid_argument("dataset location");
     }
     group = h5xx::open_group(group_, boost::join(location, "/"));
-    return on_read_.connect(bind(&read_dataset<T>, group, slot, _1));
+    auto index = std::make_shared<series_index>(group);
+    index_.push_back(index);
+    return on_read_.connect(bind(&read_dataset<T>, index, slot, rows, _1));
 }
 
 connection append::on_prepend_read(slot_function_type const& slot)
@@ -91,15 +361,231 @@ void append::read_at_time(time_difference_type offset)
     on_append_read_();
 }
 
+void append::read_next()
+{
+    // piecewise constant data are read at the step of the next sample of
+    // the first other time series, or follow their own samples otherwise
+    bool driven = false;
+    step_type step = 0;
+    for (std::weak_ptr<series_index> const& weak : index_) {
+        std::shared_ptr<series_index> index = weak.lock();
+        if (index && !index->constant()) {
+            step = index->next_step();
+            driven = true;
+            break;
+        }
+    }
+    on_prepend_read_();
+    on_read_(bind(&read_next_index, driven, step, _1));
+    on_append_read_();
+}
+
+/**
+ * Read the sum of consecutive samples of a dataset, which is restricted to
+ * the given rows of each sample if rows is non-null.
+ *
+ * The rows are read by a single hyperslab selection of a few contiguous
+ * blocks, where runs of rows are coalesced if they are closer than the
+ * extent of a chunk, as then the chunks in between are read anyway.
+ *
+ * Returns the values of the summed sample in row-major order.
+ */
+static vector<double> read_rows(
+    H5::DataSet const& dataset
+  , hsize_t first
+  , hsize_t count
+  , append::selection_type const* rows
+  , vector<hsize_t>& shape
+)
+{
+    H5::DataSpace space = dataset.getSpace();
+    vector<hsize_t> dims(space.getSimpleExtentNdims());
+    space.getSimpleExtentDims(&dims[0]);
+    if (dims.empty() || first + count > dims[0]) {
+        throw out_of_range("sample index exceeds extent of dataset");
+    }
+    if (rows && dims.size() < 2) {
+        throw invalid_argument("dataset has no rows to select");
+    }
+    shape.assign(dims.begin() + 1, dims.end());
+    size_t stride = 1;
+    for (size_t i = 2; i < dims.size(); ++i) {
+        stride *= dims[i];
+    }
+
+    // coalesce runs of rows within the extent of a chunk
+    append::selection_type blocks;
+    if (rows) {
+        hsize_t chunk_rows = dims[1];
+        H5::DSetCreatPropList dcpl = dataset.getCreatePlist();
+        if (dcpl.getLayout() == H5D_CHUNKED) {
+            vector<hsize_t> chunk(dims.size());
+            dcpl.getChunk(chunk.size(), &chunk[0]);
+            chunk_rows = chunk[1];
+        }
+        shape[0] = 0;
+        for (auto const& run : *rows) {
+            if (run.first + run.second > dims[1]) {
+                throw out_of_range("row index exceeds extent of dataset");
+            }
+            shape[0] += run.second;
+            if (!blocks.empty() && run.first < blocks.back().first + blocks.back().second + chunk_rows) {
+                blocks.back().second = run.first + run.second - blocks.back().first;
+            }
+            else {
+                blocks.push_back(run);
+            }
+        }
+    }
+    else if (dims.size() > 1) {
+        blocks.push_back(make_pair(0, dims[1]));
+    }
+    if (rows && blocks.empty()) {
+        return vector<double>(); // empty selection
+    }
+
+    hsize_t nrows = 0;
+    vector<hsize_t> start(dims.size(), 0);
+    vector<hsize_t> block = dims;
+    start[0] = first;
+    block[0] = count;
+    if (blocks.empty()) {
+        space.selectHyperslab(H5S_SELECT_SET, &block[0], &start[0]);
+    }
+    else {
+        space.selectNone();
+        for (auto const& run : blocks) {
+            start[1] = run.first;
+            block[1] = run.second;
+            space.selectHyperslab(H5S_SELECT_OR, &block[0], &start[0]);
+            nrows += run.second;
+        }
+    }
+    hsize_t size = dims.size() > 1 ? nrows * stride : 1;
+    vector<double> buffer(count * size);
+    if (!buffer.empty()) {
+        hsize_t npoints = buffer.size();
+        H5::DataSpace mem_space(1, &npoints);
+        dataset.read(&buffer[0], H5::PredType::NATIVE_DOUBLE, mem_space, space);
+    }
+
+    // sum samples
+    for (hsize_t j = 1; j < count; ++j) {
+        for (size_t i = 0; i < size; ++i) {
+            buffer[i] += buffer[j * size + i];
+        }
+    }
+    buffer.resize(size);
+
+    // gather selected rows from coalesced blocks
+    if (!rows) {
+        return buffer;
+    }
+    vector<double> values;
+    values.reserve(shape[0] * stride);
+    auto block_it = blocks.begin();
+    hsize_t offset = 0;
+    for (auto const& run : *rows) {
+        while (run.first >= block_it->first + block_it->second) {
+            offset += block_it->second;
+            ++block_it;
+        }
+        auto begin = buffer.begin() + (offset + run.first - block_it->first) * stride;
+        values.insert(values.end(), begin, begin + run.second * stride);
+    }
+    return values;
+}
+
+/**
+ * Read and decode sample of a dataset stored as quantised integers, which
+ * are delta-encoded against the previous sample within each chunk of
+ * "delta_interval" samples.
+ */
+static vector<double> read_quantised(
+    H5::DataSet const& dataset
+  , hsize_t index
+  , append::selection_type const* rows
+  , vector<hsize_t>& shape
+)
+{
+    H5::Attribute attr = dataset.openAttribute("scale_factor");
+    vector<double> scale(attr.getSpace().getSimpleExtentNpoints());
+    attr.read(H5::PredType::NATIVE_DOUBLE, &scale[0]);
+    uint64_t interval = 1;
+    if (dataset.attrExists("delta_interval")) {
+        dataset.openAttribute("delta_interval").read(H5::PredType::NATIVE_UINT64, &interval);
+    }
+
+    // sum samples from the first sample of the chunk up to the given sample
+    hsize_t first = interval > 0 ? index - index % interval : index;
+    vector<double> values = read_rows(dataset, first, index - first + 1, rows, shape);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] *= scale[i % scale.size()];
+    }
+    return values;
+}
+
+/**
+ * Assign decoded values to sample.
+ */
+template <typename T>
+static typename std::enable_if<std::is_arithmetic<T>::value>::type
+assign_sample(T& sample, double const* values, vector<hsize_t> const&)
+{
+    sample = values[0];
+}
+
+template <typename T, size_t N>
+static void assign_sample(fixed_vector<T, N>& sample, double const* values, vector<hsize_t> const&)
+{
+    copy(values, values + N, sample.begin());
+}
+
+template <typename T, size_t N>
+static void assign_sample(boost::array<T, N>& sample, double const* values, vector<hsize_t> const&)
+{
+    copy(values, values + N, sample.begin());
+}
+
+template <typename T, typename Alloc>
+static void assign_sample(vector<T, Alloc>& sample, double const* values, vector<hsize_t> const& shape)
+{
+    if (shape.empty()) {
+        throw runtime_error("rank of dataset does not match sample");
+    }
+    size_t stride = 1;
+    for (size_t i = 1; i < shape.size(); ++i) {
+        stride *= shape[i];
+    }
+    vector<hsize_t> inner(shape.begin() + 1, shape.end());
+    sample.resize(shape[0]);
+    for (size_t i = 0; i < sample.size(); ++i) {
+        assign_sample(sample[i], values + i * stride, inner);
+    }
+}
+
 template <typename T>
 void append::read_dataset(
-    H5::Group const& group
+    std::shared_ptr<series_index> const& index
   , std::function<T ()> const& slot
-  , index_function_type const& index
+  , std::shared_ptr<selection_type const> const& rows
+  , index_function_type const& find
 )
 {
-    H5::DataSet dataset = group.openDataSet("value");
-    h5xx::read_chunked_dataset(dataset, slot(), index(group));
+    H5::DataSet dataset = index->group().openDataSet("value");
+    if (dataset.attrExists("scale_factor")) {
+        vector<hsize_t> shape;
+        vector<double> values = read_quantised(dataset, find(*index), rows.get(), shape);
+        assign_sample(slot(), values.data(), shape);
+    }
+    else if (rows) {
+        vector<hsize_t> shape;
+        vector<double> values = read_rows(dataset, find(*index), 1, rows.get(), shape);
+        assign_sample(slot(), values.data(), shape);
+    }
+    else {
+        h5xx::read_chunked_dataset(dataset, slot(), find(*index));
+    }
 }
 
 /**
@@ -109,28 +595,10 @@ void append::read_dataset(
  */
 hsize_t append::read_step_index(
     step_difference_type offset
-  , H5::Group const& group
+  , series_index& index
 )
 {
-    H5::DataSet dataset = group.openDataSet("step");
-    std::vector<step_type> steps;
-    h5xx::read_dataset(dataset, steps);
-    if (steps.size() < 1) {
-        throw runtime_error("empty step dataset");
-    }
-    step_type step = (offset < 0) ? (offset + steps.back() + 1) : offset;
-    std::vector<step_type>::const_iterator first, last;
-    tie(first, last) = equal_range(steps.begin(), steps.end(), step);
-    if (first == last) {
-        LOG_ERROR("no step " << step << " in dataset " << h5xx::path(dataset));
-        throw domain_error("nonexistent step");
-    }
-    if (last - first > 1) {
-        LOG_ERROR("ambiguous step " << step << " in dataset " << h5xx::path(dataset));
-        throw domain_error("ambiguous step");
-    }
-    LOG("reading " << h5xx::path(group) << " at step " << *first);
-    return first - steps.begin();
+    return index.find_step(offset);
 }
 
 /**
@@ -149,35 +617,28 @@ hsize_t append::read_step_index(
  */
 hsize_t append::read_time_index(
     time_difference_type offset
-  , H5::Group const& group
+  , series_index& index
 )
 {
-    H5::DataSet dataset = group.openDataSet("time");
-    std::vector<time_type> times;
-    h5xx::read_dataset(dataset, times);
-    if (times.size() < 1) {
-        throw runtime_error("empty time dataset");
-    }
-    time_type time = signbit(offset) ? (offset + times.back()) : offset;
-    std::vector<time_type>::const_iterator first, last;
-    tie(first, last) = equal_range(
-        times.begin()
-      , times.end()
-      , time
-      , [](time_type time1, time_type time2) {
-            return (time1 * (1 + 100 * numeric_limits<time_type>::epsilon()) < time2);
-        }
-    );
-    if (first == last) {
-        LOG_ERROR("no time " << time << " in dataset " << h5xx::path(dataset));
-        throw domain_error("nonexistent time");
-    }
-    if (last - first > 1) {
-        LOG_ERROR("ambiguous time " << time << " in dataset " << h5xx::path(dataset));
-        throw domain_error("ambiguous time");
+    return index.find_time(offset);
+}
+
+/**
+ * Returns the dataset index following the index last read from the group.
+ *
+ * For a group of piecewise constant data, returns the index of the sample
+ * that holds at the given step, if the step is driven by another group.
+ */
+hsize_t append::read_next_index(
+    bool driven
+  , step_type step
+  , series_index& index
+)
+{
+    if (driven && index.constant()) {
+        return index.find_step(step);
     }
-    LOG("reading " << h5xx::path(group) << " at time " << *first);
-    return first - times.begin();
+    return index.find_next();
 }
 
 void append::luaopen(lua_State* L)
@@ -196,6 +657,7 @@ void append::luaopen(lua_State* L)
                         .property("group", &append::group)
                         .def("read_at_step", &append::read_at_step)
                         .def("read_at_time", &append::read_at_time)
+                        .def("read_next", &append::read_next)
                         .def("on_read", &append::on_read<float&>, pure_out_value(_2))
                         .def("on_read", &append::on_read<double&>, pure_out_value(_2))
                         .def("on_read", &append::on_read<fixed_vector<float, 2>&>, pure_out_value(_2))
@@ -211,6 +673,20 @@ void append::luaopen(lua_State* L)
                         .def("on_read", &append::on_read<vector<fixed_vector<double, 3> >&>, pure_out_value(_2))
                         .def("on_read", &append::on_read<vector<boost::array<float, 3> >&>, pure_out_value(_2))
                         .def("on_read", &append::on_read<vector<boost::array<double, 3> >&>, pure_out_value(_2))
+                        .def("on_read_index", &append::on_read_index<vector<float>&>, pure_out_value(_2))
+                        .def("on_read_index", &append::on_read_index<vector<double>&>, pure_out_value(_2))
+                        .def("on_read_index", &append::on_read_index<vector<unsigned int>&>, pure_out_value(_2))
+                        .def("on_read_index", &append::on_read_index<vector<fixed_vector<float, 2> >&>, pure_out_value(_2))
+                        .def("on_read_index", &append::on_read_index<vector<fixed_vector<float, 3> >&>, pure_out_value(_2))
+                        .def("on_read_index", &append::on_read_index<vector<fixed_vector<double, 2> >&>, pure_out_value(_2))
+                        .def("on_read_index", &append::on_read_index<vector<fixed_vector<double, 3> >&>, pure_out_value(_2))
+                        .def("on_read_range", &append::on_read_range<vector<float>&>, pure_out_value(_2))
+                        .def("on_read_range", &append::on_read_range<vector<double>&>, pure_out_value(_2))
+                        .def("on_read_range", &append::on_read_range<vector<unsigned int>&>, pure_out_value(_2))
+                        .def("on_read_range", &append::on_read_range<vector<fixed_vector<float, 2> >&>, pure_out_value(_2))
+                        .def("on_read_range", &append::on_read_range<vector<fixed_vector<float, 3> >&>, pure_out_value(_2))
+                        .def("on_read_range", &append::on_read_range<vector<fixed_vector<double, 2> >&>, pure_out_value(_2))
+                        .def("on_read_range", &append::on_read_range<vector<fixed_vector<double, 3> >&>, pure_out_value(_2))
                         .def("on_prepend_read", &append::on_prepend_read)
                         .def("on_append_read", &append::on_append_read)
                 ]
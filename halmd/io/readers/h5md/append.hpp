@@ -22,6 +22,9 @@
 #define HALMD_IO_READERS_H5MD_APPEND_HPP
 
 #include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
 #include <lua.hpp>
 
 #include <h5xx/h5xx.hpp>
@@ -46,6 +49,20 @@ namespace h5md {
  * to core:on_prepend_setup for reading a phase space sample. Further
  * signals on_prepend_read and on_append_read are provided to call
  * arbitrary slots before and after reading.
+ *
+ * The step and time datasets of each group are read once upon the first
+ * lookup. For regularly spaced steps or times, the index of a sample is
+ * computed arithmetically, otherwise by binary search. The samples following
+ * the last sample read may be read with read_next() without any lookup.
+ * Groups marked with the attribute piecewise_constant hold samples that are
+ * written only upon changes, see the H5MD writer. For these, the last sample
+ * at or before a given step or time is read. read_next() reads them at the
+ * step of the next sample of the first other time series connected to the
+ * reader, and follows their own samples if there is none.
+ *
+ * For datasets of particle data, a data slot may be connected for reading
+ * a subset of particles given by a range or a list of indices. Then only
+ * the chunks of the dataset comprising the particles are read.
  */
 class append
 {
@@ -59,6 +76,8 @@ public:
     typedef clock_type::step_difference_type step_difference_type;
     typedef clock_type::time_difference_type time_difference_type;
     typedef signal_type::slot_function_type slot_function_type;
+    /** sorted, disjoint runs of rows given by first row and number of rows */
+    typedef std::vector<std::pair<hsize_t, hsize_t> > selection_type;
     /**
      * For the truncate reader/writer, a subgroup is defined as the dataset
      * which contains the data to be read or written.
@@ -84,6 +103,23 @@ public:
       , std::function<T ()> const& slot
       , std::vector<std::string> const& location
     );
+    /** connect data slot for reading rows of dataset with given indices */
+    template <typename T>
+    connection on_read_index(
+        subgroup_type& group
+      , std::function<T ()> const& slot
+      , std::vector<std::string> const& location
+      , std::vector<unsigned int> const& index
+    );
+    /** connect data slot for reading rows [first, last) of dataset */
+    template <typename T>
+    connection on_read_range(
+        subgroup_type& group
+      , std::function<T ()> const& slot
+      , std::vector<std::string> const& location
+      , unsigned int first
+      , unsigned int last
+    );
     /** connect slot called before reading */
     connection on_prepend_read(slot_function_type const& slot);
     /** connect slot called after reading */
@@ -92,6 +128,8 @@ public:
     void read_at_step(step_difference_type offset);
     /** read datasets at given time offset */
     void read_at_time(time_difference_type offset);
+    /** read datasets at sample following the last sample read */
+    void read_next();
     /** Lua bindings */
     static void luaopen(lua_State* L);
 
@@ -104,25 +142,41 @@ public:
     }
 
 private:
-    typedef std::function<hsize_t (H5::Group const& group)> index_function_type;
+    class series_index;
+    typedef std::function<hsize_t (series_index& index)> index_function_type;
 
+    template <typename T>
+    connection connect_dataset(
+        subgroup_type& group
+      , std::function<T ()> const& slot
+      , std::vector<std::string> const& location
+      , std::shared_ptr<selection_type const> rows
+    );
     template <typename T>
     static void read_dataset(
-        H5::Group const& group
+        std::shared_ptr<series_index> const& index
       , std::function<T ()> const& slot
-      , index_function_type const& index
+      , std::shared_ptr<selection_type const> const& rows
+      , index_function_type const& find
     );
     static hsize_t read_step_index(
         step_difference_type offset
-      , H5::Group const& group
+      , series_index& index
     );
     static hsize_t read_time_index(
         time_difference_type offset
-      , H5::Group const& group
+      , series_index& index
+    );
+    static hsize_t read_next_index(
+        bool driven
+      , step_type step
+      , series_index& index
     );
 
     /** reader group */
     H5::Group group_;
+    /** indices of time series groups of connected datasets */
+    std::vector<std::weak_ptr<series_index>> index_;
     /** signal emitted for reading datasets */
     signal<void (index_function_type const&)> on_read_;
     /** signal emitted before reading datasets */
@@ -19,6 +19,7 @@
  * <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <boost/algorithm/string/join.hpp> // boost::join
 #include <boost/type_traits/has_dereference.hpp>
 #include <luaponte/luaponte.hpp>
@@ -29,11 +30,15 @@
 #include <stdint.h> // uint32_t, uint64_t
 #include <type_traits>
 
+#include <halmd/io/logger.hpp>
 #include <halmd/io/utility/hdf5.hpp>
 #include <halmd/io/writers/h5md/append.hpp>
+#include <halmd/io/writers/h5md/io_thread.hpp>
 #include <halmd/numeric/blas/fixed_vector.hpp>
+#include <halmd/utility/deferred_array.hpp>
 #include <halmd/utility/lua/lua.hpp>
 #include <halmd/utility/raw_array.hpp>
+#include <halmd/utility/recycler.hpp>
 
 using boost::multi_array;
 using namespace std;
@@ -43,95 +48,216 @@ namespace io {
 namespace writers {
 namespace h5md {
 
+/**
+ * Dataset of a data slot, which is created upon the first write.
+ *
+ * The writer is shared between the simulation thread and the I/O thread,
+ * as copies of HDF5 objects must not be made outside of the I/O thread.
+ */
+struct append::dataset_writer
+{
+    dataset_writer(
+        H5::Group const& group
+      , string const& name
+      , unsigned int batch
+      , std::shared_ptr<dataset_layout const> layout
+    )
+      : group(group), name(name), batch(batch), layout(layout) {}
+
+    template <typename T>
+    void operator()(T const& data)
+    {
+        if (!dataset) {
+            dataset = chunked_dataset::create(group, name, data, batch, *layout);
+        }
+        dataset->append(data);
+    }
+
+    H5::Group group;
+    string name;
+    unsigned int batch;
+    std::shared_ptr<dataset_layout const> layout;
+    std::shared_ptr<chunked_dataset> dataset;
+};
+
 append::append(
     H5::Group const& root
   , vector<string> const& location
   , std::shared_ptr<clock_type const> clock
+  , unsigned int queue_depth
+  , unsigned int batch
 )
   : clock_(clock)
   , last_step_(numeric_limits<int64_t>::lowest())
   , last_time_(numeric_limits<time_type>::lowest())
+  , queue_depth_(queue_depth)
+  , batch_(batch)
 {
     if (location.size() < 1) {
         throw invalid_argument("group location");
     }
+    if (batch_ < 1) {
+        throw invalid_argument("number of samples per batch must be non-zero");
+    }
+    if (queue_depth_ > 0 && !io_thread::threadsafe()) {
+        throw invalid_argument("asynchronous writing requires thread-safe HDF5 library");
+    }
+    auto lock = io_thread::lock();
     group_ = h5xx::open_group(root, boost::join(location, "/"));
-    step_dataset_ = h5xx::create_chunked_dataset<step_type>(group_, "step");
-    time_dataset_ = h5xx::create_chunked_dataset<time_type>(group_, "time");
+    step_dataset_ = chunked_dataset::create(group_, "step", step_type(), batch_, dataset_layout());
+    time_dataset_ = chunked_dataset::create(group_, "time", time_type(), batch_, dataset_layout());
     group_.unlink("step");
     group_.unlink("time");
 }
 
-template <typename T>
-static H5::DataSet create_dataset(
-    H5::Group const& group
-  , string const& name
-  , T const&
-)
+append::~append()
 {
-    return h5xx::create_chunked_dataset<T>(group, name);
+    try {
+        drain();
+    }
+    catch (std::exception const& e) {
+        LOG_ERROR("writing to H5MD file failed: " << e.what());
+    }
+    // release HDF5 objects while tasks of other writers may be executed
+    auto lock = io_thread::lock();
+    on_write_.disconnect_all_slots();
+    datasets_.clear();
+    step_dataset_.reset();
+    time_dataset_.reset();
+    group_ = H5::Group();
 }
 
-template <typename T, typename Alloc>
-static H5::DataSet create_dataset(
-    H5::Group const& group
-  , string const& name
-  , vector<T, Alloc> const& data
-)
+/**
+ * Type of the data written for a slot returning T.
+ */
+template <typename T, typename Enable = void>
+struct data_type
+{
+    typedef typename std::decay<T>::type type;
+};
+
+template <typename T>
+struct data_type<T, typename std::enable_if<boost::has_dereference<T>::type::value>::type>
+{
+    typedef typename std::decay<decltype(*std::declval<T>())>::type type;
+};
+
+/**
+ * Copy data to staging buffer.
+ */
+template <typename T>
+static std::shared_ptr<T const> copy_data(T const& data, recycler<T>&)
 {
-    return h5xx::create_chunked_dataset<vector<T, Alloc> >(group, name, data.size());
+    return std::make_shared<T>(data);
 }
 
+/**
+ * Copy particle data to recycled staging buffer, which avoids the
+ * allocation of large arrays for each sample.
+ */
 template <typename T>
-static H5::DataSet create_dataset(
-    H5::Group const& group
-  , string const& name
-  , raw_array<T> const& data
-)
+static std::shared_ptr<raw_array<T> const> copy_data(raw_array<T> const& data, recycler<raw_array<T> >& pool)
 {
-    return h5xx::create_chunked_dataset<raw_array<T> >(group, name, data.size());
+    std::shared_ptr<raw_array<T> > buffer = pool.get(
+        [&](raw_array<T> const& buffer) { return buffer.size() == data.size(); }
+      , [&]() { return new raw_array<T>(data.size()); }
+    );
+    std::copy(data.begin(), data.end(), buffer->begin());
+    return buffer;
 }
 
-template <typename T, size_t N, typename Alloc>
-static H5::DataSet create_dataset(
-    H5::Group const& group
-  , string const& name
-  , multi_array<T, N, Alloc> const& data
-)
+/**
+ * Stage data of slot that returns a pointer, which is held until the data
+ * has been written.
+ */
+template <typename T, typename U>
+static typename std::enable_if<boost::has_dereference<T>::type::value, std::shared_ptr<U const> >::type
+stage_data(std::function<T ()> const& slot, bool, recycler<U>&)
 {
-    return h5xx::create_chunked_dataset<multi_array<T, N, Alloc> >(group, name, data.shape());
+    return slot();
 }
 
-template <typename T>
-static typename std::enable_if<boost::has_dereference<T>::type::value, void>::type
-write_dataset(
-    H5::DataSet& dataset
-  , H5::Group const& group
-  , string const& name
-  , std::function<T ()> const& slot
-)
+/**
+ * Stage data of slot that returns by copy.
+ */
+template <typename T, typename U>
+static typename std::enable_if<!boost::has_dereference<T>::type::value && !std::is_reference<T>::value, std::shared_ptr<U const> >::type
+stage_data(std::function<T ()> const& slot, bool, recycler<U>&)
+{
+    return std::make_shared<U>(slot());
+}
+
+/**
+ * Stage data of slot that returns by reference, which is copied for
+ * asynchronous writing, since it may change before it is written.
+ */
+template <typename T, typename U>
+static typename std::enable_if<!boost::has_dereference<T>::type::value && std::is_reference<T>::value, std::shared_ptr<U const> >::type
+stage_data(std::function<T ()> const& slot, bool async, recycler<U>& pool)
 {
-    auto const& data = *slot();
-    if (!h5xx::is_valid(dataset.getId())) {
-        dataset = create_dataset(group, name, data);
+    U const& data = slot();
+    if (async) {
+        return copy_data(data, pool);
     }
-    h5xx::write_chunked_dataset(dataset, data);
+    // synchronous writing completes before the data may change
+    return std::shared_ptr<U const>(&data, [](U const*) {});
 }
 
-template <typename T>
-static typename std::enable_if<!boost::has_dereference<T>::type::value, void>::type
-write_dataset(
-    H5::DataSet& dataset
-  , H5::Group const& group
-  , string const& name
+/**
+ * Returns slot for staging the data of a dataset, which appends the
+ * deferred write to the given tasks.
+ */
+template <typename T, typename Writer>
+static std::function<void (vector<append::task_type>&)> stage_dataset(
+    std::shared_ptr<Writer> writer
   , std::function<T ()> const& slot
+  , bool async
 )
 {
-    T data = slot();
-    if (!h5xx::is_valid(dataset.getId())) {
-        dataset = create_dataset(group, name, data);
-    }
-    h5xx::write_chunked_dataset(dataset, data);
+    typedef typename data_type<T>::type value_type;
+    auto pool = std::make_shared<recycler<value_type> >();
+    return [=](vector<append::task_type>& tasks) {
+        std::shared_ptr<value_type const> data = stage_data(slot, async, *pool);
+        tasks.push_back([=]() {
+            (*writer)(*data);
+        });
+    };
+}
+
+/**
+ * Returns slot for staging the data of a dataset produced on demand.
+ *
+ * For synchronous writing, the data are produced directly in the buffer of
+ * the dataset. For asynchronous writing, they are produced in a recycled
+ * staging buffer, as the producer may change before the data is written.
+ */
+template <typename T, typename Writer>
+static std::function<void (vector<append::task_type>&)> stage_dataset(
+    std::shared_ptr<Writer> writer
+  , std::function<deferred_array<T> ()> const& slot
+  , bool async
+)
+{
+    auto pool = std::make_shared<recycler<raw_array<T> > >();
+    return [=](vector<append::task_type>& tasks) {
+        deferred_array<T> data = slot();
+        if (async) {
+            std::shared_ptr<raw_array<T> > buffer = pool->get(
+                [&](raw_array<T> const& buffer) { return buffer.size() == data.size(); }
+              , [&]() { return new raw_array<T>(data.size()); }
+            );
+            data.fill(buffer->begin());
+            std::shared_ptr<raw_array<T> const> staged = buffer;
+            tasks.push_back([=]() {
+                (*writer)(*staged);
+            });
+        }
+        else {
+            tasks.push_back([=]() {
+                (*writer)(data);
+            });
+        }
+    };
 }
 
 template <typename T>
@@ -144,10 +270,12 @@ connection append::on_write(
     if (location.size() < 1) {
         throw invalid_argument("dataset location");
     }
+    auto lock = io_thread::lock();
     group = h5xx::open_group(group_, boost::join(location, "/"));
-    h5xx::link(step_dataset_, group, "step");
-    h5xx::link(time_dataset_, group, "time");
-    return on_write_.connect(bind(&write_dataset<T>, H5::DataSet(), group, "value", slot));
+    h5xx::link(step_dataset_->dataset(), group, "step");
+    h5xx::link(time_dataset_->dataset(), group, "time");
+    auto writer = make_dataset_writer(group, "value", location, batch_);
+    return on_write_.connect(stage_dataset(writer, slot, queue_depth_ > 0));
 }
 
 template <typename T>
@@ -162,18 +290,148 @@ connection append::on_write_averaged(
     if (location.size() < 1) {
         throw invalid_argument("dataset location");
     }
+    auto lock = io_thread::lock();
+    group = h5xx::open_group(group_, boost::join(location, "/"));
+    h5xx::link(step_dataset_->dataset(), group, "step");
+    h5xx::link(time_dataset_->dataset(), group, "time");
+
+    auto stage_value = stage_dataset(make_dataset_writer(group, "value", location, batch_), value_slot, queue_depth_ > 0);
+    auto stage_error = stage_dataset(make_dataset_writer(group, "error", location, batch_), error_slot, queue_depth_ > 0);
+    auto stage_count = stage_dataset(make_dataset_writer(group, "count", location, batch_), count_slot, queue_depth_ > 0);
+    return on_write_.connect( [=](vector<task_type>& tasks) {
+        stage_value(tasks);
+        stage_error(tasks);
+        stage_count(tasks);
+    });
+}
+
+template <typename T>
+connection append::on_write_changes(
+    subgroup_type& group
+  , std::function<T ()> const& slot
+  , std::function<bool ()> const& changed
+  , vector<string> const& location
+)
+{
+    if (location.size() < 1) {
+        throw invalid_argument("dataset location");
+    }
+    auto lock = io_thread::lock();
     group = h5xx::open_group(group_, boost::join(location, "/"));
-    h5xx::link(step_dataset_, group, "step");
-    h5xx::link(time_dataset_, group, "time");
-
-    H5::DataSet value_dataset, error_dataset, count_dataset;
-    return on_write_.connect( [=]() mutable {
-        write_dataset(value_dataset, group, "value", value_slot);
-        write_dataset(error_dataset, group, "error", error_slot);
-        write_dataset(count_dataset, group, "count", count_slot);
+    h5xx::write_attribute(group, "piecewise_constant", true);
+
+    // as few samples are expected, each sample is written as a chunk, and
+    // the group holds its own step and time datasets
+    auto step_layout = std::make_shared<dataset_layout const>();
+    auto step_writer = std::make_shared<dataset_writer>(group, "step", 1, step_layout);
+    auto time_writer = std::make_shared<dataset_writer>(group, "time", 1, step_layout);
+    datasets_.push_back(step_writer);
+    datasets_.push_back(time_writer);
+
+    auto stage_value = stage_dataset(make_dataset_writer(group, "value", location, 1), slot, queue_depth_ > 0);
+    auto written = std::make_shared<bool>(false);
+    std::shared_ptr<clock_type const> clock = clock_;
+    return on_write_.connect([=](vector<task_type>& tasks) {
+        // query changes also for the first sample to reset the observer
+        if (!changed() && *written) {
+            return;
+        }
+        step_type step = clock->step();
+        time_type time = clock->time();
+        tasks.push_back([=]() {
+            (*step_writer)(step);
+            (*time_writer)(time);
+        });
+        stage_value(tasks);
+        *written = true;
     });
 }
 
+std::shared_ptr<append::dataset_writer> append::make_dataset_writer(
+    H5::Group const& group
+  , string const& name
+  , vector<string> const& location
+  , unsigned int batch
+)
+{
+    datasets_.push_back(std::make_shared<dataset_writer>(group, name, batch, find_layout(location)));
+    return datasets_.back();
+}
+
+std::shared_ptr<dataset_layout> const& append::find_layout(vector<string> const& location)
+{
+    std::shared_ptr<dataset_layout>& layout = layout_[boost::join(location, "/")];
+    if (!layout) {
+        // a new layout is initialised from the default layout, if any
+        auto default_layout = layout_.find(string());
+        if (default_layout != layout_.end() && default_layout->second) {
+            layout = std::make_shared<dataset_layout>(*default_layout->second);
+        }
+        else {
+            layout = std::make_shared<dataset_layout>();
+        }
+    }
+    return layout;
+}
+
+dataset_layout& append::mutable_layout(vector<string> const& location)
+{
+    std::shared_ptr<dataset_layout> const& layout = find_layout(location);
+    for (auto const& writer : datasets_) {
+        if (writer->layout == layout && writer->dataset) {
+            throw logic_error("layout of dataset must be set before writing");
+        }
+    }
+    return *layout;
+}
+
+void append::layout(
+    vector<string> const& location
+  , vector<unsigned int> const& chunk
+  , std::size_t cache_size
+)
+{
+    // the layout is read by the I/O thread upon creation of a dataset
+    auto lock = io_thread::lock();
+    dataset_layout& layout = mutable_layout(location);
+    layout.chunk.assign(chunk.begin(), chunk.end());
+    layout.cache_size = cache_size;
+}
+
+void append::compression(
+    vector<string> const& location
+  , bool shuffle
+  , unsigned int deflate
+  , unsigned int zstd
+)
+{
+    if (deflate > 9) {
+        throw invalid_argument("deflate compression level must be at most 9");
+    }
+    if (zstd > 22) {
+        throw invalid_argument("Zstandard compression level must be at most 22");
+    }
+    auto lock = io_thread::lock();
+    dataset_layout& layout = mutable_layout(location);
+    layout.shuffle = shuffle;
+    layout.deflate = deflate;
+    layout.zstd = zstd;
+}
+
+void append::quantise(
+    vector<string> const& location
+  , vector<double> const& scale
+)
+{
+    for (double step : scale) {
+        if (!(step > 0)) {
+            throw invalid_argument("quantisation step must be positive");
+        }
+    }
+    auto lock = io_thread::lock();
+    mutable_layout(location).scale = scale;
+}
+
 connection append::on_prepend_write(slot_function_type const& slot)
 {
     return on_prepend_write_.connect(slot);
@@ -187,12 +445,37 @@ connection append::on_append_write(slot_function_type const& slot)
 void append::write()
 {
     on_prepend_write_();
-    write_step_time();
-    on_write_();
+    vector<task_type> tasks;
+    tasks.push_back(stage_step_time());
+    on_write_(tasks);
+    commit(std::move(tasks));
     on_append_write_();
 }
 
-void append::write_step_time()
+void append::drain()
+{
+    // write buffered samples of incomplete batches
+    auto datasets = datasets_;
+    std::shared_ptr<chunked_dataset> step_dataset = step_dataset_;
+    std::shared_ptr<chunked_dataset> time_dataset = time_dataset_;
+    commit({[=]() {
+        step_dataset->flush();
+        time_dataset->flush();
+        for (auto const& writer : datasets) {
+            if (writer->dataset) {
+                writer->dataset->flush();
+            }
+        }
+    }});
+
+    while (!pending_.empty()) {
+        std::future<void> future = std::move(pending_.front());
+        pending_.pop_front();
+        future.get(); // rethrow exception of I/O thread
+    }
+}
+
+append::task_type append::stage_step_time()
 {
     step_type step = clock_->step();
     time_type time = clock_->time();
@@ -200,11 +483,47 @@ void append::write_step_time()
         throw std::logic_error("Writing to H5MD file failed at step " + boost::lexical_cast<std::string>(step) +
                                "\nH5MD enforces a strictly increasing order.");
     }
-
-    h5xx::write_chunked_dataset(step_dataset_, step);
-    h5xx::write_chunked_dataset(time_dataset_, time);
     last_step_ = step;
     last_time_ = time;
+
+    // the writer outlives its pending tasks, see drain()
+    return [=]() {
+        step_dataset_->append(step);
+        time_dataset_->append(time);
+    };
+}
+
+void append::commit(vector<task_type> tasks)
+{
+    if (queue_depth_ == 0) {
+        auto lock = io_thread::lock();
+        for (task_type const& task : tasks) {
+            task();
+        }
+        return;
+    }
+
+    // block while the queue is full
+    while (pending_.size() >= queue_depth_) {
+        std::future<void> future = std::move(pending_.front());
+        pending_.pop_front();
+        future.get(); // rethrow exception of I/O thread
+    }
+
+    // release staged data and HDF5 objects within the I/O thread
+    auto staged = std::make_shared<vector<task_type> >(std::move(tasks));
+    pending_.push_back(io_thread::get().push([=]() {
+        try {
+            for (task_type const& task : *staged) {
+                task();
+            }
+        }
+        catch (...) {
+            staged->clear();
+            throw;
+        }
+        staged->clear();
+    }));
 }
 
 static append::slot_function_type
@@ -215,6 +534,14 @@ wrap_write(std::shared_ptr<append> self)
     };
 }
 
+static append::slot_function_type
+wrap_drain(std::shared_ptr<append> self)
+{
+    return [=]() {
+        self->drain();
+    };
+}
+
 /**
  * As write slots we support functors with return by copy, return by const
  * reference and return by non-const reference. Non-const references are
@@ -236,8 +563,11 @@ void append::luaopen(lua_State* L)
                 [
                     class_<append, std::shared_ptr<append> >("append")
                         .def(constructor<H5::Group const&, vector<string> const&, std::shared_ptr<clock_type const> >())
+                        .def(constructor<H5::Group const&, vector<string> const&, std::shared_ptr<clock_type const>, unsigned int>())
+                        .def(constructor<H5::Group const&, vector<string> const&, std::shared_ptr<clock_type const>, unsigned int, unsigned int>())
                         .property("group", &append::group)
                         .property("write", &wrap_write)
+                        .property("drain", &wrap_drain)
                         .def("on_write", &append::on_write<float>, pure_out_value(_2))
                         .def("on_write", &append::on_write<float&>, pure_out_value(_2))
                         .def("on_write", &append::on_write<float const&>, pure_out_value(_2))
@@ -316,12 +646,22 @@ void append::luaopen(lua_State* L)
                         .def("on_write", &append::on_write<std::shared_ptr<raw_array<fixed_vector<double, 2>> const>>, pure_out_value(_2))
                         .def("on_write", &append::on_write<std::shared_ptr<raw_array<fixed_vector<double, 3>> const>>, pure_out_value(_2))
 
+                        // phase_space: position, velocity produced on demand
+                        .def("on_write", &append::on_write<deferred_array<fixed_vector<float, 2>>>, pure_out_value(_2))
+                        .def("on_write", &append::on_write<deferred_array<fixed_vector<float, 3>>>, pure_out_value(_2))
+                        .def("on_write", &append::on_write<deferred_array<fixed_vector<double, 2>>>, pure_out_value(_2))
+                        .def("on_write", &append::on_write<deferred_array<fixed_vector<double, 3>>>, pure_out_value(_2))
+
                         .def("on_write", &append::on_write<raw_array<float>&>, pure_out_value(_2))
                         .def("on_write", &append::on_write<raw_array<float> const&>, pure_out_value(_2))
                         .def("on_write", &append::on_write<raw_array<double>&>, pure_out_value(_2))
                         .def("on_write", &append::on_write<raw_array<double> const&>, pure_out_value(_2))
                         .def("on_write", &append::on_write<raw_array<unsigned int>&>, pure_out_value(_2))
                         .def("on_write", &append::on_write<raw_array<unsigned int> const&>, pure_out_value(_2))
+                        // phase_space: species, mass written upon changes
+                        .def("on_write_changes", &append::on_write_changes<raw_array<float> const&>, pure_out_value(_2))
+                        .def("on_write_changes", &append::on_write_changes<raw_array<double> const&>, pure_out_value(_2))
+                        .def("on_write_changes", &append::on_write_changes<raw_array<unsigned int> const&>, pure_out_value(_2))
 
                         // ssf FIXME support output of accumulators as dataset triple (value, error, count)
                         .def("on_write", &append::on_write<raw_array<boost::array<double, 3> > const&>, pure_out_value(_2))
@@ -376,6 +716,9 @@ void append::luaopen(lua_State* L)
                         .def("on_write", &append::on_write_averaged<fixed_vector<double, 3>>, pure_out_value(_2))
                         .def("on_write", &append::on_write_averaged<fixed_vector<double, 6>>, pure_out_value(_2))
 
+                        .def("layout", &append::layout)
+                        .def("compression", &append::compression)
+                        .def("quantise", &append::quantise)
                         .def("on_prepend_write", &append::on_prepend_write)
                         .def("on_append_write", &append::on_append_write)
                 ]
@@ -23,10 +23,15 @@
 #define HALMD_IO_WRITERS_H5MD_APPEND_HPP
 
 #include <boost/multi_array.hpp>
+#include <deque>
 #include <functional>
+#include <future>
 #include <lua.hpp>
+#include <map>
+#include <vector>
 
 #include <h5xx/h5xx.hpp>
+#include <halmd/io/writers/h5md/chunked_dataset.hpp>
 #include <halmd/mdsim/clock.hpp>
 #include <halmd/utility/signal.hpp>
 
@@ -49,12 +54,41 @@ namespace h5md {
  * the sampler to write to the datasets at a fixed interval. Further
  * signals on_prepend_write and on_append_write are provided to call
  * arbitrary slots before and after writing.
+ *
+ * For a non-zero queue depth, the writer operates asynchronously: the data
+ * slots are called by write(), and their data are copied to staging buffers,
+ * which are committed to the file by the background I/O thread. At most
+ * queue_depth samples may be pending, further calls of write() block until
+ * the oldest sample has been committed. Asynchronous writing requires an
+ * HDF5 library built with thread-safety.
+ *
+ * Samples are buffered and appended to the datasets in batches of a fixed
+ * number of samples. By default, each chunk of a dataset holds one batch,
+ * which is then written directly as a chunk. The chunk shape and the size
+ * of the chunk cache may be chosen per dataset with layout().
+ *
+ * Datasets may be compressed by shuffle, deflate and Zstandard filters,
+ * which are chosen per dataset or for all datasets with compression(). The
+ * layout of a single dataset is initialised from the layout for all
+ * datasets, i.e., of the empty location, upon the first setting of the
+ * dataset or the connection of the dataset, whichever comes first. For
+ * asynchronous writers, chunks are compressed by the I/O thread. Further,
+ * floating-point datasets may be stored lossily as delta-encoded integers,
+ * see quantise().
+ *
+ * Datasets that rarely change, e.g., the species of particles, may be
+ * connected with on_write_changes(). Such a dataset group holds its own step
+ * and time datasets, and a sample is appended only if the data has changed
+ * since the last sample. The group is marked with the attribute
+ * piecewise_constant, and a sample holds until the step of the next sample.
  */
 class append
 {
 private:
     typedef signal<void ()> signal_type;
 public:
+    /** deferred write of a staged sample to a dataset */
+    typedef std::function<void ()> task_type;
     typedef mdsim::clock clock_type;
     typedef clock_type::step_type step_type;
     typedef clock_type::time_type time_type;
@@ -71,12 +105,21 @@ public:
      */
     typedef H5::Group subgroup_type;
 
-    /** open writer group and create time and step datasets */
+    /**
+     * open writer group and create time and step datasets
+     *
+     * @param queue_depth  maximum number of pending samples, or 0 for synchronous writing
+     * @param batch        number of samples per batch
+     */
     append(
         H5::Group const& root
       , std::vector<std::string> const& location
       , std::shared_ptr<clock_type const> clock
+      , unsigned int queue_depth = 0
+      , unsigned int batch = 1
     );
+    /** commit pending samples */
+    ~append();
     /** connect data slot for writing dataset, return created HDF5 group by reference */
     template <typename T>
     connection on_write(
@@ -93,12 +136,76 @@ public:
       , std::function<uint64_t ()> const& count_slot
       , std::vector<std::string> const& location
     );
+    /**
+     * connect data slot for writing dataset only upon changes, return created
+     * HDF5 group by reference
+     *
+     * @param changed  returns true if the data has changed since the last call
+     *
+     * The first sample is always written.
+     */
+    template <typename T>
+    connection on_write_changes(
+        subgroup_type& group
+      , std::function<T ()> const& slot
+      , std::function<bool ()> const& changed
+      , std::vector<std::string> const& location
+    );
     /** connect slot called before writing */
     connection on_prepend_write(slot_function_type const& slot);
     /** connect slot called after writing */
     connection on_append_write(slot_function_type const& slot);
     /** append datasets */
     void write();
+    /** write buffered samples and wait until all pending samples are committed */
+    void drain();
+    /**
+     * set storage layout of datasets at given location
+     *
+     * @param location    location of dataset group as passed to on_write()
+     * @param chunk       shape of chunks, starting with the number of samples per chunk
+     * @param cache_size  size of chunk cache in bytes, or 0 for the HDF5 default
+     *
+     * The layout must be set before the first sample is written.
+     */
+    void layout(
+        std::vector<std::string> const& location
+      , std::vector<unsigned int> const& chunk
+      , std::size_t cache_size
+    );
+    /**
+     * set compression filters of datasets at given location
+     *
+     * @param location    location of dataset group as passed to on_write(),
+     *                    or empty for all datasets connected subsequently
+     * @param shuffle     byte-shuffle scalars before compression
+     * @param deflate     level of deflate compression (1–9), or 0 to disable
+     * @param zstd        level of Zstandard compression (1–22), or 0 to disable
+     *
+     * The filters must be set before the first sample is written.
+     */
+    void compression(
+        std::vector<std::string> const& location
+      , bool shuffle
+      , unsigned int deflate
+      , unsigned int zstd
+    );
+    /**
+     * store floating-point datasets at given location as quantised integers
+     *
+     * @param location    location of dataset group as passed to on_write()
+     * @param scale       quantisation step per component of the innermost
+     *                    dimension, or a single step for all components
+     *
+     * The values are rounded to multiples of the quantisation step and
+     * delta-encoded against the previous sample within each chunk, which
+     * is decoded transparently by the H5MD reader. The quantisation must be
+     * set before the first sample is written.
+     */
+    void quantise(
+        std::vector<std::string> const& location
+      , std::vector<double> const& scale
+    );
     /** Lua bindings */
     static void luaopen(lua_State* L);
 
@@ -111,13 +218,36 @@ public:
     }
 
 private:
-    /** append shared step and time datasets */
-    void write_step_time();
+    typedef signal<void (std::vector<task_type>&)> stage_signal_type;
+    struct dataset_writer;
+
+    /** create writer of dataset within given group */
+    std::shared_ptr<dataset_writer> make_dataset_writer(
+        H5::Group const& group
+      , std::string const& name
+      , std::vector<std::string> const& location
+      , unsigned int batch
+    );
+
+    /**
+     * returns storage layout of datasets at location
+     *
+     * A layout that does not exist yet is created as a copy of the default
+     * layout of the empty location.
+     */
+    std::shared_ptr<dataset_layout> const& find_layout(std::vector<std::string> const& location);
+    /** returns storage layout of datasets at location, which are not yet written */
+    dataset_layout& mutable_layout(std::vector<std::string> const& location);
+
+    /** stage shared step and time datasets */
+    task_type stage_step_time();
+    /** commit staged sample synchronously or enqueue it for the I/O thread */
+    void commit(std::vector<task_type> tasks);
 
     /** writer group */
     H5::Group group_;
-    /** signal emitted for writing datasets */
-    signal_type on_write_;
+    /** signal emitted for staging datasets */
+    stage_signal_type on_write_;
     /** signal emitted before writing datasets */
     signal_type on_prepend_write_;
     /** signal emitted before after datasets */
@@ -125,13 +255,23 @@ private:
     /** simulation step and time */
     std::shared_ptr<clock_type const> clock_;
     /** shared step dataset */
-    H5::DataSet step_dataset_;
+    std::shared_ptr<chunked_dataset> step_dataset_;
     /** shared time dataset */
-    H5::DataSet time_dataset_;
+    std::shared_ptr<chunked_dataset> time_dataset_;
+    /** writers of datasets */
+    std::vector<std::shared_ptr<dataset_writer>> datasets_;
+    /** storage layout of datasets by location, the empty location holds the default */
+    std::map<std::string, std::shared_ptr<dataset_layout>> layout_;
     /** last simulation step written */
     int64_t last_step_;
     /** last simulation time written */
     time_type last_time_;
+    /** maximum number of pending samples */
+    unsigned int queue_depth_;
+    /** number of samples per batch */
+    unsigned int batch_;
+    /** completion of pending samples */
+    std::deque<std::future<void>> pending_;
 };
 
 } // namespace h5md
@@ -0,0 +1,239 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <halmd/io/logger.hpp>
+#include <halmd/io/writers/h5md/chunked_dataset.hpp>
+
+using namespace std;
+
+namespace halmd {
+namespace io {
+namespace writers {
+namespace h5md {
+
+/** registered identifier of the Zstandard filter plugin */
+static H5Z_filter_t const H5Z_FILTER_ZSTD = 32015;
+
+/**
+ * Append filters of layout to the pipeline of a dataset.
+ */
+static void set_filters(H5::DSetCreatPropList& dcpl, dataset_layout const& layout)
+{
+    if (layout.shuffle) {
+        dcpl.setShuffle();
+    }
+    if (layout.deflate > 0) {
+        if (H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0) {
+            throw runtime_error("HDF5 library lacks deflate filter");
+        }
+        dcpl.setDeflate(layout.deflate);
+    }
+    if (layout.zstd > 0) {
+        // the filter plugin is searched in HDF5_PLUGIN_PATH
+        if (H5Zfilter_avail(H5Z_FILTER_ZSTD) <= 0) {
+            throw runtime_error("Zstandard filter plugin for HDF5 is not available");
+        }
+        unsigned int level = layout.zstd;
+        dcpl.setFilter(H5Z_FILTER_ZSTD, H5Z_FLAG_MANDATORY, 1, &level);
+    }
+}
+
+chunked_dataset::chunked_dataset(
+    H5::Group const& group
+  , string const& name
+  , H5::PredType const& type
+  , vector<hsize_t> const& shape
+  , unsigned int batch
+  , dataset_layout const& layout
+)
+  : type_(type)
+  , sample_size_(1)
+  , batch_(max(batch, 1u))
+  , size_(0)
+  , count_(0)
+  , scale_(layout.scale)
+{
+    unsigned int rank = shape.size() + 1;
+
+    // time series of samples with unlimited extent
+    dims_.assign(1, 0);
+    dims_.insert(dims_.end(), shape.begin(), shape.end());
+    vector<hsize_t> max_dims = dims_;
+    max_dims[0] = H5S_UNLIMITED;
+    for (hsize_t extent : shape) {
+        sample_size_ *= extent;
+    }
+
+    // chunk shape defaults to the batch of samples
+    chunk_.resize(rank);
+    direct_ = true;
+    for (unsigned int i = 0; i < rank; ++i) {
+        hsize_t extent = i < layout.chunk.size() ? layout.chunk[i] : 0;
+        if (i == 0) {
+            chunk_[i] = extent > 0 ? extent : batch_;
+        }
+        else {
+            chunk_[i] = max<hsize_t>(extent > 0 ? min(extent, dims_[i]) : dims_[i], 1);
+            direct_ = direct_ && chunk_[i] == dims_[i];
+        }
+    }
+    // compressed chunks are written through the filter pipeline
+    direct_ = direct_ && chunk_[0] == batch_ && !layout.filtered();
+
+    H5::DataSpace space(rank, &dims_[0], &max_dims[0]);
+    H5::DSetCreatPropList dcpl;
+    dcpl.setChunk(rank, &chunk_[0]);
+    set_filters(dcpl, layout);
+
+    hid_t dapl = H5Pcreate(H5P_DATASET_ACCESS);
+    if (layout.cache_size > 0) {
+        H5Pset_chunk_cache(dapl, H5D_CHUNK_CACHE_NSLOTS_DEFAULT, layout.cache_size, H5D_CHUNK_CACHE_W0_DEFAULT);
+    }
+    hid_t id = H5Dcreate2(group.getId(), name.c_str(), type_.getId(), space.getId(), H5P_DEFAULT, dcpl.getId(), dapl);
+    H5Pclose(dapl);
+    if (id < 0) {
+        throw runtime_error("failed to create HDF5 dataset: " + name);
+    }
+    dataset_ = H5::DataSet(id); // increments reference count
+    H5Dclose(id);
+
+    buffer_.resize(batch_ * sample_size_ * type_.getSize());
+
+    if (!scale_.empty()) {
+        if (shape.empty() || (scale_.size() != 1 && scale_.size() != shape.back())) {
+            throw invalid_argument("number of quantisation steps must match innermost extent of sample");
+        }
+        for (double step : scale_) {
+            if (!(step > 0)) {
+                throw invalid_argument("quantisation step must be positive");
+            }
+        }
+        quantised_.resize(sample_size_);
+        previous_.resize(sample_size_);
+
+        hsize_t ncomp = scale_.size();
+        H5::Attribute scale_factor = dataset_.createAttribute(
+            "scale_factor", H5::PredType::NATIVE_DOUBLE, H5::DataSpace(1, &ncomp)
+        );
+        scale_factor.write(H5::PredType::NATIVE_DOUBLE, &scale_[0]);
+        H5::Attribute delta_interval = dataset_.createAttribute(
+            "delta_interval", H5::PredType::NATIVE_UINT64, H5::DataSpace(H5S_SCALAR)
+        );
+        uint64_t interval = chunk_[0];
+        delta_interval.write(H5::PredType::NATIVE_UINT64, &interval);
+    }
+}
+
+chunked_dataset::~chunked_dataset()
+{
+    try {
+        flush();
+    }
+    catch (std::exception const& e) {
+        LOG_ERROR("failed to write HDF5 dataset: " << e.what());
+    }
+}
+
+void chunked_dataset::append(void const* data, size_t size)
+{
+    void* output = reserve(size);
+    size_t bytes = sample_size_ * type_.getSize();
+    if (bytes > 0) {
+        memcpy(output, data, bytes);
+    }
+    commit();
+}
+
+void* chunked_dataset::reserve(size_t size)
+{
+    if (size != sample_size_) {
+        throw logic_error("sample size does not match HDF5 dataset");
+    }
+    return buffer_.data() + count_ * sample_size_ * type_.getSize();
+}
+
+void chunked_dataset::commit()
+{
+    if (++count_ == batch_) {
+        flush();
+    }
+}
+
+void chunked_dataset::append_quantised()
+{
+    // the first sample of a chunk is stored as is
+    bool key = (size_ + count_) % chunk_[0] == 0;
+    int32_t* output = reinterpret_cast<int32_t*>(buffer_.data()) + count_ * sample_size_;
+    for (size_t i = 0; i < sample_size_; ++i) {
+        int64_t value = key ? quantised_[i] : quantised_[i] - previous_[i];
+        if (value < numeric_limits<int32_t>::min() || value > numeric_limits<int32_t>::max()) {
+            throw range_error("quantised sample exceeds range of 32-bit integers");
+        }
+        output[i] = value;
+    }
+    swap(previous_, quantised_);
+    commit();
+}
+
+void chunked_dataset::flush()
+{
+    if (count_ == 0) {
+        return;
+    }
+    hsize_t offset = size_;
+    dims_[0] = size_ + count_;
+    dataset_.extend(&dims_[0]);
+
+    // write complete, aligned batch as a single chunk
+    bool direct = direct_ && count_ == chunk_[0] && offset % chunk_[0] == 0;
+#if H5_VERSION_GE(1, 10, 2)
+    if (direct) {
+        vector<hsize_t> start(dims_.size(), 0);
+        start[0] = offset;
+        if (H5Dwrite_chunk(dataset_.getId(), H5P_DEFAULT, 0, &start[0], count_ * sample_size_ * type_.getSize(), buffer_.data()) < 0) {
+            throw runtime_error("failed to write chunk of HDF5 dataset");
+        }
+    }
+#else
+    direct = false;
+#endif
+    if (!direct) {
+        vector<hsize_t> start(dims_.size(), 0);
+        vector<hsize_t> count = dims_;
+        start[0] = offset;
+        count[0] = count_;
+        H5::DataSpace file_space = dataset_.getSpace();
+        file_space.selectHyperslab(H5S_SELECT_SET, &count[0], &start[0]);
+        H5::DataSpace mem_space(count.size(), &count[0]);
+        dataset_.write(buffer_.data(), type_, mem_space, file_space);
+    }
+    size_ += count_;
+    count_ = 0;
+}
+
+} // namespace h5md
+} // namespace writers
+} // namespace io
+} // namespace halmd
@@ -0,0 +1,435 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_IO_WRITERS_H5MD_CHUNKED_DATASET_HPP
+#define HALMD_IO_WRITERS_H5MD_CHUNKED_DATASET_HPP
+
+#include <boost/array.hpp>
+#include <boost/multi_array.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <h5xx/h5xx.hpp>
+#include <halmd/numeric/blas/fixed_vector.hpp>
+#include <halmd/utility/deferred_array.hpp>
+#include <halmd/utility/raw_array.hpp>
+
+namespace halmd {
+namespace io {
+namespace writers {
+namespace h5md {
+
+/**
+ * Storage layout of a time series dataset
+ */
+struct dataset_layout
+{
+    dataset_layout() : cache_size(0), shuffle(false), deflate(0), zstd(0) {}
+
+    /** returns true if samples are stored as quantised integers */
+    bool quantised() const
+    {
+        return !scale.empty();
+    }
+
+    /** returns true if chunks are compressed */
+    bool filtered() const
+    {
+        return shuffle || deflate > 0 || zstd > 0;
+    }
+
+    /**
+     * Shape of chunks, starting with the number of samples per chunk.
+     *
+     * Missing or zero extents default to the number of samples per batch
+     * and to the full extents of a sample.
+     */
+    std::vector<hsize_t> chunk;
+    /** size of chunk cache in bytes, or 0 for the HDF5 default */
+    std::size_t cache_size;
+    /** byte-shuffle scalars before compression */
+    bool shuffle;
+    /** level of deflate (gzip) compression, or 0 to disable */
+    unsigned int deflate;
+    /** level of Zstandard compression, or 0 to disable */
+    unsigned int zstd;
+    /**
+     * Quantisation step per component of the innermost dimension, or a
+     * single step for all components. If non-empty, floating-point samples
+     * are stored as integer multiples of the step, which are delta-encoded
+     * against the previous sample within each chunk.
+     */
+    std::vector<double> scale;
+};
+
+/**
+ * Memory layout of a sample of type T
+ *
+ * Provides the scalar type, the shape and the contiguous memory of a sample.
+ */
+template <typename T, typename Enable = void>
+struct sample_layout;
+
+template <typename T>
+struct sample_layout<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+{
+    typedef T scalar_type;
+
+    static void shape(T const&, std::vector<hsize_t>&) {}
+
+    static std::size_t size(T const&)
+    {
+        return 1;
+    }
+
+    static void const* data(T const& sample)
+    {
+        return &sample;
+    }
+};
+
+template <typename T, std::size_t N>
+struct sample_layout<fixed_vector<T, N> >
+{
+    typedef typename sample_layout<T>::scalar_type scalar_type;
+
+    static void shape(fixed_vector<T, N> const&, std::vector<hsize_t>& shape)
+    {
+        shape.push_back(N);
+    }
+
+    static std::size_t size(fixed_vector<T, N> const&)
+    {
+        return N;
+    }
+
+    static void const* data(fixed_vector<T, N> const& sample)
+    {
+        return &sample[0];
+    }
+};
+
+template <typename T, std::size_t N>
+struct sample_layout<boost::array<T, N> >
+{
+    typedef typename sample_layout<T>::scalar_type scalar_type;
+
+    static void shape(boost::array<T, N> const&, std::vector<hsize_t>& shape)
+    {
+        shape.push_back(N);
+    }
+
+    static std::size_t size(boost::array<T, N> const&)
+    {
+        return N;
+    }
+
+    static void const* data(boost::array<T, N> const& sample)
+    {
+        return &sample[0];
+    }
+};
+
+/**
+ * Contiguous arrays of scalars, fixed_vector or boost::array
+ */
+template <typename Array>
+struct array_layout
+{
+    typedef typename Array::value_type value_type;
+    typedef typename sample_layout<value_type>::scalar_type scalar_type;
+
+    static void shape(Array const& sample, std::vector<hsize_t>& shape)
+    {
+        shape.push_back(sample.size());
+        sample_layout<value_type>::shape(value_type(), shape);
+    }
+
+    static std::size_t size(Array const& sample)
+    {
+        return sample.size() * sample_layout<value_type>::size(value_type());
+    }
+
+    static void const* data(Array const& sample)
+    {
+        return sample.size() > 0 ? &sample[0] : nullptr;
+    }
+};
+
+template <typename T, typename Alloc>
+struct sample_layout<std::vector<T, Alloc> >
+  : array_layout<std::vector<T, Alloc> > {};
+
+template <typename T>
+struct sample_layout<raw_array<T> >
+  : array_layout<raw_array<T> > {};
+
+/**
+ * Array of elements produced on demand, which has no memory of its own.
+ */
+template <typename T>
+struct sample_layout<deferred_array<T> >
+{
+    typedef typename sample_layout<T>::scalar_type scalar_type;
+
+    static void shape(deferred_array<T> const& sample, std::vector<hsize_t>& shape)
+    {
+        shape.push_back(sample.size());
+        sample_layout<T>::shape(T(), shape);
+    }
+
+    static std::size_t size(deferred_array<T> const& sample)
+    {
+        return sample.size() * sample_layout<T>::size(T());
+    }
+};
+
+template <typename T, std::size_t N, typename Alloc>
+struct sample_layout<boost::multi_array<T, N, Alloc> >
+{
+    typedef typename sample_layout<T>::scalar_type scalar_type;
+
+    static void shape(boost::multi_array<T, N, Alloc> const& sample, std::vector<hsize_t>& shape)
+    {
+        shape.insert(shape.end(), sample.shape(), sample.shape() + N);
+    }
+
+    static std::size_t size(boost::multi_array<T, N, Alloc> const& sample)
+    {
+        return sample.num_elements();
+    }
+
+    static void const* data(boost::multi_array<T, N, Alloc> const& sample)
+    {
+        return sample.origin();
+    }
+};
+
+/**
+ * Returns native HDF5 type of scalar type.
+ */
+template <typename T>
+H5::PredType const& native_type()
+{
+    static_assert(std::is_arithmetic<T>::value, "scalar type required");
+    if (std::is_floating_point<T>::value) {
+        return sizeof(T) == sizeof(float) ? H5::PredType::NATIVE_FLOAT : H5::PredType::NATIVE_DOUBLE;
+    }
+    if (std::is_signed<T>::value) {
+        return sizeof(T) == 4 ? H5::PredType::NATIVE_INT32 : H5::PredType::NATIVE_INT64;
+    }
+    return sizeof(T) == 4 ? H5::PredType::NATIVE_UINT32 : H5::PredType::NATIVE_UINT64;
+}
+
+/**
+ * Time series dataset with batched writes
+ *
+ * Samples are buffered in memory and appended to the dataset in batches of
+ * a fixed number of samples, which replaces many small writes by a single
+ * write of a contiguous hyperslab. If a batch coincides with a chunk of the
+ * dataset, it is written directly as a chunk, bypassing the chunk cache.
+ *
+ * Chunks may be compressed by a pipeline of shuffle, deflate and Zstandard
+ * filters. The filters are applied by the HDF5 library upon writing a batch,
+ * i.e., in the I/O thread for asynchronous writers. As a chunk is compressed
+ * whenever it is written, a chunk should hold a multiple of batches.
+ *
+ * Floating-point samples may be stored lossily as 32-bit integers, which are
+ * the values divided by a quantisation step and rounded. The first sample of
+ * each chunk holds these integers, and each further sample within the chunk
+ * holds the differences to the previous sample, which are small for slowly
+ * varying data and compress well. The steps are stored in the attribute
+ * "scale_factor" and the number of samples per chunk in "delta_interval".
+ */
+class chunked_dataset
+{
+public:
+    /**
+     * Create dataset.
+     *
+     * @param group     parent group
+     * @param name      dataset name
+     * @param type      native HDF5 type of scalars
+     * @param shape     shape of a sample
+     * @param batch     number of samples per batch
+     * @param layout    storage layout
+     */
+    chunked_dataset(
+        H5::Group const& group
+      , std::string const& name
+      , H5::PredType const& type
+      , std::vector<hsize_t> const& shape
+      , unsigned int batch
+      , dataset_layout const& layout
+    );
+
+    /**
+     * Create dataset for samples of type T.
+     */
+    template <typename T>
+    static std::shared_ptr<chunked_dataset> create(
+        H5::Group const& group
+      , std::string const& name
+      , T const& sample
+      , unsigned int batch
+      , dataset_layout const& layout
+    );
+
+    /** write buffered samples */
+    ~chunked_dataset();
+
+    /**
+     * Append sample, which is written to the dataset upon completion of
+     * the batch.
+     */
+    template <typename T>
+    void append(T const& sample)
+    {
+        typedef typename sample_layout<T>::scalar_type scalar_type;
+        if (!scale_.empty()) {
+            quantise(static_cast<scalar_type const*>(sample_layout<T>::data(sample)), sample_layout<T>::size(sample));
+        }
+        else {
+            append(sample_layout<T>::data(sample), sample_layout<T>::size(sample));
+        }
+    }
+
+    /**
+     * Append sample of elements produced on demand, which are written
+     * directly to the buffer of the batch.
+     */
+    template <typename T>
+    void append(deferred_array<T> const& sample);
+
+    /** write buffered samples */
+    void flush();
+
+    /** returns HDF5 dataset */
+    H5::DataSet const& dataset() const
+    {
+        return dataset_;
+    }
+
+private:
+    /** append sample of given number of scalars */
+    void append(void const* data, std::size_t size);
+    /** returns buffer of next sample of given number of scalars */
+    void* reserve(std::size_t size);
+    /** complete sample written to buffer returned by reserve() */
+    void commit();
+    /** quantise and append sample of given number of scalars */
+    template <typename T>
+    void quantise(T const* data, std::size_t size);
+    /** delta-encode and append quantised sample */
+    void append_quantised();
+
+    /** HDF5 dataset */
+    H5::DataSet dataset_;
+    /** native HDF5 type of scalars */
+    H5::PredType type_;
+    /** extents of dataset including buffered samples */
+    std::vector<hsize_t> dims_;
+    /** shape of chunks */
+    std::vector<hsize_t> chunk_;
+    /** number of scalars per sample */
+    std::size_t sample_size_;
+    /** number of samples per batch */
+    unsigned int batch_;
+    /** true if a batch may be written as a single chunk */
+    bool direct_;
+    /** number of samples written to the dataset */
+    hsize_t size_;
+    /** number of buffered samples */
+    unsigned int count_;
+    /** buffered samples */
+    std::vector<char> buffer_;
+    /** quantisation steps, or empty for samples stored as is */
+    std::vector<double> scale_;
+    /** quantised sample */
+    std::vector<int64_t> quantised_;
+    /** quantised previous sample */
+    std::vector<int64_t> previous_;
+};
+
+template <typename T>
+std::shared_ptr<chunked_dataset> chunked_dataset::create(
+    H5::Group const& group
+  , std::string const& name
+  , T const& sample
+  , unsigned int batch
+  , dataset_layout const& layout
+)
+{
+    typedef typename sample_layout<T>::scalar_type scalar_type;
+    std::vector<hsize_t> shape;
+    sample_layout<T>::shape(sample, shape);
+    if (layout.quantised()) {
+        if (!std::is_floating_point<scalar_type>::value) {
+            throw std::logic_error("quantisation requires floating-point data");
+        }
+        return std::make_shared<chunked_dataset>(group, name, H5::PredType::NATIVE_INT32, shape, batch, layout);
+    }
+    return std::make_shared<chunked_dataset>(group, name, native_type<scalar_type>(), shape, batch, layout);
+}
+
+template <typename T>
+void chunked_dataset::append(deferred_array<T> const& sample)
+{
+    if (!scale_.empty()) {
+        raw_array<T> buffer(sample.size());
+        sample.fill(buffer.begin());
+        append(buffer);
+        return;
+    }
+    sample.fill(static_cast<T*>(reserve(sample_layout<deferred_array<T> >::size(sample))));
+    commit();
+}
+
+template <typename T>
+void chunked_dataset::quantise(T const* data, std::size_t size)
+{
+    if (size != sample_size_) {
+        throw std::logic_error("sample size does not match HDF5 dataset");
+    }
+    std::size_t const ncomp = scale_.size();
+    for (std::size_t i = 0; i < size; ++i) {
+        // rounding is undefined outside of the range of the integer type
+        double value = data[i] / scale_[i % ncomp];
+        if (!(value >= std::numeric_limits<int32_t>::min() && value <= std::numeric_limits<int32_t>::max())) {
+            throw std::range_error("quantised sample exceeds range of 32-bit integers");
+        }
+        quantised_[i] = std::llround(value);
+    }
+    append_quantised();
+}
+
+} // namespace h5md
+} // namespace writers
+} // namespace io
+} // namespace halmd
+
+#endif /* ! HALMD_IO_WRITERS_H5MD_CHUNKED_DATASET_HPP */
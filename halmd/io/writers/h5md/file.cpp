@@ -25,6 +25,7 @@
 #include <halmd/io/logger.hpp>
 #include <halmd/io/utility/hdf5.hpp>
 #include <halmd/io/writers/h5md/file.hpp>
+#include <halmd/io/writers/h5md/io_thread.hpp>
 #include <halmd/utility/filesystem.hpp>
 #include <halmd/utility/lua/lua.hpp>
 #include <halmd/utility/realname.hpp>
@@ -64,14 +65,27 @@ file::file(string const& path, string const& author_name, string const& author_e
 void file::flush()
 {
     LOG("flush H5MD file: " << absolute_path(file_.getFileName()));
+    on_prepend_flush_();
+    // commit samples of asynchronous writers
+    io_thread::get().wait();
+    auto lock = io_thread::lock();
     file_.flush(H5F_SCOPE_GLOBAL);
 }
 
 void file::close()
 {
+    on_prepend_flush_();
+    // commit samples of asynchronous writers
+    io_thread::get().wait();
+    auto lock = io_thread::lock();
     file_.close();
 }
 
+connection file::on_prepend_flush(slot_function_type const& slot)
+{
+    return on_prepend_flush_.connect(slot);
+}
+
 H5::Group file::root() const
 {
     return file_.openGroup("/");
@@ -103,6 +117,7 @@ void file::luaopen(lua_State* L)
                         .def(constructor<string const&, string const&, string const&>())
                         .def("flush", &file::flush)
                         .def("close", &file::close)
+                        .def("on_prepend_flush", &file::on_prepend_flush)
                         .property("root", &file::root)
                         .property("path", &file::path)
                         .scope
@@ -27,6 +27,8 @@
 #include <lua.hpp>
 #include <string>
 
+#include <halmd/utility/signal.hpp>
+
 namespace halmd {
 namespace io {
 namespace writers {
@@ -43,6 +45,8 @@ class file
 public:
     /** H5MD major and minor file version type */
     typedef boost::array<int, 2> version_type;
+    typedef signal<void ()> signal_type;
+    typedef signal_type::slot_function_type slot_function_type;
 
     /**
      * create H5MD file
@@ -53,10 +57,25 @@ public:
      */
     file(std::string const& path, std::string const& author_name = "", std::string const& author_email = "");
 
-    /** flush file to disk */
+    /**
+     * flush file to disk
+     *
+     * The slots connected to on_prepend_flush are invoked before.
+     */
     void flush();
-    /** explicitly close file */
+    /**
+     * explicitly close file
+     *
+     * The slots connected to on_prepend_flush are invoked before.
+     */
     void close();
+    /**
+     * connect slot invoked before flushing or closing the file
+     *
+     * Append writers of the file that buffer or queue samples connect
+     * append::drain(), so that their samples are written before.
+     */
+    connection on_prepend_flush(slot_function_type const& slot);
     /** get HDF5 root group */
     H5::Group root() const;
     /** get file pathname */
@@ -71,6 +90,8 @@ public:
 private:
     /** H5MD file */
     H5::H5File file_;
+    /** signal emitted before flushing or closing the file */
+    signal_type on_prepend_flush_;
 };
 
 } // namespace h5md
@@ -0,0 +1,114 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <hdf5.h>
+
+#include <halmd/io/writers/h5md/io_thread.hpp>
+
+namespace halmd {
+namespace io {
+namespace writers {
+namespace h5md {
+
+/** serialises calls into the HDF5 library */
+static std::mutex hdf5_mutex;
+
+io_thread& io_thread::get()
+{
+    static io_thread instance;
+    return instance;
+}
+
+std::unique_lock<std::mutex> io_thread::lock()
+{
+    return std::unique_lock<std::mutex>(hdf5_mutex);
+}
+
+bool io_thread::threadsafe()
+{
+    hbool_t is_ts = false;
+#if H5_VERSION_GE(1, 8, 16)
+    if (H5is_library_threadsafe(&is_ts) < 0) {
+        return false;
+    }
+#endif
+    return is_ts;
+}
+
+io_thread::io_thread()
+  : busy_(false)
+  , stop_(false)
+  , thread_(&io_thread::run_, this)
+{}
+
+io_thread::~io_thread()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+    thread_.join();
+}
+
+std::future<void> io_thread::push(task_type const& task)
+{
+    std::packaged_task<void ()> packaged(task);
+    std::future<void> future = packaged.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(packaged));
+    }
+    cond_.notify_all();
+    return future;
+}
+
+void io_thread::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [&]() { return queue_.empty() && !busy_; });
+}
+
+void io_thread::run_()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cond_.wait(lock, [&]() { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            break; // stop_ is set and all tasks are completed
+        }
+        std::packaged_task<void ()> task = std::move(queue_.front());
+        queue_.pop_front();
+        busy_ = true;
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> hdf5_lock(hdf5_mutex);
+            task(); // an exception is stored in the future
+        }
+        lock.lock();
+        busy_ = false;
+        cond_.notify_all();
+    }
+}
+
+} // namespace h5md
+} // namespace writers
+} // namespace io
+} // namespace halmd
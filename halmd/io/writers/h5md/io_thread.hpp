@@ -0,0 +1,112 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_IO_WRITERS_H5MD_IO_THREAD_HPP
+#define HALMD_IO_WRITERS_H5MD_IO_THREAD_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace halmd {
+namespace io {
+namespace writers {
+namespace h5md {
+
+/**
+ * Background thread for writing to HDF5 files
+ *
+ * Asynchronous writers enqueue tasks, which are executed in order by a
+ * single process-wide thread. The thread holds a global lock while executing
+ * a task, which is also held by the writers when they call into the HDF5
+ * library, so that the tasks of a writer are serialised with its staging.
+ *
+ * Other modules, e.g., the readers and the Lua bindings of HDF5 objects,
+ * call into the HDF5 library without the lock, which therefore must be
+ * built thread-safe for tasks to be executed, see threadsafe().
+ */
+class io_thread
+{
+public:
+    typedef std::function<void ()> task_type;
+
+    /**
+     * Returns process-wide I/O thread, which is started on first use.
+     */
+    static io_thread& get();
+
+    /**
+     * Returns lock that serialises calls into the HDF5 library with the
+     * execution of tasks.
+     */
+    static std::unique_lock<std::mutex> lock();
+
+    /**
+     * Returns true if the HDF5 library is built thread-safe.
+     */
+    static bool threadsafe();
+
+    /**
+     * Enqueue task and return future, which becomes ready upon completion of
+     * the task and holds an exception thrown by the task.
+     */
+    std::future<void> push(task_type const& task);
+
+    /**
+     * Wait until all tasks enqueued so far have completed.
+     *
+     * Exceptions thrown by tasks are not reported, they are held by the
+     * futures returned from push().
+     */
+    void wait();
+
+    /**
+     * Complete pending tasks and stop thread.
+     */
+    ~io_thread();
+
+private:
+    io_thread();
+    /** execute tasks until stopped */
+    void run_();
+
+    /** mutex protecting queue */
+    std::mutex mutex_;
+    /** signals enqueued tasks and completion of tasks */
+    std::condition_variable cond_;
+    /** pending tasks */
+    std::deque<std::packaged_task<void ()>> queue_;
+    /** true while a task is executed */
+    bool busy_;
+    /** true if thread shall stop after completion of pending tasks */
+    bool stop_;
+    /** I/O thread */
+    std::thread thread_;
+};
+
+} // namespace h5md
+} // namespace writers
+} // namespace io
+} // namespace halmd
+
+#endif /* ! HALMD_IO_WRITERS_H5MD_IO_THREAD_HPP */
@@ -25,6 +25,7 @@
 #include <stdint.h> // uint32_t, uint64_t
 
 #include <halmd/io/utility/hdf5.hpp>
+#include <halmd/io/writers/h5md/io_thread.hpp>
 #include <halmd/io/writers/h5md/truncate.hpp>
 #include <halmd/numeric/blas/fixed_vector.hpp>
 #include <halmd/utility/lua/lua.hpp>
@@ -46,6 +47,7 @@ truncate::truncate(
     if (location.size() < 1) {
         throw invalid_argument("group location");
     }
+    auto lock = io_thread::lock();
     group_ = h5xx::open_group(root, boost::join(location, "/"));
 }
 
@@ -114,6 +116,7 @@ connection truncate::on_write(
     if (location.size() < 1) {
         throw invalid_argument("dataset location");
     }
+    auto lock = io_thread::lock();
     return on_write_.connect(bind(&write_dataset<T>, dataset, group_, boost::join(location, "/"), slot));
 }
 
@@ -130,7 +133,11 @@ connection truncate::on_append_write(slot_function_type const& slot)
 void truncate::write()
 {
     on_prepend_write_();
-    on_write_();
+    {
+        // serialise with asynchronous writers
+        auto lock = io_thread::lock();
+        on_write_();
+    }
     on_append_write_();
 }
 
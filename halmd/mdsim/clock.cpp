@@ -50,6 +50,14 @@ void clock::set_timestep(time_type timestep)
     LOG("integration time step: " << *timestep_);
 }
 
+void clock::set_step(step_type step, time_type time)
+{
+    step_ = step_origin_ = step;
+    time_ = time_origin_ = time;
+
+    LOG("simulation step: " << step_ << ", time: " << time_);
+}
+
 HALMD_LUA_API int luaopen_libhalmd_mdsim_clock(lua_State* L)
 {
     using namespace luaponte;
@@ -60,6 +68,7 @@ HALMD_LUA_API int luaopen_libhalmd_mdsim_clock(lua_State* L)
             class_<clock, std::shared_ptr<clock> >("clock")
                 .def(constructor<>())
                 .def("set_timestep", &clock::set_timestep)
+                .def("set_step", &clock::set_step)
                 .def("on_set_timestep", &clock::on_set_timestep)
                 .property("step", &clock::step)
                 .property("time", &clock::time)
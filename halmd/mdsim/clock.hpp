@@ -78,6 +78,11 @@ public:
      */
     void set_timestep(time_type timestep);
 
+    /**
+     * set simulation step and time, e.g., upon restart from a checkpoint
+     */
+    void set_step(step_type step, time_type time);
+
     /**
      * connect slot to set time step signal
      */
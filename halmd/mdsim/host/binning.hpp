@@ -85,6 +85,21 @@ public:
     //! get cell lists
     cache<array_type> const& cell();
 
+    /**
+     * Returns linear index of the cell containing the given position.
+     *
+     * The linear index refers to the storage order of the cell lists.
+     */
+    size_t cell_index(vector_type const& r) const
+    {
+        cell_size_type index = element_mod(static_cast<cell_size_type>(element_div(r, cell_length_) + static_cast<vector_type>(ncell_)), ncell_);
+        size_t offset = index[0];
+        for (int j = 1; j < dimension; ++j) {
+            offset = offset * ncell_[j] + index[j];
+        }
+        return offset;
+    }
+
 private:
     typedef typename particle_type::size_type size_type;
     typedef typename particle_type::position_array_type position_array_type;
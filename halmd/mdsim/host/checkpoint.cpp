@@ -0,0 +1,652 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <halmd/mdsim/host/checkpoint.hpp>
+#include <halmd/utility/lua/lua.hpp>
+
+namespace halmd {
+namespace mdsim {
+namespace host {
+
+/** identifier at the beginning of a checkpoint file */
+static char const checkpoint_magic[8] = {'H', 'A', 'L', 'M', 'D', 'C', 'K', 'P'};
+/** version of the checkpoint format */
+static uint32_t const checkpoint_version = 1;
+/** alignment of the particle arrays within the file */
+static std::size_t const checkpoint_alignment = 4096;
+
+/**
+ * Header at the beginning of a checkpoint file.
+ *
+ * The header is followed by the particle arrays, each aligned to
+ * checkpoint_alignment, and the named states, each given by the
+ * size and bytes of its name and the size and bytes of its data.
+ */
+struct checkpoint_header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t dimension;
+    uint32_t float_size;
+    uint32_t nparticle;
+    uint32_t nspecies;
+    uint32_t nstate;
+    uint64_t step;
+    double time;
+    double timestep;
+    double length[3];
+};
+
+static std::runtime_error system_error(std::string const& what, std::string const& filename)
+{
+    return std::runtime_error(what + " " + filename + ": " + std::strerror(errno));
+}
+
+/**
+ * Checkpoint file opened for writing, which is written to a temporary
+ * file and renamed upon commit().
+ */
+class checkpoint_writer
+{
+public:
+    explicit checkpoint_writer(std::string const& filename)
+      : filename_(filename), temporary_(filename + ".tmp"), offset_(0)
+    {
+        fd_ = ::open(temporary_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0) {
+            throw system_error("failed to create checkpoint file", temporary_);
+        }
+    }
+
+    ~checkpoint_writer()
+    {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            ::unlink(temporary_.c_str());
+        }
+    }
+
+    /** append bytes to file */
+    void write(void const* data, std::size_t size)
+    {
+        char const* first = static_cast<char const*>(data);
+        while (size > 0) {
+            ssize_t count = ::write(fd_, first, size);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw system_error("failed to write checkpoint file", temporary_);
+            }
+            first += count;
+            size -= count;
+            offset_ += count;
+        }
+    }
+
+    /** append zeros up to the next aligned offset */
+    void align()
+    {
+        static char const zero[checkpoint_alignment] = {};
+        write(zero, (checkpoint_alignment - offset_ % checkpoint_alignment) % checkpoint_alignment);
+    }
+
+    /** append array aligned within file */
+    template <typename array_type>
+    void write_array(array_type const& array)
+    {
+        align();
+        write(&*array.begin(), array.size() * sizeof(typename array_type::value_type));
+    }
+
+    /** append string preceded by its size */
+    void write_string(std::string const& s)
+    {
+        uint64_t size = s.size();
+        write(&size, sizeof(size));
+        write(s.data(), s.size());
+    }
+
+    /** flush file to storage and replace checkpoint file */
+    void commit()
+    {
+        if (::fsync(fd_) < 0) {
+            throw system_error("failed to write checkpoint file", temporary_);
+        }
+        int fd = fd_;
+        fd_ = -1;
+        if (::close(fd) < 0) {
+            ::unlink(temporary_.c_str());
+            throw system_error("failed to close checkpoint file", temporary_);
+        }
+        if (::rename(temporary_.c_str(), filename_.c_str()) < 0) {
+            ::unlink(temporary_.c_str());
+            throw system_error("failed to rename checkpoint file", temporary_);
+        }
+    }
+
+private:
+    std::string filename_;
+    std::string temporary_;
+    int fd_;
+    std::size_t offset_;
+};
+
+/**
+ * Checkpoint file mapped into memory for reading.
+ */
+class checkpoint_reader
+{
+public:
+    explicit checkpoint_reader(std::string const& filename)
+      : filename_(filename), data_(nullptr), size_(0), offset_(0)
+    {
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw system_error("failed to open checkpoint file", filename);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) < 0) {
+            ::close(fd);
+            throw system_error("failed to open checkpoint file", filename);
+        }
+        size_ = st.st_size;
+        if (size_ < sizeof(checkpoint_header)) {
+            ::close(fd);
+            throw std::runtime_error("truncated checkpoint file " + filename);
+        }
+        void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // the mapping holds a reference to the file
+        if (data == MAP_FAILED) {
+            throw system_error("failed to map checkpoint file", filename);
+        }
+        data_ = static_cast<char const*>(data);
+        ::madvise(data, size_, MADV_SEQUENTIAL);
+
+        read(&header_, sizeof(header_));
+        if (!std::equal(checkpoint_magic, checkpoint_magic + sizeof(checkpoint_magic), header_.magic)) {
+            ::munmap(data, size_);
+            throw std::runtime_error("not a HALMD checkpoint file: " + filename);
+        }
+        if (header_.version != checkpoint_version) {
+            ::munmap(data, size_);
+            throw std::runtime_error("unsupported version of checkpoint file " + filename);
+        }
+    }
+
+    ~checkpoint_reader()
+    {
+        if (data_) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    checkpoint_header const& header() const
+    {
+        return header_;
+    }
+
+    /** copy bytes from file */
+    void read(void* output, std::size_t size)
+    {
+        if (size > size_ - offset_) {
+            throw std::runtime_error("truncated checkpoint file " + filename_);
+        }
+        std::memcpy(output, data_ + offset_, size);
+        offset_ += size;
+    }
+
+    /** copy array aligned within file */
+    template <typename array_type>
+    void read_array(array_type& array)
+    {
+        offset_ = std::min(size_, (offset_ + checkpoint_alignment - 1) / checkpoint_alignment * checkpoint_alignment);
+        read(&*array.begin(), array.size() * sizeof(typename array_type::value_type));
+    }
+
+    /** read string preceded by its size */
+    std::string read_string()
+    {
+        uint64_t size;
+        read(&size, sizeof(size));
+        if (size > size_ - offset_) {
+            throw std::runtime_error("truncated checkpoint file " + filename_);
+        }
+        std::string s(data_ + offset_, size);
+        offset_ += size;
+        return s;
+    }
+
+private:
+    std::string filename_;
+    char const* data_;
+    std::size_t size_;
+    std::size_t offset_;
+    checkpoint_header header_;
+};
+
+checkpoint_info checkpoint_info::read(std::string const& filename)
+{
+    checkpoint_reader file(filename);
+    checkpoint_header const& header = file.header();
+    checkpoint_info info;
+    info.dimension = header.dimension;
+    info.float_size = header.float_size;
+    info.nparticle = header.nparticle;
+    info.nspecies = header.nspecies;
+    info.step = header.step;
+    info.time = header.time;
+    info.timestep = header.timestep;
+    info.length.assign(header.length, header.length + std::min(header.dimension, 3u));
+    return info;
+}
+
+template <int dimension, typename float_type>
+checkpoint<dimension, float_type>::checkpoint(
+    std::shared_ptr<particle_type> particle
+  , std::shared_ptr<box_type const> box
+  , std::shared_ptr<clock_type> clock
+  , std::shared_ptr<logger> logger
+)
+  : particle_(particle)
+  , box_(box)
+  , clock_(clock)
+  , logger_(logger)
+  , child_(0)
+  , error_fd_(-1) {}
+
+template <int dimension, typename float_type>
+checkpoint<dimension, float_type>::~checkpoint()
+{
+    collect(true);
+}
+
+template <int dimension, typename float_type>
+void checkpoint<dimension, float_type>::add_state(
+    std::string const& name
+  , save_function_type const& save
+  , restore_function_type const& restore
+)
+{
+    for (state const& s : state_) {
+        if (s.name == name) {
+            throw std::invalid_argument("duplicate checkpoint state: " + name);
+        }
+    }
+    state_.push_back({name, save, restore});
+}
+
+template <int dimension, typename float_type>
+void checkpoint<dimension, float_type>::write(std::string const& filename)
+{
+    std::vector<std::string> data;
+    for (state const& s : state_) {
+        data.push_back(s.save());
+    }
+
+    LOG("write checkpoint at step " << clock_->step() << " to " << filename);
+
+    scoped_timer_type timer(runtime_.write);
+    write_file(filename, data);
+}
+
+template <int dimension, typename float_type>
+void checkpoint<dimension, float_type>::fork_write(std::string const& filename)
+{
+    if (!collect(false)) {
+        LOG_WARNING("waiting for pending checkpoint " << child_filename_);
+        collect(true);
+    }
+
+    // the states are obtained by the parent, as they may involve the
+    // Lua interpreter, and the particle arrays are brought up to date
+    std::vector<std::string> data;
+    for (state const& s : state_) {
+        data.push_back(s.save());
+    }
+    read_cache(particle_->position());
+    read_cache(particle_->image());
+    read_cache(particle_->velocity());
+    read_cache(particle_->tag());
+    read_cache(particle_->reverse_tag());
+    read_cache(particle_->species());
+    read_cache(particle_->mass());
+
+    LOG("write checkpoint at step " << clock_->step() << " to " << filename << " in background");
+
+    scoped_timer_type timer(runtime_.fork);
+
+    int fd[2];
+    if (::pipe(fd) < 0) {
+        throw system_error("failed to create pipe for checkpoint", filename);
+    }
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        ::close(fd[0]);
+        ::close(fd[1]);
+        throw system_error("failed to fork process for checkpoint", filename);
+    }
+    if (pid == 0) {
+        // The child process must not use the logger, nor any other facility
+        // that may be locked by a thread of the parent process. It exits
+        // without unwinding the state of the parent.
+        ::close(fd[0]);
+        sigset_t set;
+        sigemptyset(&set);
+        pthread_sigmask(SIG_SETMASK, &set, nullptr); // restore default handling of signals
+        int status = EXIT_SUCCESS;
+        try {
+            write_file(filename, data);
+        }
+        catch (std::exception const& e) {
+            std::size_t size = std::strlen(e.what());
+            if (::write(fd[1], e.what(), size) < 0) {} // the exit status suffices
+            status = EXIT_FAILURE;
+        }
+        catch (...) {
+            status = EXIT_FAILURE;
+        }
+        ::_exit(status);
+    }
+    ::close(fd[1]);
+    child_ = pid;
+    error_fd_ = fd[0];
+    child_filename_ = filename;
+}
+
+template <int dimension, typename float_type>
+bool checkpoint<dimension, float_type>::poll()
+{
+    return collect(false);
+}
+
+template <int dimension, typename float_type>
+void checkpoint<dimension, float_type>::wait()
+{
+    collect(true);
+    if (!failed_filename_.empty()) {
+        std::string filename;
+        std::swap(filename, failed_filename_);
+        throw std::runtime_error("failed to write checkpoint " + filename);
+    }
+}
+
+template <int dimension, typename float_type>
+bool checkpoint<dimension, float_type>::collect(bool block)
+{
+    if (child_ == 0) {
+        return true;
+    }
+    int status;
+    pid_t pid;
+    do {
+        pid = ::waitpid(child_, &status, block ? 0 : WNOHANG);
+    } while (pid < 0 && errno == EINTR);
+    if (pid == 0) {
+        return false; // child is running
+    }
+
+    // the child has exited and closed the write end of the pipe
+    std::string message;
+    char buffer[256];
+    ssize_t count;
+    while ((count = ::read(error_fd_, buffer, sizeof(buffer))) > 0) {
+        message.append(buffer, count);
+    }
+    ::close(error_fd_);
+    error_fd_ = -1;
+    child_ = 0;
+
+    // a failure is kept until it is reported by wait(), even if the child
+    // is collected by poll() or fork_write() and followed by further snapshots
+    bool failed = true;
+    if (pid < 0) {
+        LOG_ERROR("failed to wait for checkpoint " << child_filename_ << ": " << std::strerror(errno));
+    }
+    else if (WIFSIGNALED(status)) {
+        LOG_ERROR("writing checkpoint " << child_filename_ << " terminated by signal " << WTERMSIG(status));
+    }
+    else if (WEXITSTATUS(status) != EXIT_SUCCESS) {
+        LOG_ERROR("writing checkpoint " << child_filename_ << " failed" << (message.empty() ? "" : ": ") << message);
+    }
+    else {
+        LOG("checkpoint " << child_filename_ << " written");
+        failed = false;
+    }
+    if (failed && failed_filename_.empty()) {
+        failed_filename_ = child_filename_;
+    }
+    return true;
+}
+
+template <int dimension, typename float_type>
+void checkpoint<dimension, float_type>::write_file(
+    std::string const& filename
+  , std::vector<std::string> const& data
+)
+{
+    position_array_type const& position = read_cache(particle_->position());
+    image_array_type const& image = read_cache(particle_->image());
+    velocity_array_type const& velocity = read_cache(particle_->velocity());
+    tag_array_type const& tag = read_cache(particle_->tag());
+    reverse_tag_array_type const& reverse_tag = read_cache(particle_->reverse_tag());
+    species_array_type const& species = read_cache(particle_->species());
+    mass_array_type const& mass = read_cache(particle_->mass());
+
+    checkpoint_header header = {};
+    std::copy(checkpoint_magic, checkpoint_magic + sizeof(checkpoint_magic), header.magic);
+    header.version = checkpoint_version;
+    header.dimension = dimension;
+    header.float_size = sizeof(float_type);
+    header.nparticle = particle_->nparticle();
+    header.nspecies = particle_->nspecies();
+    header.nstate = state_.size();
+    header.step = clock_->step();
+    header.time = clock_->time();
+    try {
+        header.timestep = clock_->timestep();
+    }
+    catch (std::logic_error const&) {
+        header.timestep = 0; // time step has not been set
+    }
+    for (int i = 0; i < dimension; ++i) {
+        header.length[i] = box_->length()[i];
+    }
+
+    checkpoint_writer file(filename);
+    file.write(&header, sizeof(header));
+    file.write_array(position);
+    file.write_array(image);
+    file.write_array(velocity);
+    file.write_array(tag);
+    file.write_array(reverse_tag);
+    file.write_array(species);
+    file.write_array(mass);
+    for (std::size_t i = 0; i < state_.size(); ++i) {
+        file.write_string(state_[i].name);
+        file.write_string(data[i]);
+    }
+    file.commit();
+}
+
+template <int dimension, typename float_type>
+void checkpoint<dimension, float_type>::read(std::string const& filename)
+{
+    checkpoint_reader file(filename);
+    checkpoint_header const& header = file.header();
+
+    if (header.dimension != dimension || header.float_size != sizeof(float_type)) {
+        throw std::runtime_error("mismatching dimension or precision of checkpoint " + filename);
+    }
+    if (header.nparticle != particle_->nparticle() || header.nspecies != particle_->nspecies()) {
+        throw std::runtime_error("mismatching number of particles or species in checkpoint " + filename);
+    }
+    for (int i = 0; i < dimension; ++i) {
+        if (header.length[i] != box_->length()[i]) {
+            throw std::runtime_error("mismatching simulation box of checkpoint " + filename);
+        }
+    }
+
+    LOG("read checkpoint at step " << header.step << " from " << filename);
+
+    {
+        scoped_timer_type timer(runtime_.read);
+
+        auto position = make_cache_mutable(particle_->position());
+        auto image = make_cache_mutable(particle_->image());
+        auto velocity = make_cache_mutable(particle_->velocity());
+        auto tag = make_cache_mutable(particle_->tag());
+        auto reverse_tag = make_cache_mutable(particle_->reverse_tag());
+        auto species = make_cache_mutable(particle_->species());
+        auto mass = make_cache_mutable(particle_->mass());
+
+        file.read_array(*position);
+        file.read_array(*image);
+        file.read_array(*velocity);
+        file.read_array(*tag);
+        file.read_array(*reverse_tag);
+        file.read_array(*species);
+        file.read_array(*mass);
+    }
+
+    std::vector<bool> restored(state_.size(), false);
+    for (uint32_t i = 0; i < header.nstate; ++i) {
+        std::string name = file.read_string();
+        std::string data = file.read_string();
+        auto s = std::find_if(state_.begin(), state_.end(), [&](state const& s) { return s.name == name; });
+        if (s != state_.end()) {
+            s->restore(data);
+            restored[s - state_.begin()] = true;
+        }
+        else {
+            LOG_WARNING("ignore unknown state '" << name << "' of checkpoint");
+        }
+    }
+    for (std::size_t i = 0; i < state_.size(); ++i) {
+        if (!restored[i]) {
+            LOG_WARNING("state '" << state_[i].name << "' is missing in checkpoint");
+        }
+    }
+
+    clock_->set_step(header.step, header.time);
+}
+
+void checkpoint_info::luaopen(lua_State* L)
+{
+    using namespace luaponte;
+    module(L, "libhalmd")
+    [
+        namespace_("mdsim")
+        [
+            namespace_("host")
+            [
+                class_<checkpoint_info>("checkpoint_info")
+                    .def_readonly("dimension", &checkpoint_info::dimension)
+                    .def_readonly("float_size", &checkpoint_info::float_size)
+                    .def_readonly("nparticle", &checkpoint_info::nparticle)
+                    .def_readonly("nspecies", &checkpoint_info::nspecies)
+                    .def_readonly("step", &checkpoint_info::step)
+                    .def_readonly("time", &checkpoint_info::time)
+                    .def_readonly("timestep", &checkpoint_info::timestep)
+                    .def_readonly("length", &checkpoint_info::length)
+                    .scope
+                    [
+                        def("read", &checkpoint_info::read)
+                    ]
+            ]
+        ]
+    ];
+}
+
+template <int dimension, typename float_type>
+void checkpoint<dimension, float_type>::luaopen(lua_State* L)
+{
+    using namespace luaponte;
+    static std::string class_name = "checkpoint_" + std::to_string(dimension);
+    module(L, "libhalmd")
+    [
+        namespace_("mdsim")
+        [
+            namespace_("host")
+            [
+                class_<checkpoint, std::shared_ptr<checkpoint> >(class_name.c_str())
+                    .def(constructor<
+                        std::shared_ptr<particle_type>
+                      , std::shared_ptr<box_type const>
+                      , std::shared_ptr<clock_type>
+                      , std::shared_ptr<logger>
+                    >())
+                    .def("add_state", &checkpoint::add_state)
+                    .def("write", &checkpoint::write)
+                    .def("fork_write", &checkpoint::fork_write)
+                    .def("poll", &checkpoint::poll)
+                    .def("wait", &checkpoint::wait)
+                    .def("read", &checkpoint::read)
+                    .scope
+                    [
+                        class_<runtime>("runtime")
+                            .def_readonly("write", &runtime::write)
+                            .def_readonly("fork", &runtime::fork)
+                            .def_readonly("read", &runtime::read)
+                    ]
+                    .def_readonly("runtime", &checkpoint::runtime_)
+            ]
+        ]
+    ];
+}
+
+HALMD_LUA_API int luaopen_libhalmd_mdsim_host_checkpoint(lua_State* L)
+{
+    checkpoint_info::luaopen(L);
+#ifndef USE_HOST_SINGLE_PRECISION
+    checkpoint<3, double>::luaopen(L);
+    checkpoint<2, double>::luaopen(L);
+#else
+    checkpoint<3, float>::luaopen(L);
+    checkpoint<2, float>::luaopen(L);
+#endif
+    return 0;
+}
+
+// explicit instantiation
+#ifndef USE_HOST_SINGLE_PRECISION
+template class checkpoint<3, double>;
+template class checkpoint<2, double>;
+#else
+template class checkpoint<3, float>;
+template class checkpoint<2, float>;
+#endif
+
+} // namespace host
+} // namespace mdsim
+} // namespace halmd
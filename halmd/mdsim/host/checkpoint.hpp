@@ -0,0 +1,214 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_MDSIM_HOST_CHECKPOINT_HPP
+#define HALMD_MDSIM_HOST_CHECKPOINT_HPP
+
+#include <functional>
+#include <lua.hpp>
+#include <memory>
+#include <string>
+#include <sys/types.h> // pid_t
+#include <vector>
+
+#include <halmd/io/logger.hpp>
+#include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/clock.hpp>
+#include <halmd/mdsim/host/particle.hpp>
+#include <halmd/utility/profiler.hpp>
+
+namespace halmd {
+namespace mdsim {
+namespace host {
+
+/**
+ * Header of a checkpoint file, which describes the simulated system.
+ */
+struct checkpoint_info
+{
+    /** space dimension */
+    unsigned int dimension;
+    /** size of floating-point type of particle arrays in bytes */
+    unsigned int float_size;
+    /** number of particles */
+    unsigned int nparticle;
+    /** number of particle species */
+    unsigned int nspecies;
+    /** simulation step */
+    clock::step_type step;
+    /** simulation time */
+    clock::time_type time;
+    /** integration time step, or 0 if not set */
+    clock::time_type timestep;
+    /** edge lengths of cuboid simulation box */
+    std::vector<double> length;
+
+    /** read header of given checkpoint file */
+    static checkpoint_info read(std::string const& filename);
+    /** Lua bindings */
+    static void luaopen(lua_State* L);
+};
+
+/**
+ * Checkpoint of particles in host memory
+ *
+ * A checkpoint holds the raw particle arrays, i.e., positions, images,
+ * velocities, tags, reverse tags, species, and masses, in the order of
+ * the particles in memory, along with the simulation step and time, and
+ * the edge lengths of the box. Further named states, e.g., of integrators
+ * or random number generators, may be added as byte strings.
+ *
+ * The file is written with a few large sequential writes to a temporary
+ * file, which is renamed upon completion. For restoring, the file is mapped
+ * into memory and the particle arrays are copied in bulk, so that both are
+ * bound by the bandwidth of the storage. The particle arrays are stored in
+ * native byte order, a checkpoint is thus not portable across platforms.
+ *
+ * With fork_write(), the checkpoint is written by a child process, which
+ * holds a copy-on-write snapshot of the particle arrays, while the calling
+ * process continues the simulation. The exit status of the child process is
+ * collected by poll() or wait(), which report a failure.
+ */
+template <int dimension, typename float_type>
+class checkpoint
+{
+public:
+    typedef host::particle<dimension, float_type> particle_type;
+    typedef mdsim::box<dimension> box_type;
+    typedef mdsim::clock clock_type;
+    typedef std::function<std::string ()> save_function_type;
+    typedef std::function<void (std::string const&)> restore_function_type;
+
+    checkpoint(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<box_type const> box
+      , std::shared_ptr<clock_type> clock
+      , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
+    );
+    /** wait for pending snapshot */
+    ~checkpoint();
+
+    /**
+     * add named state to checkpoint
+     *
+     * @param save     returns state as byte string upon writing
+     * @param restore  sets state from byte string upon reading
+     */
+    void add_state(
+        std::string const& name
+      , save_function_type const& save
+      , restore_function_type const& restore
+    );
+
+    /** write checkpoint to file */
+    void write(std::string const& filename);
+
+    /**
+     * write checkpoint to file in a forked child process
+     *
+     * A pending snapshot is awaited before forking.
+     */
+    void fork_write(std::string const& filename);
+
+    /**
+     * collect exit status of pending snapshot without blocking
+     *
+     * @returns true if no snapshot is pending
+     */
+    bool poll();
+
+    /**
+     * wait for completion of pending snapshot
+     *
+     * Throws std::runtime_error if a snapshot failed since the last call,
+     * including snapshots collected by poll() or fork_write().
+     */
+    void wait();
+
+    /**
+     * restore particles, clock, and added states from checkpoint file
+     *
+     * The number of particles and species, the floating-point precision,
+     * and the box must match the checkpoint.
+     */
+    void read(std::string const& filename);
+
+    /** Lua bindings */
+    static void luaopen(lua_State* L);
+
+private:
+    typedef typename particle_type::position_array_type position_array_type;
+    typedef typename particle_type::image_array_type image_array_type;
+    typedef typename particle_type::velocity_array_type velocity_array_type;
+    typedef typename particle_type::tag_array_type tag_array_type;
+    typedef typename particle_type::reverse_tag_array_type reverse_tag_array_type;
+    typedef typename particle_type::species_array_type species_array_type;
+    typedef typename particle_type::mass_array_type mass_array_type;
+
+    struct state
+    {
+        std::string name;
+        save_function_type save;
+        restore_function_type restore;
+    };
+
+    /** write checkpoint with given data of named states */
+    void write_file(std::string const& filename, std::vector<std::string> const& data);
+    /** collect exit status of child process, returns false if it is running */
+    bool collect(bool block);
+
+    /** particle instance */
+    std::shared_ptr<particle_type> particle_;
+    /** simulation box */
+    std::shared_ptr<box_type const> box_;
+    /** simulation clock */
+    std::shared_ptr<clock_type> clock_;
+    /** module logger */
+    std::shared_ptr<halmd::logger> logger_;
+    /** named states in order of addition */
+    std::vector<state> state_;
+    /** process ID of pending snapshot, or 0 */
+    pid_t child_;
+    /** read end of pipe for error message of pending snapshot */
+    int error_fd_;
+    /** filename of pending snapshot */
+    std::string child_filename_;
+    /** filename of first failed snapshot not yet reported by wait(), or empty */
+    std::string failed_filename_;
+
+    typedef utility::profiler::accumulator_type accumulator_type;
+    typedef utility::profiler::scoped_timer_type scoped_timer_type;
+
+    struct runtime
+    {
+        accumulator_type write;
+        accumulator_type fork;
+        accumulator_type read;
+    };
+
+    /** profiling runtime accumulators */
+    runtime runtime_;
+};
+
+} // namespace host
+} // namespace mdsim
+} // namespace halmd
+
+#endif /* ! HALMD_MDSIM_HOST_CHECKPOINT_HPP */
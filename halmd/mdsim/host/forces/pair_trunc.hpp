@@ -69,6 +69,12 @@ public:
      */
     void check_cache();
 
+    /**
+     * Renew the cache observers after the particles were rearranged in
+     * memory, which permutes the force along with the positions.
+     */
+    void update_cache();
+
     /**
      * Compute and apply the force to the particles.
      */
@@ -90,12 +96,15 @@ private:
     typedef typename particle_type::en_pot_array_type en_pot_array_type;
     typedef typename particle_type::stress_pot_array_type stress_pot_array_type;
     typedef typename particle_type::stress_pot_type stress_pot_type;
+    typedef typename particle_type::stress_pot_sum_type stress_pot_sum_type;
     typedef typename neighbour_type::array_type neighbour_array_type;
 
     /** compute forces */
     void compute_();
     /** compute forces with auxiliary variables */
     void compute_aux_();
+    /** compute forces with sums of auxiliary variables over all particles */
+    void compute_aux_sum_();
 
     /** pair potential */
     std::shared_ptr<potential_type const> potential_;
@@ -118,6 +127,8 @@ private:
     std::tuple<cache<>, cache<>, cache<>, cache<>> force_cache_;
     /** cache observer of auxiliary variables */
     std::tuple<cache<>, cache<>, cache<>, cache<>> aux_cache_;
+    /** cache observer of sums of auxiliary variables */
+    std::tuple<cache<>, cache<>, cache<>, cache<>> aux_sum_cache_;
 
     typedef utility::profiler::accumulator_type accumulator_type;
     typedef utility::profiler::scoped_timer_type scoped_timer_type;
@@ -126,6 +137,7 @@ private:
     {
         accumulator_type compute;
         accumulator_type compute_aux;
+        accumulator_type compute_aux_sum;
     };
 
     /** profiling runtime accumulators */
@@ -171,6 +183,29 @@ inline void pair_trunc<dimension, float_type, potential_type, trunc_type>::check
     if (aux_cache_ != current_state) {
         particle1_->mark_aux_dirty();
     }
+
+    if (aux_sum_cache_ != current_state) {
+        particle1_->mark_aux_sum_dirty();
+    }
+}
+
+template <int dimension, typename float_type, typename potential_type, typename trunc_type>
+inline void pair_trunc<dimension, float_type, potential_type, trunc_type>::update_cache()
+{
+    cache<position_array_type> const& position1_cache = particle1_->position();
+    cache<position_array_type> const& position2_cache = particle2_->position();
+    cache<species_array_type> const& species1_cache = particle1_->species();
+    cache<species_array_type> const& species2_cache = particle2_->species();
+
+    auto current_state = std::tie(position1_cache, position2_cache, species1_cache, species2_cache);
+
+    force_cache_ = current_state;
+    if (!particle1_->aux_dirty()) {
+        aux_cache_ = current_state;
+    }
+    if (!particle1_->aux_sum_dirty()) {
+        aux_sum_cache_ = current_state;
+    }
 }
 
 template <int dimension, typename float_type, typename potential_type, typename trunc_type>
@@ -187,6 +222,12 @@ inline void pair_trunc<dimension, float_type, potential_type, trunc_type>::apply
         compute_aux_();
         force_cache_ = current_state;
         aux_cache_ = force_cache_;
+        aux_sum_cache_ = force_cache_;
+    }
+    else if (particle1_->aux_sum_enabled()) {
+        compute_aux_sum_();
+        force_cache_ = current_state;
+        aux_sum_cache_ = force_cache_;
     }
     else {
         compute_();
@@ -254,8 +295,10 @@ template <int dimension, typename float_type, typename potential_type, typename
 inline void pair_trunc<dimension, float_type, potential_type, trunc_type>::compute_aux_()
 {
     auto force      = make_cache_mutable(particle1_->mutable_force());
-    auto en_pot     = make_cache_mutable(particle1_->mutable_potential_energy());;
-    auto stress_pot = make_cache_mutable(particle1_->mutable_stress_pot());;
+    auto en_pot     = make_cache_mutable(particle1_->mutable_potential_energy());
+    auto stress_pot = make_cache_mutable(particle1_->mutable_stress_pot());
+    auto en_pot_sum = make_cache_mutable(particle1_->mutable_potential_energy_sum());
+    auto stress_pot_sum = make_cache_mutable(particle1_->mutable_stress_pot_sum());
 
     neighbour_array_type const& lists    = *neighbour_->lists();
     position_array_type const& position1 = read_cache(particle1_->position());
@@ -273,6 +316,8 @@ inline void pair_trunc<dimension, float_type, potential_type, trunc_type>::compu
         std::fill(force->begin(), force->end(), 0);
         std::fill(en_pot->begin(), en_pot->end(), 0);
         std::fill(stress_pot->begin(), stress_pot->end(), 0);
+        *en_pot_sum = 0;
+        *stress_pot_sum = 0;
     }
 
     // whether Newton's third law applies
@@ -283,6 +328,10 @@ inline void pair_trunc<dimension, float_type, potential_type, trunc_type>::compu
         weight /= 2;
     }
 
+    // sums over all particles of the contributions of this module
+    double en_pot_acc = 0;
+    stress_pot_sum_type stress_pot_acc = 0;
+
     for (size_type i = 0; i < nparticle1; ++i) {
         // calculate pairwise force with neighbour particles
         for (size_type j : lists[i]) {
@@ -325,8 +374,83 @@ inline void pair_trunc<dimension, float_type, potential_type, trunc_type>::compu
                 (*en_pot)[j]      += en;
                 (*stress_pot)[j]  += stress;
             }
+
+            // add contributions of particle pair to sums
+            en_pot_acc += pot;
+            stress_pot_acc += fval * make_stress_tensor(r);
+        }
+    }
+    *en_pot_sum += aux_weight_ * en_pot_acc;
+    *stress_pot_sum += aux_weight_ * stress_pot_acc;
+}
+
+template <int dimension, typename float_type, typename potential_type, typename trunc_type>
+inline void pair_trunc<dimension, float_type, potential_type, trunc_type>::compute_aux_sum_()
+{
+    auto force = make_cache_mutable(particle1_->mutable_force());
+    auto en_pot_sum = make_cache_mutable(particle1_->mutable_potential_energy_sum());
+    auto stress_pot_sum = make_cache_mutable(particle1_->mutable_stress_pot_sum());
+
+    neighbour_array_type const& lists    = *neighbour_->lists();
+    position_array_type const& position1 = read_cache(particle1_->position());
+    position_array_type const& position2 = read_cache(particle2_->position());
+    species_array_type const& species1   = *particle1_->species();
+    species_array_type const& species2   = *particle2_->species();
+    size_type nparticle1 = particle1_->nparticle();
+
+    LOG_TRACE("compute forces with sums of auxiliary variables");
+
+    scoped_timer_type timer(runtime_.compute_aux_sum);
+
+    // reset the force and auxiliary variables to zero if necessary
+    if (particle1_->force_zero()) {
+        std::fill(force->begin(), force->end(), 0);
+        *en_pot_sum = 0;
+        *stress_pot_sum = 0;
+    }
+
+    // whether Newton's third law applies
+    bool const reactio = (particle1_ == particle2_);
+
+    // accumulate the sums in local variables instead of per-particle arrays
+    double en_pot_acc = 0;
+    stress_pot_sum_type stress_pot_acc = 0;
+
+    for (size_type i = 0; i < nparticle1; ++i) {
+        // calculate pairwise force with neighbour particles
+        for (size_type j : lists[i]) {
+            // particle distance vector
+            position_type r = position1[i] - position2[j];
+            box_->reduce_periodic(r);
+            // particle types
+            species_type a = species1[i];
+            species_type b = species2[j];
+            // squared particle distance
+            float_type rr = inner_prod(r, r);
+
+            // truncate potential at cutoff length
+            if (rr >= potential_->rr_cut(a, b))
+                continue;
+
+            float_type fval, pot;
+            std::tie(fval, pot) = (*potential_)(rr, a, b);
+
+            // optionally smooth potential yielding continuous 2nd derivative
+            (*trunc_)(std::sqrt(rr), potential_->r_cut(a, b), fval, pot);
+
+            // add force contribution to both particles
+            (*force)[i] += r * fval;
+            if (reactio) {
+                (*force)[j] -= r * fval;
+            }
+
+            // add contributions of particle pair to sums
+            en_pot_acc += pot;
+            stress_pot_acc += fval * make_stress_tensor(r);
         }
     }
+    *en_pot_sum += aux_weight_ * en_pot_acc;
+    *stress_pot_sum += aux_weight_ * stress_pot_acc;
 }
 
 template <int dimension, typename float_type, typename potential_type, typename trunc_type>
@@ -341,12 +465,14 @@ void pair_trunc<dimension, float_type, potential_type, trunc_type>::luaopen(lua_
             [
                 class_<pair_trunc>()
                     .def("check_cache", &pair_trunc::check_cache)
+                    .def("update_cache", &pair_trunc::update_cache)
                     .def("apply", &pair_trunc::apply)
                     .scope
                     [
                         class_<runtime>("runtime")
                             .def_readonly("compute", &runtime::compute)
                             .def_readonly("compute_aux", &runtime::compute_aux)
+                            .def_readonly("compute_aux_sum", &runtime::compute_aux_sum)
                     ]
                     .def_readonly("runtime", &pair_trunc::runtime_)
 
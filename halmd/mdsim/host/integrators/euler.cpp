@@ -23,6 +23,7 @@
 #include <memory>
 
 #include <halmd/mdsim/host/integrators/euler.hpp>
+#include <halmd/mdsim/host/particle_groups/all.hpp>
 #include <halmd/utility/lua/lua.hpp>
 #include <halmd/utility/scoped_timer.hpp>
 #include <halmd/utility/timer.hpp>
@@ -41,9 +42,28 @@ euler<dimension, float_type>::euler(
   , std::shared_ptr<box_type const> box
   , double timestep
   , std::shared_ptr<logger> logger
+)
+  : euler(
+        particle
+      , std::make_shared<particle_groups::all<particle_type>>(particle)
+      , box
+      , timestep
+      , logger
+    )
+{
+}
+
+template <int dimension, typename float_type>
+euler<dimension, float_type>::euler(
+    std::shared_ptr<particle_type> particle
+  , std::shared_ptr<particle_group_type> group
+  , std::shared_ptr<box_type const> box
+  , double timestep
+  , std::shared_ptr<logger> logger
 )
   // dependency injection (initialize public variables)
   : particle_(particle)
+  , group_(group)
   , box_(box)
   , logger_(logger)
 {
@@ -70,7 +90,7 @@ void euler<dimension, float_type>::integrate()
     LOG_TRACE("update positions")
 
     velocity_array_type const& velocity = read_cache(particle_->velocity());
-    size_type nparticle = particle_->nparticle();
+    group_array_type const& group = read_cache(group_->unordered());
 
     // invalidate the particle caches after accessing the velocity!
     auto position = make_cache_mutable(particle_->position());
@@ -78,7 +98,7 @@ void euler<dimension, float_type>::integrate()
 
     scoped_timer_type timer(runtime_.integrate);
 
-    for (size_type i = 0 ; i < nparticle; ++i) {
+    for (size_type i : group) {
         vector_type& r = (*position)[i];
         r += velocity[i] * timestep_;
         (*image)[i] += box_->reduce_periodic(r);
@@ -130,6 +150,13 @@ void euler<dimension, float_type>::luaopen(lua_State* L)
                   , double
                   , std::shared_ptr<logger>
                 >)
+              , def("euler", &std::make_shared<euler
+                  , std::shared_ptr<particle_type>
+                  , std::shared_ptr<particle_group_type>
+                  , std::shared_ptr<box_type const>
+                  , double
+                  , std::shared_ptr<logger>
+                >)
             ]
         ]
     ];
@@ -27,6 +27,7 @@
 #include <halmd/io/logger.hpp>
 #include <halmd/mdsim/box.hpp>
 #include <halmd/mdsim/host/particle.hpp>
+#include <halmd/mdsim/host/particle_group.hpp>
 #include <halmd/utility/profiler.hpp>
 
 namespace halmd {
@@ -40,10 +41,14 @@ class euler
 public:
     typedef host::particle<dimension, float_type> particle_type;
     typedef typename particle_type::vector_type vector_type;
+    typedef host::particle_group particle_group_type;
     typedef mdsim::box<dimension> box_type;
 
     static void luaopen(lua_State* L);
 
+    /**
+     * Integrate all particles.
+     */
     euler(
         std::shared_ptr<particle_type> particle
       , std::shared_ptr<box_type const> box
@@ -51,6 +56,17 @@ public:
       , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
     );
 
+    /**
+     * Integrate only the particles of the given group.
+     */
+    euler(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<particle_group_type> group
+      , std::shared_ptr<box_type const> box
+      , double timestep
+      , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
+    );
+
     void integrate();
 
     //! set integration timestep
@@ -66,6 +82,7 @@ private:
     typedef typename particle_type::position_array_type position_array_type;
     typedef typename particle_type::image_array_type image_array_type;
     typedef typename particle_type::velocity_array_type velocity_array_type;
+    typedef typename particle_group_type::array_type group_array_type;
     typedef typename particle_type::size_type size_type;
 
     typedef utility::profiler::accumulator_type accumulator_type;
@@ -77,6 +94,7 @@ private:
     };
 
     std::shared_ptr<particle_type> particle_;
+    std::shared_ptr<particle_group_type> group_;
     std::shared_ptr<box_type const> box_;
 
     /** integration time-step */
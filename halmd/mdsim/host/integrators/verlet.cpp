@@ -23,6 +23,7 @@
 #include <memory>
 
 #include <halmd/mdsim/host/integrators/verlet.hpp>
+#include <halmd/mdsim/host/particle_groups/all.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
 namespace halmd {
@@ -36,9 +37,28 @@ verlet<dimension, float_type>::verlet(
   , std::shared_ptr<box_type const> box
   , double timestep
   , std::shared_ptr<logger> logger
+)
+  : verlet(
+        particle
+      , std::make_shared<particle_groups::all<particle_type>>(particle)
+      , box
+      , timestep
+      , logger
+    )
+{
+}
+
+template <int dimension, typename float_type>
+verlet<dimension, float_type>::verlet(
+    std::shared_ptr<particle_type> particle
+  , std::shared_ptr<particle_group_type> group
+  , std::shared_ptr<box_type const> box
+  , double timestep
+  , std::shared_ptr<logger> logger
 )
   // dependency injection
   : particle_(particle)
+  , group_(group)
   , box_(box)
   , logger_(logger)
 {
@@ -62,7 +82,7 @@ void verlet<dimension, float_type>::integrate()
 
     force_array_type const& force = read_cache(particle_->force());
     mass_array_type const& mass = read_cache(particle_->mass());
-    size_type nparticle = particle_->nparticle();
+    group_array_type const& group = read_cache(group_->unordered());
 
     // invalidate the particle caches after accessing the force!
     auto position = make_cache_mutable(particle_->position());
@@ -71,7 +91,7 @@ void verlet<dimension, float_type>::integrate()
 
     scoped_timer_type timer(runtime_.integrate);
 
-    for (size_type i = 0; i < nparticle; ++i) {
+    for (size_type i : group) {
         vector_type& v = (*velocity)[i];
         vector_type& r = (*position)[i];
         v += force[i] * timestep_half_ / mass[i];
@@ -90,14 +110,14 @@ void verlet<dimension, float_type>::finalize()
 
     force_array_type const& force = read_cache(particle_->force());
     mass_array_type const& mass = read_cache(particle_->mass());
-    size_type nparticle = particle_->nparticle();
+    group_array_type const& group = read_cache(group_->unordered());
 
     // invalidate the particle caches after accessing the force!
     auto velocity = make_cache_mutable(particle_->velocity());
 
     scoped_timer_type timer(runtime_.finalize);
 
-    for (size_type i = 0; i < nparticle; ++i) {
+    for (size_type i : group) {
         (*velocity)[i] += force[i] * timestep_half_ / mass[i];
     }
 }
@@ -131,6 +151,13 @@ void verlet<dimension, float_type>::luaopen(lua_State* L)
                   , double
                   , std::shared_ptr<logger>
                 >)
+              , def("verlet", &std::make_shared<verlet
+                  , std::shared_ptr<particle_type>
+                  , std::shared_ptr<particle_group_type>
+                  , std::shared_ptr<box_type const>
+                  , double
+                  , std::shared_ptr<logger>
+                >)
             ]
         ]
     ];
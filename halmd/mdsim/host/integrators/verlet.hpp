@@ -27,6 +27,7 @@
 #include <halmd/io/logger.hpp>
 #include <halmd/mdsim/box.hpp>
 #include <halmd/mdsim/host/particle.hpp>
+#include <halmd/mdsim/host/particle_group.hpp>
 #include <halmd/utility/profiler.hpp>
 
 namespace halmd {
@@ -40,16 +41,32 @@ class verlet
 public:
     typedef host::particle<dimension, float_type> particle_type;
     typedef typename particle_type::vector_type vector_type;
+    typedef host::particle_group particle_group_type;
     typedef mdsim::box<dimension> box_type;
 
     static void luaopen(lua_State* L);
 
+    /**
+     * Integrate all particles.
+     */
     verlet(
         std::shared_ptr<particle_type> particle
       , std::shared_ptr<box_type const> box
       , double timestep
       , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
     );
+
+    /**
+     * Integrate only the particles of the given group, e.g., the mobile
+     * particles of a system with frozen walls or an immobile matrix.
+     */
+    verlet(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<particle_group_type> group
+      , std::shared_ptr<box_type const> box
+      , double timestep
+      , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
+    );
     void integrate();
     void finalize();
     void set_timestep(double timestep);
@@ -66,6 +83,7 @@ private:
     typedef typename particle_type::velocity_array_type velocity_array_type;
     typedef typename particle_type::force_array_type force_array_type;
     typedef typename particle_type::mass_array_type mass_array_type;
+    typedef typename particle_group_type::array_type group_array_type;
     typedef typename particle_type::size_type size_type;
 
     typedef utility::profiler::accumulator_type accumulator_type;
@@ -79,6 +97,8 @@ private:
 
     /** system state */
     std::shared_ptr<particle_type> particle_;
+    /** particles to be integrated */
+    std::shared_ptr<particle_group_type> group_;
     /** simulation domain */
     std::shared_ptr<box_type const> box_;
     /** integration time-step */
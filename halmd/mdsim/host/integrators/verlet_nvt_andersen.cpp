@@ -24,6 +24,7 @@
 #include <memory>
 
 #include <halmd/mdsim/host/integrators/verlet_nvt_andersen.hpp>
+#include <halmd/mdsim/host/particle_groups/all.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
 namespace halmd {
@@ -40,8 +41,33 @@ verlet_nvt_andersen<dimension, float_type>::verlet_nvt_andersen(
   , float_type temperature
   , float_type coll_rate
   , std::shared_ptr<logger> logger
+)
+  : verlet_nvt_andersen(
+        particle
+      , std::make_shared<particle_groups::all<particle_type>>(particle)
+      , box
+      , random
+      , timestep
+      , temperature
+      , coll_rate
+      , logger
+    )
+{
+}
+
+template <int dimension, typename float_type>
+verlet_nvt_andersen<dimension, float_type>::verlet_nvt_andersen(
+    std::shared_ptr<particle_type> particle
+  , std::shared_ptr<particle_group_type> group
+  , std::shared_ptr<box_type const> box
+  , std::shared_ptr<random_type> random
+  , float_type timestep
+  , float_type temperature
+  , float_type coll_rate
+  , std::shared_ptr<logger> logger
 )
   : particle_(particle)
+  , group_(group)
   , box_(box)
   , random_(random)
   , coll_rate_(coll_rate)
@@ -75,7 +101,7 @@ void verlet_nvt_andersen<dimension, float_type>::integrate()
 
     force_array_type const& force = read_cache(particle_->force());
     mass_array_type const& mass = read_cache(particle_->mass());
-    size_type nparticle = particle_->nparticle();
+    group_array_type const& group = read_cache(group_->unordered());
 
     // invalidate the particle caches after accessing the force!
     auto position = make_cache_mutable(particle_->position());
@@ -84,7 +110,7 @@ void verlet_nvt_andersen<dimension, float_type>::integrate()
 
     scoped_timer_type timer(runtime_.integrate);
 
-    for (size_type i = 0; i < nparticle; ++i) {
+    for (size_type i : group) {
         vector_type& v = (*velocity)[i];
         vector_type& r = (*position)[i];
         v += force[i] * timestep_half_ / mass[i];
@@ -100,7 +126,7 @@ void verlet_nvt_andersen<dimension, float_type>::finalize()
 
     force_array_type const& force = read_cache(particle_->force());
     mass_array_type const& mass = read_cache(particle_->mass());
-    size_type nparticle = particle_->nparticle();
+    group_array_type const& group = read_cache(group_->unordered());
 
     // invalidate the particle caches after accessing the force!
     auto velocity = make_cache_mutable(particle_->velocity());
@@ -111,8 +137,8 @@ void verlet_nvt_andersen<dimension, float_type>::finalize()
     float_type rng_cache = 0;
     bool rng_cache_valid = false;
 
-    // loop over all particles
-    for (size_type i = 0; i < nparticle; ++i) {
+    // loop over particles of group
+    for (size_type i : group) {
         vector_type& v = (*velocity)[i];
         // is deterministic step?
         if (random_->uniform<float_type>() > coll_prob_) {
@@ -173,6 +199,16 @@ void verlet_nvt_andersen<dimension, float_type>::luaopen(lua_State* L)
                   , float_type
                   , std::shared_ptr<logger>
                 >)
+              , def("verlet_nvt_andersen", &std::make_shared<verlet_nvt_andersen
+                  , std::shared_ptr<particle_type>
+                  , std::shared_ptr<particle_group_type>
+                  , std::shared_ptr<box_type const>
+                  , std::shared_ptr<random_type>
+                  , float_type
+                  , float_type
+                  , float_type
+                  , std::shared_ptr<logger>
+                >)
             ]
         ]
     ];
@@ -27,6 +27,7 @@
 #include <halmd/io/logger.hpp>
 #include <halmd/mdsim/box.hpp>
 #include <halmd/mdsim/host/particle.hpp>
+#include <halmd/mdsim/host/particle_group.hpp>
 #include <halmd/random/host/random.hpp>
 #include <halmd/utility/profiler.hpp>
 
@@ -40,6 +41,7 @@ class verlet_nvt_andersen
 {
 public:
     typedef host::particle<dimension, float_type> particle_type;
+    typedef host::particle_group particle_group_type;
     typedef mdsim::box<dimension> box_type;
     typedef random::host::random random_type;
 
@@ -60,6 +62,23 @@ public:
       , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
     );
 
+    /**
+     * Initialise Verlet-Andersen integrator for a group of particles.
+     *
+     * Only the particles of the group are propagated and coupled to the heat
+     * bath, all other particles remain at rest.
+     */
+    verlet_nvt_andersen(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<particle_group_type> group
+      , std::shared_ptr<box_type const> box
+      , std::shared_ptr<random_type> random
+      , float_type timestep
+      , float_type temperature
+      , float_type coll_rate
+      , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
+    );
+
     /**
      * First leapfrog half-step of velocity-Verlet algorithm
      */
@@ -115,10 +134,13 @@ private:
     typedef typename particle_type::velocity_array_type velocity_array_type;
     typedef typename particle_type::force_array_type force_array_type;
     typedef typename particle_type::mass_array_type mass_array_type;
+    typedef typename particle_group_type::array_type group_array_type;
     typedef typename particle_type::size_type size_type;
 
     /** system state */
     std::shared_ptr<particle_type> particle_;
+    /** particles to be integrated */
+    std::shared_ptr<particle_group_type> group_;
     /** simulation domain */
     std::shared_ptr<box_type const> box_;
     /** random number generator */
@@ -23,7 +23,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <memory>
+#include <sstream>
+#include <stdexcept>
 
 #include <halmd/mdsim/host/integrators/verlet_nvt_hoover.hpp>
 #include <halmd/utility/demangle.hpp>
@@ -206,6 +209,29 @@ void verlet_nvt_hoover<dimension, float_type>::propagate_chain()
     v_xi[1] += (mass_xi_[0] * v_xi[0] * v_xi[0] - temperature_) / mass_xi_[1] * timestep_4_;
 }
 
+template <int dimension, typename float_type>
+string verlet_nvt_hoover<dimension, float_type>::state() const
+{
+    ostringstream stream;
+    stream.precision(numeric_limits<float_type>::max_digits10);
+    stream << xi[0] << " " << xi[1] << " " << v_xi[0] << " " << v_xi[1];
+    return stream.str();
+}
+
+template <int dimension, typename float_type>
+void verlet_nvt_hoover<dimension, float_type>::set_state(string const& state)
+{
+    istringstream stream(state);
+    chain_type xi_, v_xi_;
+    stream >> xi_[0] >> xi_[1] >> v_xi_[0] >> v_xi_[1];
+    if (stream.fail()) {
+        throw invalid_argument("invalid state of Nosé-Hoover chain");
+    }
+    xi = xi_;
+    v_xi = v_xi_;
+    LOG("restore heat bath variables: xi = " << xi << ", v_xi = " << v_xi);
+}
+
 template <typename integrator_type>
 static std::function<void ()>
 wrap_integrate(std::shared_ptr<integrator_type> self)
@@ -274,6 +300,8 @@ void verlet_nvt_hoover<dimension, float_type>::luaopen(lua_State* L)
                     .def("set_timestep", &verlet_nvt_hoover::set_timestep)
                     .def("set_temperature", &verlet_nvt_hoover::set_temperature)
                     .def("set_mass", &verlet_nvt_hoover::set_mass)
+                    .property("state", &verlet_nvt_hoover::state)
+                    .def("set_state", &verlet_nvt_hoover::set_state)
                     .scope
                     [
                         class_<runtime>("runtime")
@@ -23,6 +23,7 @@
 
 #include <lua.hpp>
 #include <memory>
+#include <string>
 
 #include <halmd/io/logger.hpp>
 #include <halmd/mdsim/box.hpp>
@@ -97,6 +98,11 @@ public:
         return en_nhc_;
     }
 
+    //! returns positions and velocities of the heat bath variables in text form
+    std::string state() const;
+    //! restore heat bath variables, e.g., from a checkpoint
+    void set_state(std::string const& state);
+
     /**
      * chain of heat bath variables
      *
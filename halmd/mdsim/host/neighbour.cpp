@@ -21,10 +21,26 @@
 #include <halmd/mdsim/host/neighbour.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
+#include <cstdlib>
+
 namespace halmd {
 namespace mdsim {
 namespace host {
 
+double mean_index_distance(neighbour& neighbour)
+{
+    neighbour::array_type const& lists = read_cache(neighbour.lists());
+    double sum = 0;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < lists.size(); ++i) {
+        for (unsigned int j : lists[i]) {
+            sum += std::labs(static_cast<long>(j) - static_cast<long>(i));
+        }
+        count += lists[i].size();
+    }
+    return count > 0 ? sum / count : 0;
+}
+
 void neighbour::luaopen(lua_State* L)
 {
     using namespace luaponte;
@@ -35,6 +51,7 @@ void neighbour::luaopen(lua_State* L)
             namespace_("host")
             [
                 class_<neighbour>("neighbour")
+                    .def("mean_index_distance", &mean_index_distance)
             ]
         ]
     ];
@@ -50,6 +50,14 @@ public:
     virtual cache<array_type> const& lists() = 0;
 };
 
+/**
+ * Returns mean distance of particle indices over all pairs of neighbours.
+ *
+ * The quantity measures the data locality of the particle order, which is
+ * improved by sorting the particles along a space-filling curve.
+ */
+double mean_index_distance(neighbour& neighbour);
+
 } // namespace host
 } // namespace mdsim
 } // namespace halmd
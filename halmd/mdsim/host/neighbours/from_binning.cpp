@@ -23,6 +23,8 @@
 #include <halmd/mdsim/host/neighbours/from_binning.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
+#include <stdexcept>
+
 namespace halmd {
 namespace mdsim {
 namespace host {
@@ -45,6 +47,30 @@ from_binning<dimension, float_type>::from_binning(
   , matrix_type const& r_cut
   , double skin
   , std::shared_ptr<logger> logger
+)
+  : from_binning(
+        particle
+      , binning
+      , displacement
+      , box
+      , r_cut
+      , skin
+      , std::make_pair(nullptr, nullptr)
+      , logger
+    )
+{
+}
+
+template <int dimension, typename float_type>
+from_binning<dimension, float_type>::from_binning(
+    std::pair<std::shared_ptr<particle_type const>, std::shared_ptr<particle_type const>> particle
+  , std::pair<std::shared_ptr<binning_type>, std::shared_ptr<binning_type>> binning
+  , std::pair<std::shared_ptr<displacement_type>, std::shared_ptr<displacement_type>> displacement
+  , std::shared_ptr<box_type const> box
+  , matrix_type const& r_cut
+  , double skin
+  , std::pair<std::shared_ptr<particle_group_type>, std::shared_ptr<particle_group_type>> group
+  , std::shared_ptr<logger> logger
 )
   // dependency injection
   : particle1_(particle.first)
@@ -54,6 +80,8 @@ from_binning<dimension, float_type>::from_binning(
   , displacement1_(displacement.first)
   , displacement2_(displacement.second)
   , box_(box)
+  , group1_(group.first)
+  , group2_(group.second)
   , logger_(logger)
   // allocate parameters
   , neighbour_(particle1_->nparticle())
@@ -71,6 +99,15 @@ from_binning<dimension, float_type>::from_binning(
     }
 
     LOG("neighbour list skin: " << r_skin_);
+
+    if (group1_ && group2_) {
+        mobile1_.resize(particle1_->nparticle());
+        mobile2_.resize(particle2_->nparticle());
+        LOG("omit pairs of immobile particles");
+    }
+    else if (group1_ || group2_) {
+        throw std::invalid_argument("groups of mobile particles must be given for both particle instances");
+    }
 }
 
 template <int dimension, typename float_type>
@@ -108,6 +145,18 @@ bool from_binning<dimension, float_type>::is_binning_compatible(
     return true;
 }
 
+/**
+ * Update masks of mobile particles
+ */
+template <int dimension, typename float_type>
+void from_binning<dimension, float_type>::update_mobile()
+{
+    if (group1_ && group2_) {
+        get_mask(*group1_, mobile1_);
+        get_mask(*group2_, mobile2_);
+    }
+}
+
 /**
  * Update neighbour lists
  */
@@ -123,6 +172,8 @@ void from_binning<dimension, float_type>::update()
 
     scoped_timer_type timer(runtime_.update);
 
+    update_mobile();
+
     cell_size_type const& ncell = binning1_->ncell();
     cell_size_type i;
     for (i[0] = 0; i[0] < ncell[0]; ++i[0]) {
@@ -199,12 +250,17 @@ void from_binning<dimension, float_type>::compute_cell_neighbours(size_t i, cell
     position_array_type const& position2 = read_cache(particle2_->position());
     species_array_type const& species1 = read_cache(particle1_->species());
     species_array_type const& species2 = read_cache(particle2_->species());
+    bool const skip_immobile = !mobile1_.empty() && !mobile1_[i];
 
     for (size_type j : c) {
         // skip identical particle and particle pair permutations if same cell
         if (same_cell && particle1_ == particle2_ && j <= i) {
             continue;
         }
+        // skip pair of immobile particles
+        if (skip_immobile && !mobile2_[j]) {
+            continue;
+        }
 
         // particle distance vector
         vector_type r = position1[i] - position2[j];
@@ -254,6 +310,16 @@ void from_binning<dimension, float_type>::luaopen(lua_State* L)
                   , double
                   , std::shared_ptr<logger>
                   >)
+              , def("from_binning", &std::make_shared<from_binning
+                  , std::pair<std::shared_ptr<particle_type const>, std::shared_ptr<particle_type const>>
+                  , std::pair<std::shared_ptr<binning_type>, std::shared_ptr<binning_type>>
+                  , std::pair<std::shared_ptr<displacement_type>, std::shared_ptr<displacement_type>>
+                  , std::shared_ptr<box_type const>
+                  , matrix_type const&
+                  , double
+                  , std::pair<std::shared_ptr<particle_group_type>, std::shared_ptr<particle_group_type>>
+                  , std::shared_ptr<logger>
+                  >)
               , def("is_binning_compatible", &from_binning::is_binning_compatible)
             ]
         ]
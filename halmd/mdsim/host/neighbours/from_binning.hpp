@@ -29,6 +29,7 @@
 #include <halmd/mdsim/host/max_displacement.hpp>
 #include <halmd/mdsim/host/neighbour.hpp>
 #include <halmd/mdsim/host/particle.hpp>
+#include <halmd/mdsim/host/particle_group.hpp>
 #include <halmd/utility/profiler.hpp>
 
 #include <boost/numeric/ublas/matrix.hpp>
@@ -57,6 +58,7 @@ public:
     typedef host::binning<dimension, float_type> binning_type;
     typedef typename _Base::neighbour_list neighbour_list;
     typedef max_displacement<dimension, float_type> displacement_type;
+    typedef host::particle_group particle_group_type;
 
     typedef _Base::array_type array_type;
 
@@ -72,6 +74,24 @@ public:
       , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
     );
 
+    /**
+     * Construct neighbour lists that omit pairs of immobile particles.
+     *
+     * Pairs where neither particle belongs to the respective group of mobile
+     * particles are not stored. Forces between immobile particles are then
+     * not computed, nor are their contributions to potential energy and stress.
+     */
+    from_binning(
+        std::pair<std::shared_ptr<particle_type const>, std::shared_ptr<particle_type const>> particle
+      , std::pair<std::shared_ptr<binning_type>, std::shared_ptr<binning_type>> binning
+      , std::pair<std::shared_ptr<displacement_type>, std::shared_ptr<displacement_type>> displacement
+      , std::shared_ptr<box_type const> box
+      , matrix_type const& r_cut
+      , double skin
+      , std::pair<std::shared_ptr<particle_group_type>, std::shared_ptr<particle_group_type>> group
+      , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
+    );
+
     connection on_prepend_update(std::function<void ()> const& slot)
     {
         return on_prepend_update_.connect(slot);
@@ -124,8 +144,13 @@ private:
     std::shared_ptr<displacement_type> displacement1_;
     std::shared_ptr<displacement_type> displacement2_;
     std::shared_ptr<box_type const> box_;
+    std::shared_ptr<particle_group_type> group1_;
+    std::shared_ptr<particle_group_type> group2_;
     std::shared_ptr<logger> logger_;
 
+    /** update masks of mobile particles */
+    void update_mobile();
+
     void update();
     void update_cell_neighbours(cell_size_type const& i);
     template <bool same_cell>
@@ -133,6 +158,9 @@ private:
 
     /** neighbour lists */
     cache<array_type> neighbour_;
+    /** masks of mobile particles, empty if all particles are mobile */
+    std::vector<char> mobile1_;
+    std::vector<char> mobile2_;
     /** cache observer for neighbour list update */
     std::tuple<cache<>, cache<>> neighbour_cache_;
     /** neighbour list skin in MD units */
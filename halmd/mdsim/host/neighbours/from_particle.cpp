@@ -21,6 +21,8 @@
 #include <halmd/mdsim/host/neighbours/from_particle.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
+#include <stdexcept>
+
 namespace halmd {
 namespace mdsim {
 namespace host {
@@ -42,6 +44,28 @@ from_particle<dimension, float_type>::from_particle(
   , matrix_type const& r_cut
   , double skin
   , std::shared_ptr<logger> logger
+)
+  : from_particle(
+        particle
+      , displacement
+      , box
+      , r_cut
+      , skin
+      , std::make_pair(nullptr, nullptr)
+      , logger
+    )
+{
+}
+
+template <int dimension, typename float_type>
+from_particle<dimension, float_type>::from_particle(
+    std::pair<std::shared_ptr<particle_type const>, std::shared_ptr<particle_type const>> particle
+  , std::pair<std::shared_ptr<displacement_type>, std::shared_ptr<displacement_type>> displacement
+  , std::shared_ptr<box_type const> box
+  , matrix_type const& r_cut
+  , double skin
+  , std::pair<std::shared_ptr<particle_group_type>, std::shared_ptr<particle_group_type>> group
+  , std::shared_ptr<logger> logger
 )
   // dependency injection
   : particle1_(particle.first)
@@ -49,6 +73,8 @@ from_particle<dimension, float_type>::from_particle(
   , displacement1_(displacement.first)
   , displacement2_(displacement.second)
   , box_(box)
+  , group1_(group.first)
+  , group2_(group.second)
   , logger_(logger)
   // allocate parameters
   , neighbour_(particle1_->nparticle())
@@ -66,6 +92,15 @@ from_particle<dimension, float_type>::from_particle(
     }
 
     LOG("neighbour list skin: " << r_skin_);
+
+    if (group1_ && group2_) {
+        mobile1_.resize(particle1_->nparticle());
+        mobile2_.resize(particle2_->nparticle());
+        LOG("omit pairs of immobile particles");
+    }
+    else if (group1_ || group2_) {
+        throw std::invalid_argument("groups of mobile particles must be given for both particle instances");
+    }
 }
 
 template <int dimension, typename float_type>
@@ -89,6 +124,18 @@ from_particle<dimension, float_type>::lists()
     return neighbour_;
 }
 
+/**
+ * Update masks of mobile particles
+ */
+template <int dimension, typename float_type>
+void from_particle<dimension, float_type>::update_mobile()
+{
+    if (group1_ && group2_) {
+        get_mask(*group1_, mobile1_);
+        get_mask(*group2_, mobile2_);
+    }
+}
+
 /**
  * Update neighbour lists
  */
@@ -108,6 +155,9 @@ void from_particle<dimension, float_type>::update()
 
     scoped_timer_type timer(runtime_.update);
 
+    update_mobile();
+    bool const skip_immobile = !mobile1_.empty();
+
     // whether Newton's third law applies
     bool const reactio = (particle1_ == particle2_);
 
@@ -120,6 +170,11 @@ void from_particle<dimension, float_type>::update()
         (*neighbour)[i].clear();
 
         for (size_type j = reactio ? (i + 1) : 0; j < nparticle2; ++j) {
+            // skip pair of immobile particles
+            if (skip_immobile && !mobile1_[i] && !mobile2_[j]) {
+                continue;
+            }
+
             // load second particle
             vector_type r2 = position2[j];
             species_type type2 = species2[j];
@@ -169,6 +224,15 @@ void from_particle<dimension, float_type>::luaopen(lua_State* L)
                         , double
                         , std::shared_ptr<logger>
                   >)
+              , def("from_particle", &std::make_shared<from_particle
+                        , std::pair<std::shared_ptr<particle_type const>, std::shared_ptr<particle_type const>>
+                        , std::pair<std::shared_ptr<displacement_type>, std::shared_ptr<displacement_type>>
+                        , std::shared_ptr<box_type const>
+                        , matrix_type const&
+                        , double
+                        , std::pair<std::shared_ptr<particle_group_type>, std::shared_ptr<particle_group_type>>
+                        , std::shared_ptr<logger>
+                  >)
             ]
         ]
     ];
@@ -22,7 +22,6 @@
 
 #include <halmd/config.hpp>
 
-#include <halmd/algorithm/host/permute.hpp>
 #include <halmd/io/logger.hpp>
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/mdsim/host/velocity.hpp>
@@ -57,11 +56,15 @@ particle<dimension, float_type>::particle(size_type nparticle, unsigned int nspe
   , force_(nparticle)
   , en_pot_(nparticle)
   , stress_pot_(nparticle)
+  , en_pot_sum_(0)
+  , stress_pot_sum_(0)
   // enable auxiliary variables by default to allow sampling of initial state
   , force_zero_(true)
   , force_dirty_(true)
   , aux_dirty_(true)
   , aux_enabled_(true)
+  , aux_sum_dirty_(true)
+  , aux_sum_enabled_(false)
 {
     auto position = make_cache_mutable(position_);
     auto image = make_cache_mutable(image_);
@@ -96,6 +99,13 @@ void particle<dimension, float_type>::aux_enable()
     aux_enabled_ = true;
 }
 
+template <int dimension, typename float_type>
+void particle<dimension, float_type>::aux_sum_enable()
+{
+    LOG_TRACE("enable computation of sums of auxiliary variables");
+    aux_sum_enabled_ = true;
+}
+
 /**
  * Rearrange particles in memory according to an integer index sequence
  *
@@ -104,8 +114,32 @@ void particle<dimension, float_type>::aux_enable()
 template <int dimension, typename float_type>
 void particle<dimension, float_type>::rearrange(std::vector<unsigned int> const& index)
 {
+    if (index.size() != nparticle_) {
+        throw std::invalid_argument("index sequence size not equal to number of particles");
+    }
+
+    // ask force modules whether force/aux cache is dirty, unless the
+    // rearrangement is triggered during the computation of the force
+    if (!force_dirty_) {
+        on_prepend_force_();
+    }
+    bool const force_valid = !force_dirty_;
+
     scoped_timer_type timer(runtime_.rearrange);
 
+    if (scratch_.position.size() != nparticle_) {
+        LOG_DEBUG("allocate scratch buffers for rearrangement of particles");
+        scratch_.position = position_array_type(nparticle_);
+        scratch_.image = image_array_type(nparticle_);
+        scratch_.velocity = velocity_array_type(nparticle_);
+        scratch_.tag = tag_array_type(nparticle_);
+        scratch_.species = species_array_type(nparticle_);
+        scratch_.mass = mass_array_type(nparticle_);
+        scratch_.force = force_array_type(nparticle_);
+        scratch_.en_pot = en_pot_array_type(nparticle_);
+        scratch_.stress_pot = stress_pot_array_type(nparticle_);
+    }
+
     auto position = make_cache_mutable(position_);
     auto image = make_cache_mutable(image_);
     auto velocity = make_cache_mutable(velocity_);
@@ -113,34 +147,64 @@ void particle<dimension, float_type>::rearrange(std::vector<unsigned int> const&
     auto reverse_tag = make_cache_mutable(reverse_tag_);
     auto species = make_cache_mutable(species_);
     auto mass = make_cache_mutable(mass_);
+    auto force = make_cache_mutable(force_);
+    auto en_pot = make_cache_mutable(en_pot_);
+    auto stress_pot = make_cache_mutable(stress_pot_);
 
-    permute(position->begin(), position->end(), index.begin());
-    permute(image->begin(), image->end(), index.begin());
-    permute(velocity->begin(), velocity->end(), index.begin());
-    permute(tag->begin(), tag->end(), index.begin());
-    permute(species->begin(), species->end(), index.begin());
-    permute(mass->begin(), mass->end(), index.begin());
-    // no permutation of forces
-
-    // update reverse tags
-    for (unsigned int i = 0; i < nparticle_; ++i) {
-        (*reverse_tag)[(*tag)[i]] = i;
+    // gather all particle arrays in a single pass, and update reverse tags
+    long const nparticle = nparticle_;
+#pragma omp parallel for
+    for (long i = 0; i < nparticle; ++i) {
+        unsigned int const j = index[i];
+        scratch_.position[i] = (*position)[j];
+        scratch_.image[i] = (*image)[j];
+        scratch_.velocity[i] = (*velocity)[j];
+        scratch_.species[i] = (*species)[j];
+        scratch_.mass[i] = (*mass)[j];
+        scratch_.force[i] = (*force)[j];
+        scratch_.en_pot[i] = (*en_pot)[j];
+        scratch_.stress_pot[i] = (*stress_pot)[j];
+        tag_type const t = (*tag)[j];
+        scratch_.tag[i] = t;
+        (*reverse_tag)[t] = i;
+    }
+
+    position->swap(scratch_.position);
+    image->swap(scratch_.image);
+    velocity->swap(scratch_.velocity);
+    tag->swap(scratch_.tag);
+    species->swap(scratch_.species);
+    mass->swap(scratch_.mass);
+    force->swap(scratch_.force);
+    en_pot->swap(scratch_.en_pot);
+    stress_pot->swap(scratch_.stress_pot);
+
+    // the force was permuted along with the positions
+    if (force_valid) {
+        on_rearrange_();
     }
 }
 
 template <int dimension, typename float_type>
-void particle<dimension, float_type>::update_force_(bool with_aux)
+void particle<dimension, float_type>::update_force_(bool with_aux, bool sum_only)
 {
     on_prepend_force_();          // ask force modules whether force/aux cache is dirty
 
-    if (force_dirty_ || (with_aux && aux_dirty_)) {
-        if (with_aux && aux_dirty_) {
+    bool const aux_dirty = sum_only ? aux_sum_dirty_ : aux_dirty_;
+    if (force_dirty_ || (with_aux && aux_dirty)) {
+        if (with_aux && aux_dirty) {
             if (!force_dirty_) {
                 LOG_WARNING_ONCE("auxiliary variables inactive in prior force computation, use aux_enable()");
             }
-            aux_enabled_ = true;  // turn on computation of aux variables
+            // turn on computation of aux variables or of their sums
+            if (sum_only) {
+                aux_sum_enabled_ = true;
+            }
+            else {
+                aux_enabled_ = true;
+            }
         }
-        LOG_TRACE("request force" << (aux_enabled_ ? " and auxiliary variables" : ""));
+        LOG_TRACE("request force" << (aux_enabled_ ? " and auxiliary variables" : aux_sum_enabled_ ? " and sums of auxiliary variables" : ""));
 
         force_zero_ = true;       // tell first force module to reset the force
         on_force_();              // compute forces
@@ -148,7 +212,11 @@ void particle<dimension, float_type>::update_force_(bool with_aux)
         if (aux_enabled_) {
             aux_dirty_ = false;   // aux cache is clean only if requested
         }
+        if (aux_enabled_ || aux_sum_enabled_) {
+            aux_sum_dirty_ = false;
+        }
         aux_enabled_ = false;     // disable aux variables for next call
+        aux_sum_enabled_ = false;
     }
     on_append_force_();
 }
@@ -419,9 +487,11 @@ void particle<dimension, float_type>::luaopen(lua_State* L)
                     .def("shift_rescale_velocity_group", &shift_rescale_velocity_group<particle>)
                     .property("dimension", &wrap_dimension<dimension, float_type>)
                     .def("aux_enable", &particle::aux_enable)
+                    .def("aux_sum_enable", &particle::aux_sum_enable)
                     .def("on_prepend_force", &particle::on_prepend_force)
                     .def("on_force", &particle::on_force)
                     .def("on_append_force", &particle::on_append_force)
+                    .def("on_rearrange", &particle::on_rearrange)
                     .def("__eq", &equal<particle>) // operator= in Lua
                     .scope[
                         class_<runtime>("runtime")
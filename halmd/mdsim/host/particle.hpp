@@ -57,6 +57,8 @@ public:
     typedef fixed_vector<float_type, dimension> force_type;
     typedef double en_pot_type;
     typedef typename type_traits<dimension, float_type>::stress_tensor_type stress_pot_type;
+    typedef double en_pot_sum_type;
+    typedef typename type_traits<dimension, double>::stress_tensor_type stress_pot_sum_type;
 
     typedef raw_array<position_type> position_array_type;
     typedef raw_array<image_type> image_array_type;
@@ -69,6 +71,15 @@ public:
     typedef raw_array<en_pot_type> en_pot_array_type;
     typedef raw_array<stress_pot_type> stress_pot_array_type;
 
+    /**
+     * Rearrange particles in memory according to an integer index sequence.
+     *
+     * All particle arrays, including the force and the auxiliary variables,
+     * are gathered in a single pass through scratch buffers, which are
+     * allocated with the first call and kept for subsequent calls. If the
+     * force was up to date before the rearrangement, the force modules are
+     * notified via on_rearrange() to keep their caches valid.
+     */
     void rearrange(std::vector<unsigned int> const& index);
 
     /**
@@ -265,6 +276,42 @@ public:
         return stress_pot_;
     }
 
+    /**
+     * Returns const reference to potential energy summed over all particles.
+     */
+    cache<en_pot_sum_type> const& potential_energy_sum()
+    {
+        update_force_(true, true);
+        return en_pot_sum_;
+    }
+
+    /**
+     * Returns non-const reference to potential energy summed over all particles.
+     */
+    cache<en_pot_sum_type>& mutable_potential_energy_sum()
+    {
+        return en_pot_sum_;
+    }
+
+    /**
+     * Returns const reference to potential part of stress tensor summed over
+     * all particles.
+     */
+    cache<stress_pot_sum_type> const& stress_pot_sum()
+    {
+        update_force_(true, true);
+        return stress_pot_sum_;
+    }
+
+    /**
+     * Returns non-const reference to potential part of stress tensor summed
+     * over all particles.
+     */
+    cache<stress_pot_sum_type>& mutable_stress_pot_sum()
+    {
+        return stress_pot_sum_;
+    }
+
     /**
      * Enable computation of auxiliary variables.
      *
@@ -280,6 +327,23 @@ public:
         return aux_enabled_;
     }
 
+    /**
+     * Enable computation of the sums of the auxiliary variables over all
+     * particles, without the per-particle arrays.
+     *
+     * The flag is reset after the next trigger of on_force_().
+     */
+    void aux_sum_enable();
+
+    /**
+     * Returns true if computation of the sums of auxiliary variables is
+     * enabled.
+     */
+    bool aux_sum_enabled() const
+    {
+        return aux_sum_enabled_;
+    }
+
     /**
      * Returns true if the force has to be reset to zero prior to reading.
      */
@@ -315,6 +379,32 @@ public:
         aux_dirty_ = true;
     }
 
+    /**
+     * Returns true if the caches of the auxiliary variables are dirty.
+     */
+    bool aux_dirty() const
+    {
+        return aux_dirty_;
+    }
+
+    /**
+     * Indicate that an update of the sums of the auxiliary variables (ie.
+     * triggering on_force_() with aux_enabled or aux_sum_enabled) is required
+     */
+    void mark_aux_sum_dirty()
+    {
+        aux_sum_dirty_ = true;
+    }
+
+    /**
+     * Returns true if the caches of the sums of the auxiliary variables are
+     * dirty.
+     */
+    bool aux_sum_dirty() const
+    {
+        return aux_sum_dirty_;
+    }
+
     connection on_prepend_force(slot_function_type const& slot)
     {
         return on_prepend_force_.connect(slot);
@@ -330,6 +420,15 @@ public:
         return on_append_force_.connect(slot);
     }
 
+    /**
+     * Connect slot to signal emitted after a rearrangement of the particles
+     * that preserved an up-to-date force.
+     */
+    connection on_rearrange(slot_function_type const& slot)
+    {
+        return on_rearrange_.connect(slot);
+    }
+
     /**
      * Bind class to Lua.
      */
@@ -360,6 +459,10 @@ private:
     cache<en_pot_array_type> en_pot_;
     /** potential part of stress tensor for each particle */
     cache<stress_pot_array_type> stress_pot_;
+    /** potential energy summed over all particles */
+    cache<en_pot_sum_type> en_pot_sum_;
+    /** potential part of stress tensor summed over all particles */
+    cache<stress_pot_sum_type> stress_pot_sum_;
 
     /** flag that the force has to be reset to zero prior to reading */
     bool force_zero_;
@@ -369,11 +472,17 @@ private:
     bool aux_dirty_;
     /** flag that the computation of auxiliary variables is requested */
     bool aux_enabled_;
+    /** flag that the caches of the sums of auxiliary variables are dirty */
+    bool aux_sum_dirty_;
+    /** flag that the computation of only the sums of auxiliary variables is requested */
+    bool aux_sum_enabled_;
 
     /**
      * Update all forces and auxiliary variables if needed. The auxiliary
      * variables are guaranteed to be up-to-date upon return if with_aux was
-     * set to true.
+     * set to true. If sum_only is set to true in addition, only the sums of
+     * the auxiliary variables over all particles are guaranteed to be
+     * up-to-date.
      *
      * Auxiliary variables are computed only if they are out of date
      * (aux_dirty_ == true) and if either with_aux or aux_enabled_ is true.
@@ -381,7 +490,7 @@ private:
      * Emit a warning if the force update would be necessary solely to compute
      * the auxiliary variables, which indicates a performance problem.
      */
-    void update_force_(bool with_aux=false);
+    void update_force_(bool with_aux=false, bool sum_only=false);
 
     typedef utility::profiler::accumulator_type accumulator_type;
     typedef utility::profiler::scoped_timer_type scoped_timer_type;
@@ -394,9 +503,27 @@ private:
     /** profiling runtime accumulators */
     runtime runtime_;
 
+    /** scratch buffers for rearrangement of particle arrays */
+    struct scratch
+    {
+        position_array_type position;
+        image_array_type image;
+        velocity_array_type velocity;
+        tag_array_type tag;
+        species_array_type species;
+        mass_array_type mass;
+        force_array_type force;
+        en_pot_array_type en_pot;
+        stress_pot_array_type stress_pot;
+    };
+
+    /** scratch buffers, allocated upon first rearrangement */
+    scratch scratch_;
+
     signal_type on_prepend_force_;
     signal_type on_force_;
     signal_type on_append_force_;
+    signal_type on_rearrange_;
 };
 
 /**
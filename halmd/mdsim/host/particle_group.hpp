@@ -93,6 +93,22 @@ get_unordered(particle_group& group, iterator_type const& first)
     return std::copy(unordered.begin(), unordered.end(), first);
 }
 
+/**
+ * Mark the particles of a group in a mask over all particle indices.
+ *
+ * The mask must have the size of the particle array.
+ */
+template <typename mask_type>
+inline void
+get_mask(particle_group& group, mask_type& mask)
+{
+    auto const& unordered = read_cache(group.unordered());
+    std::fill(mask.begin(), mask.end(), false);
+    for (particle_group::size_type i : unordered) {
+        mask[i] = true;
+    }
+}
+
 /**
  * Compute mean kinetic energy per particle.
  */
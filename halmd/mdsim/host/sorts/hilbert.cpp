@@ -19,11 +19,14 @@
  */
 
 #include <algorithm>
-#include <boost/bind.hpp>
 #include <cmath>
+#include <numeric>
+#include <stdexcept>
 
+#include <halmd/algorithm/host/radix_sort.hpp>
 #include <halmd/mdsim/host/sorts/hilbert.hpp>
 #include <halmd/mdsim/sorts/hilbert_kernel.hpp>
+#include <halmd/mdsim/sorts/morton_kernel.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
 namespace halmd {
@@ -36,77 +39,130 @@ hilbert<dimension, float_type>::hilbert(
     std::shared_ptr<particle_type> particle
   , std::shared_ptr<box_type const> box
   , std::shared_ptr<binning_type> binning
+  , double threshold
+  , curve order_curve
   , std::shared_ptr<logger> logger
 )
   // dependency injection
   : particle_(particle)
   , box_(box)
   , binning_(binning)
+  , threshold_(threshold)
+  , rank_next_(particle_->nparticle())
   , logger_(logger)
 {
+    if (threshold_ < 0 || threshold_ > 1) {
+        throw std::invalid_argument("Hilbert sort: threshold must be within [0, 1]");
+    }
+    if (order_curve != hilbert_curve && order_curve != morton_curve) {
+        throw std::invalid_argument("Hilbert sort: unsupported space-filling curve");
+    }
+
     cell_size_type const& ncell = binning_->ncell();
     vector_type const& cell_length = binning_->cell_length();
-    cell_array_type const& cell = read_cache(binning_->cell());
 
     // set Hilbert space-filling curve recursion depth
     unsigned int ncell_max = *std::max_element(ncell.begin(), ncell.end());
     unsigned int depth = static_cast<int>(std::ceil(std::log(static_cast<double>(ncell_max)) / M_LN2));
-    // 32-bit integer for 2D Hilbert code allows a maximum of 16/10 levels
-    depth = std::min((dimension == 3) ? 10U : 16U, depth);
-
-    LOG("vertex recursion depth: " << depth);
-
-    // generate 1-dimensional Hilbert curve mapping of cell lists
-    typedef std::pair<cell_list const*, unsigned int> pair;
-    std::vector<pair> pairs;
-    cell_size_type x;
-    for (x[0] = 0; x[0] < ncell[0]; ++x[0]) {
-        for (x[1] = 0; x[1] < ncell[1]; ++x[1]) {
-            if (dimension == 3) {
-                for (x[2] = 0; x[2] < ncell[2]; ++x[2]) {
-                    vector_type r(x);
-                    r = element_prod(r + vector_type(0.5), cell_length);
-                    pairs.push_back(std::make_pair(&cell(x), map(r, depth)));
-                }
-            }
-            else {
-                vector_type r(x);
-                r = element_prod(r + vector_type(0.5), cell_length);
-                pairs.push_back(std::make_pair(&cell(x), map(r, depth)));
-            }
+    if (order_curve == hilbert_curve) {
+        // 32-bit integer for 2D Hilbert code allows a maximum of 16/10 levels
+        depth = std::min((dimension == 3) ? 10U : 16U, depth);
+        LOG("vertex recursion depth: " << depth);
+    }
+    else {
+        // 64-bit integer for Morton code allows a maximum of 32/21 levels
+        if (depth > ((dimension == 3) ? 21U : 32U)) {
+            throw std::invalid_argument("Hilbert sort: too many cells for Morton curve");
         }
+        LOG("order cells along Morton curve with " << depth << " levels");
+    }
+    if (threshold_ > 0) {
+        LOG("reorder if fraction of particles that changed their cell exceeds " << threshold_);
+    }
+
+    // generate 1-dimensional curve code of cells in storage order of binning
+    std::vector<std::pair<unsigned long long, unsigned int>> code;
+    cell_size_type x(0);
+    for (unsigned int k = 0; ; ++k) {
+        if (order_curve == hilbert_curve) {
+            vector_type r(x);
+            r = element_prod(r + vector_type(0.5), cell_length);
+            code.push_back(std::make_pair(map(r, depth), k));
+        }
+        else {
+            code.push_back(std::make_pair(mdsim::sorts::morton_kernel::map(x), k));
+        }
+        // advance multi-dimensional index with last dimension running fastest
+        int j = dimension - 1;
+        while (j >= 0 && ++x[j] == ncell[j]) {
+            x[j--] = 0;
+        }
+        if (j < 0) {
+            break;
+        }
+    }
+    // ties are resolved by the storage order of the cells
+    std::sort(code.begin(), code.end());
+    cell_rank_.resize(code.size());
+    for (unsigned int k = 0; k < code.size(); ++k) {
+        cell_rank_[code[k].second] = k;
     }
-    stable_sort(pairs.begin(), pairs.end(), bind(&pair::second, _1) < bind(&pair::second, _2));
-    map_.clear();
-    map_.reserve(cell.size());
-    transform(pairs.begin(), pairs.end(), back_inserter(map_), bind(&pair::first, _1));
 }
 
 /**
- * Order particles after Hilbert space-filling curve
+ * Order particles after space-filling curve
+ *
+ * The particles are assigned the rank of their cell along the curve, using
+ * the same cell mapping as the binning module, and are ordered by a stable
+ * radix sort over the cell ranks. Between two sorts, most particles remain
+ * in their cell. If the fraction of particles that changed their cell does
+ * not exceed the threshold, the particles are not reordered at all.
  */
 template <int dimension, typename float_type>
 void hilbert<dimension, float_type>::order()
 {
-    LOG_TRACE("order particles after Hilbert space-filling curve");
+    LOG_TRACE("order particles after space-filling curve");
     {
         scoped_timer_type timer(runtime_.order);
-        std::vector<unsigned int> index;
+        unsigned int const nparticle = particle_->nparticle();
+        std::vector<unsigned int> index(nparticle);
         {
             scoped_timer_type timer(runtime_.map);
-            // particle binning
-            binning_->cell();
-            // generate index sequence according to Hilbert-sorted cells
-            index.reserve(particle_->nparticle());
-            for (cell_list const* cell : map_) {
-                for (unsigned int p : *cell) {
-                    index.push_back(p);
-                }
+            // assign curve rank of cell to each particle
+            position_array_type const& position = read_cache(particle_->position());
+#pragma omp parallel for
+            for (long i = 0; i < long(nparticle); ++i) {
+                rank_next_[i] = cell_rank_[binning_->cell_index(position[i])];
+            }
+
+            // ranks are invalid if particles were reordered by other means
+            cache<reverse_tag_array_type> const& reverse_tag_cache = particle_->reverse_tag();
+            if (rank_cache_ != reverse_tag_cache) {
+                rank_.assign(nparticle, -1U);
+            }
+
+            // count particles that changed their cell since the last sort
+            unsigned int moved = 0;
+#pragma omp parallel for reduction(+:moved)
+            for (long i = 0; i < long(nparticle); ++i) {
+                moved += (rank_next_[i] != rank_[i]);
             }
+            if (moved <= threshold_ * nparticle) {
+                LOG_TRACE("skip reordering of particles, " << moved << " particles changed their cell");
+                return;
+            }
+            LOG_TRACE(moved << " particles changed their cell");
+
+            // sort particles by cell rank, preserving the order of particles
+            // within a cell, which yields the ranks in the new order
+            std::copy(rank_next_.begin(), rank_next_.end(), rank_.begin());
+            std::iota(index.begin(), index.end(), 0);
+            radix_sort(rank_.begin(), rank_.end(), index.begin());
         }
 
         // reorder particles in memory
         particle_->rearrange(index);
+        rank_cache_ = particle_->reverse_tag();
     }
     on_order_();
 }
@@ -144,6 +200,7 @@ void hilbert<dimension, float_type>::luaopen(lua_State* L)
                 class_<hilbert>()
                     .property("order", &wrap_order<hilbert>)
                     .def("on_order", &hilbert::on_order)
+                    .property("threshold", &hilbert::threshold)
                     .scope
                     [
                         class_<runtime>("runtime")
@@ -155,6 +212,8 @@ void hilbert<dimension, float_type>::luaopen(lua_State* L)
                   , std::shared_ptr<particle_type>
                   , std::shared_ptr<box_type const>
                   , std::shared_ptr<binning_type>
+                  , double
+                  , curve
                   , std::shared_ptr<logger>
                 >)
             ]
@@ -45,16 +45,38 @@ public:
     typedef mdsim::box<dimension> box_type;
     typedef host::binning<dimension, float_type> binning_type;
 
+    /** space-filling curve that determines the order of the cells */
+    enum curve
+    {
+        hilbert_curve = 1
+      , morton_curve  = 2
+    };
+
     static void luaopen(lua_State* L);
 
+    /**
+     * Construct Hilbert sort module.
+     *
+     * @param threshold fraction of particles that have to change their cell
+     *   since the last sort before the particles are reordered again
+     * @param order_curve space-filling curve along which the cells are ordered
+     */
     hilbert(
         std::shared_ptr<particle_type> particle
       , std::shared_ptr<box_type const> box
       , std::shared_ptr<binning_type> binning
+      , double threshold = 0
+      , curve order_curve = hilbert_curve
       , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
     );
     void order();
 
+    //! returns minimal fraction of moved particles that triggers a reordering
+    double threshold() const
+    {
+        return threshold_;
+    }
+
     connection on_order(std::function<void ()> const& slot)
     {
         return on_order_.connect(slot);
@@ -62,8 +84,8 @@ public:
 
 private:
     typedef typename binning_type::cell_size_type cell_size_type;
-    typedef typename binning_type::cell_list cell_list;
-    typedef typename binning_type::array_type cell_array_type;
+    typedef typename particle_type::position_array_type position_array_type;
+    typedef typename particle_type::reverse_tag_array_type reverse_tag_array_type;
     typedef utility::profiler::scoped_timer_type scoped_timer_type;
 
     struct runtime
@@ -78,8 +100,16 @@ private:
     std::shared_ptr<box_type const> box_;
     std::shared_ptr<binning_type> binning_;
 
-    /** 1-dimensional Hilbert curve mapping of cell lists */
-    std::vector<cell_list const*> map_;
+    /** rank of each cell along the space-filling curve, by linear cell index */
+    std::vector<unsigned int> cell_rank_;
+    /** minimal fraction of moved particles that triggers a reordering */
+    double threshold_;
+    /** curve rank of particle cells at the last reordering */
+    std::vector<unsigned int> rank_;
+    /** current curve rank of particle cells */
+    std::vector<unsigned int> rank_next_;
+    /** cache observer of particle reverse tags at the last reordering */
+    cache<> rank_cache_;
     /** signal emitted after particle ordering */
     signal<void ()> on_order_;
     /** module logger */
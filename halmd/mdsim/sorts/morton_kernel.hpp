@@ -0,0 +1,107 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_MDSIM_SORTS_MORTON_KERNEL_HPP
+#define HALMD_MDSIM_SORTS_MORTON_KERNEL_HPP
+
+#include <boost/mpl/equal_to.hpp>
+#include <boost/mpl/int.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <halmd/config.hpp>
+
+namespace halmd {
+namespace mdsim {
+namespace sorts {
+namespace morton_kernel {
+namespace detail {
+
+/**
+ * Insert two zero bits after each of the lower 21 bits
+ */
+inline HALMD_GPU_ENABLED unsigned long long spread3(unsigned long long x)
+{
+    x &= 0x1fffffULL;
+    x = (x | x << 32) & 0x1f00000000ffffULL;
+    x = (x | x << 16) & 0x1f0000ff0000ffULL;
+    x = (x | x << 8)  & 0x100f00f00f00f00fULL;
+    x = (x | x << 4)  & 0x10c30c30c30c30c3ULL;
+    x = (x | x << 2)  & 0x1249249249249249ULL;
+    return x;
+}
+
+/**
+ * Insert a zero bit after each of the lower 32 bits
+ */
+inline HALMD_GPU_ENABLED unsigned long long spread2(unsigned long long x)
+{
+    x &= 0xffffffffULL;
+    x = (x | x << 16) & 0x0000ffff0000ffffULL;
+    x = (x | x << 8)  & 0x00ff00ff00ff00ffULL;
+    x = (x | x << 4)  & 0x0f0f0f0f0f0f0f0fULL;
+    x = (x | x << 2)  & 0x3333333333333333ULL;
+    x = (x | x << 1)  & 0x5555555555555555ULL;
+    return x;
+}
+
+} // namespace detail
+
+/**
+ * Map 3-dimensional integer point to 1-dimensional point on Morton curve
+ *
+ * The Morton (or Z-order) code is obtained by interleaving the bits of the
+ * coordinates. Unlike the Hilbert code it requires no recursion, and a
+ * 64-bit integer allows a maximum of 21 levels.
+ */
+template <typename index_type>
+HALMD_GPU_ENABLED
+typename boost::enable_if<
+    boost::mpl::equal_to<
+        boost::mpl::int_<index_type::static_size>
+      , boost::mpl::int_<3>
+    >
+  , unsigned long long>::type map(index_type const& x)
+{
+    return detail::spread3(x[0]) | detail::spread3(x[1]) << 1 | detail::spread3(x[2]) << 2;
+}
+
+/**
+ * Map 2-dimensional integer point to 1-dimensional point on Morton curve
+ *
+ * A 64-bit integer for the 2D Morton code allows a maximum of 32 levels.
+ */
+template <typename index_type>
+HALMD_GPU_ENABLED
+typename boost::enable_if<
+    boost::mpl::equal_to<
+        boost::mpl::int_<index_type::static_size>
+      , boost::mpl::int_<2>
+    >
+  , unsigned long long>::type map(index_type const& x)
+{
+    return detail::spread2(x[0]) | detail::spread2(x[1]) << 1;
+}
+
+} // namespace morton_kernel
+} // namespace sorts
+} // namespace mdsim
+} // namespace halmd
+
+#endif /* ! HALMD_MDSIM_SORTS_MORTON_KERNEL_HPP */
@@ -73,6 +73,12 @@ public:
     HALMD_GPU_ENABLED accumulator()
       : n_(0), m_(0), v_(0) {}
 
+    /**
+     * initialize accumulator from count, mean, and variance × count
+     */
+    HALMD_GPU_ENABLED accumulator(size_type n, T const& m, T const& v)
+      : n_(n), m_(m), v_(v) {}
+
     /**
      * copy accumulator
      */
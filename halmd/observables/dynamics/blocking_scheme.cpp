@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <cassert>
 #include <exception>
+#include <tuple>
 
 #include <halmd/observables/dynamics/blocking_scheme.hpp>
 #include <halmd/utility/lua/lua.hpp>
@@ -131,6 +132,7 @@ void blocking_scheme::sample()
     step_type const step = clock_->step();
 
     // iterate over all coarse-graining levels
+    std::vector<unsigned int> levels;
     for (unsigned int i = 0; i < interval_.size(); ++i) {
         if ((step - origin_[i]) % interval_[i] == 0 && step >= origin_[i]) {
             // append current sample to block at level 'i' for each sample type
@@ -144,48 +146,92 @@ void blocking_scheme::sample()
             // Checking the first blocking scheme only is sufficient,
             // since all of them are modified synchronously
             if (!block_sample_.empty() && (*block_sample_.begin())->full(i)) {
-                process(i);
+                levels.push_back(i);
             }
         }
     }
+    // the levels are independent of each other, process them together
+    process(levels);
     on_append_sample_();
 }
 
 void blocking_scheme::finalise()
 {
     on_prepend_finalise_();
-    // iterate over all coarse-graining levels
-    for (unsigned int i = 0; i < interval_.size(); ++i) {
-        // process remaining data at level 'i'
-        while (!block_sample_.empty() && !(*block_sample_.begin())->empty(i)) {
-            process(i);
+    // process remaining data of all coarse-graining levels
+    std::vector<unsigned int> levels;
+    do {
+        levels.clear();
+        for (unsigned int i = 0; i < interval_.size(); ++i) {
+            if (!block_sample_.empty() && !(*block_sample_.begin())->empty(i)) {
+                levels.push_back(i);
+            }
         }
-    }
+        process(levels);
+    } while (!levels.empty());
     on_append_finalise_();
 }
 
-void blocking_scheme::process(unsigned int level)
+void blocking_scheme::process(std::vector<unsigned int> const& levels)
 {
-    // call all registered correlation modules
-    // and correlate block data with first entry
-    LOG_TRACE("compute correlations at blocking level " << level << " from step " << origin_[level]);
+    if (levels.empty()) {
+        return;
+    }
+
+    // call all registered correlation modules and correlate block data with
+    // first entry, correlation functions that permit concurrent calls are
+    // evaluated as parallel tasks over correlation functions, levels, and
+    // block entries, the others are evaluated sequentially
+    std::vector<std::tuple<correlation_base*, unsigned int, unsigned int>> task;
     for (std::shared_ptr<correlation_base> tcf : tcf_) {
-        tcf->compute(level);
+        for (unsigned int level : levels) {
+            LOG_TRACE("compute correlations at blocking level " << level << " from step " << origin_[level]);
+            if (tcf->concurrent()) {
+                unsigned int size = (*block_sample_.begin())->size(level);
+                for (unsigned int index = 0; index < size; ++index) {
+                    task.emplace_back(tcf.get(), level, index);
+                }
+            }
+            else {
+                tcf->compute(level);
+            }
+        }
+    }
+    // an exception must not leave the parallel region, the first one is
+    // rethrown after all tasks have completed
+    long const ntask = task.size();
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic)
+    for (long i = 0; i < ntask; ++i) {
+        try {
+            get<0>(task[i])->compute(get<1>(task[i]), get<2>(task[i]));
+        }
+        catch (...) {
+#pragma omp critical (blocking_scheme_error)
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
     }
 
-    // update time origin for next computation at this level
-    //
-    // make sure that the new origin is a multiple of this level's sampling interval
-    // and at least incremented by one interval
-    unsigned int skip = max((separation_ + interval_[level] - 1) / interval_[level], step_type(1));
-    origin_[level] += skip * interval_[level];
-
-    // for each block structure, discard all entries earlier
-    // than the new time origin at this level
-    LOG_TRACE("discard first " << skip << " entries at level " << level);
-    for (std::shared_ptr<block_sample_type> block_sample : block_sample_) {
-        for (unsigned int k = 0; k < skip && !block_sample->empty(level); ++k) {
-            block_sample->pop_front(level);
+    for (unsigned int level : levels) {
+        // update time origin for next computation at this level
+        //
+        // make sure that the new origin is a multiple of this level's sampling interval
+        // and at least incremented by one interval
+        unsigned int skip = max((separation_ + interval_[level] - 1) / interval_[level], step_type(1));
+        origin_[level] += skip * interval_[level];
+
+        // for each block structure, discard all entries earlier
+        // than the new time origin at this level
+        LOG_TRACE("discard first " << skip << " entries at level " << level);
+        for (std::shared_ptr<block_sample_type> block_sample : block_sample_) {
+            for (unsigned int k = 0; k < skip && !block_sample->empty(level); ++k) {
+                block_sample->pop_front(level);
+            }
         }
     }
 }
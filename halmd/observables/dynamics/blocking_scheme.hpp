@@ -24,6 +24,7 @@
 #include <boost/multi_array.hpp>
 #include <lua.hpp>
 #include <memory>
+#include <vector>
 
 #include <halmd/io/logger.hpp>
 #include <halmd/mdsim/clock.hpp>
@@ -124,8 +125,8 @@ public:
     static void luaopen(lua_State* L);
 
 private:
-    /** compute correlations and discard first entry */
-    void process(unsigned int level);
+    /** compute correlations at the given levels and discard first entries */
+    void process(std::vector<unsigned int> const& levels);
 
      /** simulation clock */
     std::shared_ptr<clock_type const> clock_;
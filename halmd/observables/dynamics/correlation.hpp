@@ -51,6 +51,15 @@ public:
 
     /** compute correlations at the given coarse-graining level */
     virtual void compute(unsigned int level) = 0;
+
+    /** correlate first entry with given entry of block at coarse-graining level */
+    virtual void compute(unsigned int level, unsigned int index) = 0;
+
+    /**
+     * Returns true if compute(level, index) may be called concurrently for
+     * distinct pairs of level and index.
+     */
+    virtual bool concurrent() const = 0;
 };
 
 namespace detail {
@@ -76,6 +85,28 @@ constexpr int get_rank()
     return get_rank_impl<T>(0); // 0 is of type 'int' which takes precedence over 'long'
 }
 
+/**
+ * determine whether generic TCF functor is safe to be called concurrently
+ * for distinct outputs, or provide a default
+ */
+template <typename T>
+constexpr auto get_concurrent_impl(int) -> decltype(bool(T::concurrent))
+{
+    return T::concurrent;
+}
+
+template <typename T>
+constexpr bool get_concurrent_impl(long)
+{
+    return false;
+}
+
+template <typename T>
+constexpr bool get_concurrent()
+{
+    return get_concurrent_impl<T>(0); // 0 is of type 'int' which takes precedence over 'long'
+}
+
 /**
  * call result_shape() of generic TCF functor or provide a default
  */
@@ -125,6 +156,13 @@ public:
 
     virtual void compute(unsigned int level);
 
+    virtual void compute(unsigned int level, unsigned int index);
+
+    virtual bool concurrent() const
+    {
+        return detail::get_concurrent<tcf_type>();
+    }
+
     block_result_type const& result() const
     {
         return result_;
@@ -141,7 +179,7 @@ public:
 
 private:
     typedef correlation_base _Base;
-    typedef halmd::utility::profiler::scoped_timer_type scoped_timer_type;
+    typedef halmd::utility::profiler::timer_type timer_type;
 
     struct runtime
     {
@@ -212,17 +250,28 @@ void correlation<tcf_type>::compute(unsigned int level)
     // iterate over block and correlate the first entry of block_sample1_ (at
     // time t1) with all entries of block_sample2_ (at t1 + n * Δt), accumulate
     // result for each lag time
-    auto out = result_[level].begin();
-    auto first = block_sample1_->index(level).begin();
-    auto const& block2 = block_sample2_->index(level);
-    for (auto second = block2.begin(); second != block2.end(); ++second) {
-        scoped_timer_type timer(runtime_.tcf);
-        // call TCF functor which correlates the two samples and stores the
-        // result in the output accumulator
-        (*tcf_)(**first, **second, *out++);
+    unsigned int size = block_sample2_->index(level).size();
+    for (unsigned int index = 0; index < size; ++index) {
+        compute(level, index);
     }
 }
 
+template <typename tcf_type>
+void correlation<tcf_type>::compute(unsigned int level, unsigned int index)
+{
+    timer_type timer;
+    auto const& first = block_sample1_->index(level).front();
+    auto const& second = block_sample2_->index(level)[index];
+    // call TCF functor which correlates the two samples and stores the
+    // result in the output accumulator
+    (*tcf_)(*first, *second, result_[level][index]);
+    double elapsed = timer.elapsed();
+
+    // the method may be called concurrently for distinct lag times
+#pragma omp critical
+    runtime_.tcf(elapsed);
+}
+
 template <typename tcf_type>
 std::function<typename correlation<tcf_type>::block_mean_type const& ()>
 correlation<tcf_type>::get_mean(std::shared_ptr<correlation<tcf_type>> self)
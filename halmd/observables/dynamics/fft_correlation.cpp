@@ -0,0 +1,413 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <exception>
+#include <new>
+
+#include <halmd/observables/dynamics/fft_correlation.hpp>
+#include <halmd/utility/lua/lua.hpp>
+
+using namespace std;
+
+namespace halmd {
+namespace observables {
+namespace dynamics {
+
+/**
+ * Returns smallest power of 2 not less than n.
+ */
+static unsigned int fft_size(unsigned int n)
+{
+    unsigned int size = 1;
+    while (size < n) {
+        size <<= 1;
+    }
+    return size;
+}
+
+fft_correlation::fft_correlation(
+    std::shared_ptr<clock_type const> clock
+  , acquire_type const& acquire
+  , double maximum_lag_time
+  , unsigned int interval
+  , unsigned int window
+  , std::shared_ptr<logger> logger
+)
+  : fft_correlation(clock, acquire, acquire_type(), maximum_lag_time, interval, window, logger) {}
+
+fft_correlation::fft_correlation(
+    std::shared_ptr<clock_type const> clock
+  , acquire_type const& acquire1
+  , acquire_type const& acquire2
+  , double maximum_lag_time
+  , unsigned int interval
+  , unsigned int window
+  , std::shared_ptr<logger> logger
+)
+  // dependency injection
+  : clock_(clock)
+  , acquire1_(acquire1)
+  , acquire2_(acquire2)
+  , interval_(interval)
+  , window_(window)
+  , logger_(logger)
+  // initialise members
+  , ncomp_(0)
+  , step_(0)
+  , timestep_(clock_->timestep())
+  , nfft_(0)
+  , real_(nullptr)
+  , spectrum1_(nullptr)
+  , spectrum2_(nullptr)
+  , cross_(nullptr)
+  , cross_sq_(nullptr)
+  , forward_(nullptr)
+  , backward_(nullptr)
+{
+    if (interval_ == 0) {
+        throw invalid_argument("sampling interval must be non-zero");
+    }
+    nlag_ = static_cast<step_type>(maximum_lag_time / (interval_ * timestep_)) + 1;
+    if (nlag_ < 2) {
+        throw invalid_argument("sampling interval exceeds maximum lag time");
+    }
+    LOG("number of lag times: " << nlag_);
+    if (window_ > 0) {
+        LOG("number of time origins per window: " << window_);
+        plan_(fft_size(window_ + nlag_ - 1));
+    }
+    else {
+        LOG("store full time series");
+    }
+
+    result_.resize(boost::extents[1][nlag_]);
+    mean_.resize(boost::extents[1][nlag_]);
+    error_.resize(boost::extents[1][nlag_]);
+    count_.resize(boost::extents[1][nlag_]);
+    time_.resize(boost::extents[1][nlag_]);
+    for (unsigned int k = 0; k < nlag_; ++k) {
+        time_[0][k] = (interval_ * k) * timestep_;
+    }
+}
+
+fft_correlation::~fft_correlation()
+{
+    release_();
+}
+
+void fft_correlation::sample()
+{
+    // check time step is same as upon construction
+    if (clock_->timestep() != timestep_) {
+        throw logic_error("FFT correlation does not allow variable time step");
+    }
+    step_type const step = clock_->step();
+    if (!series1_.empty() && step != step_ + interval_) {
+        throw logic_error("FFT correlation requires equidistant samples");
+    }
+    step_ = step;
+
+    {
+        scoped_timer_type timer(runtime_.sample);
+        append_(acquire1_(), series1_);
+        if (acquire2_) {
+            append_(acquire2_(), series2_);
+        }
+    }
+
+    if (window_ > 0 && series1_.size() == (window_ + nlag_ - 1) * ncomp_) {
+        LOG_TRACE("correlate window of " << window_ << " time origins");
+        process_(window_);
+    }
+}
+
+void fft_correlation::finalise()
+{
+    if (!series1_.empty()) {
+        unsigned int nsample = series1_.size() / ncomp_;
+        LOG_DEBUG("correlate remaining " << nsample << " samples");
+        // avoid wrap-around of the circular correlation for all time origins
+        plan_(fft_size(nsample + nlag_ - 1));
+        process_(nsample);
+    }
+}
+
+void fft_correlation::append_(std::vector<double> const& value, std::vector<double>& series)
+{
+    if (ncomp_ == 0) {
+        if (value.empty()) {
+            throw invalid_argument("samples of time series must not be empty");
+        }
+        ncomp_ = value.size();
+        LOG_DEBUG("number of components of samples: " << ncomp_);
+    }
+    if (value.size() != ncomp_) {
+        throw logic_error("samples of time series have mismatching shape");
+    }
+    series.insert(series.end(), value.begin(), value.end());
+}
+
+void fft_correlation::process_(unsigned int norigin)
+{
+    scoped_timer_type timer(runtime_.tcf);
+
+    std::vector<double> const& series2 = acquire2_ ? series2_ : series1_;
+    unsigned int const nsample = series1_.size() / ncomp_;
+    unsigned int const nspectrum = nfft_ / 2 + 1;
+    // for autocorrelations of the full stored series, the transforms coincide
+    bool const symmetric = !acquire2_ && norigin == nsample;
+
+    fill_n(&cross_[0][0], 2 * nspectrum, 0.);
+    fill_n(&cross_sq_[0][0], 2 * nspectrum, 0.);
+
+    // accumulate cross-spectra of components, a_i b_i, and of products of
+    // components, a_i a_j b_i b_j, which yield the second moments of the
+    // products of samples
+    for (unsigned int i = 0; i < ncomp_; ++i) {
+        for (int j = -1; j < int(ncomp_); ++j) {
+            if (j >= 0 && unsigned(j) < i) {
+                continue;
+            }
+            transform_(series1_, norigin, i, j, spectrum1_);
+            if (!symmetric) {
+                transform_(series2, nsample, i, j, spectrum2_);
+            }
+            fftw_complex const* spectrum2 = symmetric ? spectrum1_ : spectrum2_;
+            fftw_complex* cross = (j < 0) ? cross_ : cross_sq_;
+            // off-diagonal products occur twice
+            double weight = (j < 0 || unsigned(j) == i) ? 1 : 2;
+            for (unsigned int f = 0; f < nspectrum; ++f) {
+                double re1 = spectrum1_[f][0], im1 = spectrum1_[f][1];
+                double re2 = spectrum2[f][0], im2 = spectrum2[f][1];
+                cross[f][0] += weight * (re1 * re2 + im1 * im2);
+                cross[f][1] += weight * (re1 * im2 - im1 * re2);
+            }
+        }
+    }
+
+    // transform back to time domain, the backward transform is unnormalised
+    std::vector<double> sum(nlag_);
+    fftw_execute_dft_c2r(backward_, cross_, real_);
+    for (unsigned int k = 0; k < nlag_; ++k) {
+        sum[k] = real_[k] / nfft_;
+    }
+    fftw_execute_dft_c2r(backward_, cross_sq_, real_);
+    for (unsigned int k = 0; k < nlag_ && k < nsample; ++k) {
+        accumulator<double>::size_type n = min(norigin, nsample - k);
+        double m = sum[k] / n;
+        double v = max(real_[k] / nfft_ - sum[k] * m, 0.);
+        result_[0][k](accumulator<double>(n, m, v));
+    }
+
+    // discard time origins
+    series1_.erase(series1_.begin(), series1_.begin() + norigin * ncomp_);
+    if (acquire2_) {
+        series2_.erase(series2_.begin(), series2_.begin() + norigin * ncomp_);
+    }
+}
+
+void fft_correlation::transform_(
+    std::vector<double> const& series
+  , unsigned int nsample
+  , unsigned int i
+  , int j
+  , fftw_complex* spectrum
+)
+{
+    auto input = series.begin() + i;
+    if (j < 0) {
+        for (unsigned int t = 0; t < nsample; ++t, input += ncomp_) {
+            real_[t] = *input;
+        }
+    }
+    else {
+        for (unsigned int t = 0; t < nsample; ++t, input += ncomp_) {
+            real_[t] = input[0] * input[j - i];
+        }
+    }
+    fill(real_ + nsample, real_ + nfft_, 0.);
+    fftw_execute_dft_r2c(forward_, real_, spectrum);
+}
+
+void fft_correlation::plan_(unsigned int nfft)
+{
+    if (nfft == nfft_) {
+        return;
+    }
+    release_();
+    LOG_DEBUG("length of Fourier transforms: " << nfft);
+
+    unsigned int nspectrum = nfft / 2 + 1;
+    real_ = fftw_alloc_real(nfft);
+    spectrum1_ = fftw_alloc_complex(nspectrum);
+    spectrum2_ = fftw_alloc_complex(nspectrum);
+    cross_ = fftw_alloc_complex(nspectrum);
+    cross_sq_ = fftw_alloc_complex(nspectrum);
+    if (!real_ || !spectrum1_ || !spectrum2_ || !cross_ || !cross_sq_) {
+        release_();
+        throw bad_alloc();
+    }
+    // planning with FFTW_ESTIMATE leaves the arrays untouched and is fast,
+    // the plans are applied to further arrays of the same alignment
+    forward_ = fftw_plan_dft_r2c_1d(nfft, real_, spectrum1_, FFTW_ESTIMATE);
+    backward_ = fftw_plan_dft_c2r_1d(nfft, cross_, real_, FFTW_ESTIMATE);
+    nfft_ = nfft;
+}
+
+void fft_correlation::release_()
+{
+    if (forward_) {
+        fftw_destroy_plan(forward_);
+    }
+    if (backward_) {
+        fftw_destroy_plan(backward_);
+    }
+    fftw_free(cross_sq_);
+    fftw_free(cross_);
+    fftw_free(spectrum2_);
+    fftw_free(spectrum1_);
+    fftw_free(real_);
+    forward_ = backward_ = nullptr;
+    cross_sq_ = cross_ = spectrum2_ = spectrum1_ = nullptr;
+    real_ = nullptr;
+    nfft_ = 0;
+}
+
+std::function<fft_correlation::block_mean_type const& ()>
+fft_correlation::get_mean(std::shared_ptr<fft_correlation> self)
+{
+    return [=]() -> block_mean_type const& {
+        auto in  = self->result_.origin();
+        auto out = self->mean_.origin();
+        for (unsigned int i = 0; i < self->mean_.num_elements(); ++i) {
+            *out++ = mean(*in++);
+        }
+        return self->mean_;
+    };
+}
+
+std::function<fft_correlation::block_mean_type const& ()>
+fft_correlation::get_error(std::shared_ptr<fft_correlation> self)
+{
+    return [=]() -> block_mean_type const& {
+        auto in  = self->result_.origin();
+        auto out = self->error_.origin();
+        for (unsigned int i = 0; i < self->error_.num_elements(); ++i) {
+            *out++ = error_of_mean(*in++);
+        }
+        return self->error_;
+    };
+}
+
+std::function<fft_correlation::block_count_type const& ()>
+fft_correlation::get_count(std::shared_ptr<fft_correlation> self)
+{
+    return [=]() -> block_count_type const& {
+        auto in  = self->result_.origin();
+        auto out = self->count_.origin();
+        for (unsigned int i = 0; i < self->count_.num_elements(); ++i) {
+            *out++ = count(*in++);
+        }
+        return self->count_;
+    };
+}
+
+static std::function<void ()>
+wrap_sample(std::shared_ptr<fft_correlation> self)
+{
+    return [=]() {
+        self->sample();
+    };
+}
+
+static std::function<void ()>
+wrap_finalise(std::shared_ptr<fft_correlation> self)
+{
+    return [=]() {
+        self->finalise();
+    };
+}
+
+static std::function<fft_correlation::block_time_type const& ()>
+wrap_time(std::shared_ptr<fft_correlation> self)
+{
+    return [=]() -> fft_correlation::block_time_type const& {
+        return self->time();
+    };
+}
+
+void fft_correlation::luaopen(lua_State* L)
+{
+    using namespace luaponte;
+    module(L, "libhalmd")
+    [
+        namespace_("observables")
+        [
+            namespace_("dynamics")
+            [
+                class_<fft_correlation>()
+                    .property("sample", &wrap_sample)
+                    .property("finalise", &wrap_finalise)
+                    .property("time", &wrap_time)
+                    .property("mean", &fft_correlation::get_mean)
+                    .property("error", &fft_correlation::get_error)
+                    .property("count", &fft_correlation::get_count)
+                    .property("size", &fft_correlation::size)
+                    .property("window", &fft_correlation::window)
+                    .scope
+                    [
+                        class_<runtime>("runtime")
+                            .def_readonly("sample", &runtime::sample)
+                            .def_readonly("tcf", &runtime::tcf)
+                    ]
+                    .def_readonly("runtime", &fft_correlation::runtime_)
+
+              , def("fft_correlation", &std::make_shared<fft_correlation
+                  , std::shared_ptr<clock_type const>
+                  , acquire_type const&
+                  , double
+                  , unsigned int
+                  , unsigned int
+                  , std::shared_ptr<logger>
+                >)
+              , def("fft_correlation", &std::make_shared<fft_correlation
+                  , std::shared_ptr<clock_type const>
+                  , acquire_type const&
+                  , acquire_type const&
+                  , double
+                  , unsigned int
+                  , unsigned int
+                  , std::shared_ptr<logger>
+                >)
+            ]
+        ]
+    ];
+}
+
+HALMD_LUA_API int luaopen_libhalmd_observables_dynamics_fft_correlation(lua_State* L)
+{
+    fft_correlation::luaopen(L);
+    return 0;
+}
+
+} // namespace dynamics
+} // namespace observables
+} // namespace halmd
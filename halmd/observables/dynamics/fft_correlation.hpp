@@ -0,0 +1,240 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_OBSERVABLES_DYNAMICS_FFT_CORRELATION_HPP
+#define HALMD_OBSERVABLES_DYNAMICS_FFT_CORRELATION_HPP
+
+#include <boost/multi_array.hpp>
+#include <fftw3.h>
+#include <functional>
+#include <lua.hpp>
+#include <memory>
+#include <vector>
+
+#include <halmd/io/logger.hpp>
+#include <halmd/mdsim/clock.hpp>
+#include <halmd/numeric/accumulator.hpp>
+#include <halmd/utility/profiler.hpp>
+
+namespace halmd {
+namespace observables {
+namespace dynamics {
+
+/**
+ * Time correlation function of scalar or vector-valued time series by
+ * fast Fourier transform.
+ *
+ * The module stores equidistant samples @f$ \vec a(t_n) @f$ and @f$ \vec
+ * b(t_n) @f$ of one or two time series and computes
+ *
+ * @f$ C(k \Delta t) = \langle \vec a(t_n) \cdot \vec b(t_{n+k}) \rangle_n @f$
+ *
+ * for all lags @f$ k = 0, \dots, K - 1 @f$ using the Wiener–Khinchin theorem,
+ * at a cost of O(T log T) for T samples. All pairs of samples are taken into
+ * account, the average is over all time origins @f$ t_n @f$.
+ *
+ * If a window of W samples is given, the correlations of the first W time
+ * origins are computed as soon as W + K - 1 samples are stored, after which
+ * these W samples are discarded. Otherwise, the full series is stored and
+ * correlated upon finalise().
+ *
+ * The results are provided in the layout of correlation<>, i.e., as arrays of
+ * shape (1, K). The standard error of the mean is computed from the second
+ * moments of the products, which are obtained by correlating the products of
+ * pairs of components, @f$ a_i a_j @f$ and @f$ b_i b_j @f$. It assumes
+ * uncorrelated time origins and thus underestimates the error.
+ */
+class fft_correlation
+{
+public:
+    typedef std::function<std::vector<double> ()> acquire_type;
+    typedef mdsim::clock clock_type;
+    typedef clock_type::step_type step_type;
+    typedef clock_type::time_type time_type;
+    typedef boost::multi_array<accumulator<double>, 2> block_result_type;
+    typedef boost::multi_array<double, 2> block_mean_type;
+    typedef boost::multi_array<accumulator<double>::size_type, 2> block_count_type;
+    typedef boost::multi_array<time_type, 2> block_time_type;
+
+    /**
+     * Construct autocorrelation function of a single time series.
+     *
+     *  @param maximum_lag_time   maximum lag time for dynamic correlations
+     *  @param interval           sampling interval in simulation steps
+     *  @param window             number of time origins per window, or 0 to
+     *                            store the full series
+     */
+    fft_correlation(
+        std::shared_ptr<clock_type const> clock
+      , acquire_type const& acquire
+      , double maximum_lag_time
+      , unsigned int interval
+      , unsigned int window = 0
+      , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>("dynamics.fft_correlation")
+    );
+
+    /**
+     * Construct cross-correlation function of two time series.
+     */
+    fft_correlation(
+        std::shared_ptr<clock_type const> clock
+      , acquire_type const& acquire1
+      , acquire_type const& acquire2
+      , double maximum_lag_time
+      , unsigned int interval
+      , unsigned int window = 0
+      , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>("dynamics.fft_correlation")
+    );
+
+    /**
+     * Release FFT plans and buffers.
+     */
+    ~fft_correlation();
+
+    /**
+     * Acquire and store samples, correlate window if complete.
+     *
+     * The method must be called every 'interval' steps.
+     */
+    void sample();
+
+    /**
+     * Correlate remaining samples.
+     */
+    void finalise();
+
+    /** returns number of lag times */
+    unsigned int size() const
+    {
+        return nlag_;
+    }
+
+    /** returns number of time origins per window, or 0 for the full series */
+    unsigned int window() const
+    {
+        return window_;
+    }
+
+    /** returns accumulated results */
+    block_result_type const& result() const
+    {
+        return result_;
+    }
+
+    /** returns time grid of correlation function */
+    block_time_type const& time() const
+    {
+        return time_;
+    }
+
+    static std::function<block_mean_type const& ()>
+    get_mean(std::shared_ptr<fft_correlation> self);
+
+    static std::function<block_mean_type const& ()>
+    get_error(std::shared_ptr<fft_correlation> self);
+
+    static std::function<block_count_type const& ()>
+    get_count(std::shared_ptr<fft_correlation> self);
+
+    /**
+     * Bind class to Lua.
+     */
+    static void luaopen(lua_State* L);
+
+private:
+    typedef halmd::utility::profiler::accumulator_type accumulator_type;
+    typedef halmd::utility::profiler::scoped_timer_type scoped_timer_type;
+
+    struct runtime
+    {
+        accumulator_type sample;
+        accumulator_type tcf;
+    };
+
+    /** append sample to series */
+    void append_(std::vector<double> const& value, std::vector<double>& series);
+    /** correlate first 'norigin' samples with all stored samples and discard them */
+    void process_(unsigned int norigin);
+    /** transform component i, or product of components i and j ≥ 0, of
+     *  first 'nsample' samples of series zero-padded to the FFT length */
+    void transform_(std::vector<double> const& series, unsigned int nsample, unsigned int i, int j, fftw_complex* spectrum);
+    /** (re-)allocate FFT buffers and plans for transforms of given length */
+    void plan_(unsigned int nfft);
+    /** release FFT buffers and plans */
+    void release_();
+
+    /** simulation clock */
+    std::shared_ptr<clock_type const> clock_;
+    /** callables yielding the samples */
+    acquire_type acquire1_;
+    acquire_type acquire2_;
+    /** sampling interval in steps */
+    unsigned int interval_;
+    /** number of time origins per window */
+    unsigned int window_;
+    /** module logger */
+    std::shared_ptr<logger> logger_;
+
+    /** number of lag times */
+    unsigned int nlag_;
+    /** number of components of samples */
+    unsigned int ncomp_;
+    /** stored samples in row-major order of time and component */
+    std::vector<double> series1_;
+    std::vector<double> series2_;
+    /** step of last sample */
+    step_type step_;
+    /** snapshot of time step at construction */
+    time_type timestep_;
+
+    /** length of FFT */
+    unsigned int nfft_;
+    /** real-space buffer */
+    double* real_;
+    /** transforms of first and second series */
+    fftw_complex* spectrum1_;
+    fftw_complex* spectrum2_;
+    /** accumulated cross-spectra of values and of squared products */
+    fftw_complex* cross_;
+    fftw_complex* cross_sq_;
+    /** FFT plans */
+    fftw_plan forward_;
+    fftw_plan backward_;
+
+    /** accumulated results */
+    block_result_type result_;
+    /** mean values */
+    block_mean_type mean_;
+    /** standard error of mean */
+    block_mean_type error_;
+    /** accumulator count */
+    block_count_type count_;
+    /** time grid */
+    block_time_type time_;
+
+    /** profiling runtime accumulators */
+    runtime runtime_;
+};
+
+} // namespace dynamics
+} // namespace observables
+} // namespace halmd
+
+#endif /* ! HALMD_OBSERVABLES_DYNAMICS_FFT_CORRELATION_HPP */
@@ -0,0 +1,156 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <limits>
+#include <stdexcept>
+
+#include <halmd/observables/dynamics/correlation.hpp>
+#include <halmd/observables/dynamics/helfand_moment.hpp>
+#include <halmd/utility/lua/lua.hpp>
+
+namespace halmd {
+namespace observables {
+namespace dynamics {
+
+template <int dimension>
+helfand_moment<dimension>::helfand_moment(
+    std::shared_ptr<clock_type const> clock
+  , std::shared_ptr<thermodynamics_type> thermodynamics
+  , unsigned int interval
+  , std::shared_ptr<logger> logger
+)
+  : clock_(clock)
+  , thermodynamics_(thermodynamics)
+  , interval_(interval)
+  , logger_(logger)
+  , nparticle_(thermodynamics_->particle_number())
+  , origin_(clock_->step())
+  , integrate_step_(std::numeric_limits<step_type>::max())
+  , moment_(0)
+  , sample_step_(std::numeric_limits<step_type>::max())
+{
+    if (interval_ == 0) {
+        throw std::invalid_argument("integration interval must be non-zero");
+    }
+    LOG("integration interval of stress tensor: " << interval_ << " steps");
+}
+
+template <int dimension>
+void helfand_moment<dimension>::integrate()
+{
+    step_type step = clock_->step();
+    if (step == integrate_step_) {
+        return;
+    }
+    scoped_timer_type timer(runtime_.integrate);
+
+    // integrate via rectangular rule, skipping the diagonal elements
+    auto const& stress_tensor = thermodynamics_->stress_tensor();
+    double dt = interval_ * clock_->timestep();
+    for (unsigned int i = 0; i < sample_type::static_size; ++i) {
+        moment_[i] += stress_tensor[dimension + i] * dt;
+    }
+    integrate_step_ = step;
+}
+
+template <int dimension>
+std::shared_ptr<typename helfand_moment<dimension>::sample_type const>
+helfand_moment<dimension>::acquire()
+{
+    step_type step = clock_->step();
+    if (step != sample_step_) {
+        if (step >= origin_ && (step - origin_) % interval_ == 0) {
+            integrate();
+        }
+        sample_ = std::make_shared<sample_type const>(moment_);
+        sample_step_ = step;
+    }
+    return sample_;
+}
+
+template <typename helfand_moment_type>
+static std::function<void ()>
+wrap_integrate(std::shared_ptr<helfand_moment_type> self)
+{
+    return [=]() {
+        self->integrate();
+    };
+}
+
+template <typename helfand_moment_type>
+static std::function<std::shared_ptr<typename helfand_moment_type::sample_type const> ()>
+wrap_acquire(std::shared_ptr<helfand_moment_type> self)
+{
+    return [=]() {
+        return self->acquire();
+    };
+}
+
+template <int dimension>
+void helfand_moment<dimension>::luaopen(lua_State* L)
+{
+    using namespace luaponte;
+    module(L, "libhalmd")
+    [
+        namespace_("observables")
+        [
+            namespace_("dynamics")
+            [
+                class_<helfand_moment>()
+                    .property("integrate", &wrap_integrate<helfand_moment>)
+                    .property("acquire", &wrap_acquire<helfand_moment>)
+                    .scope
+                    [
+                        class_<runtime>("runtime")
+                            .def_readonly("integrate", &runtime::integrate)
+                    ]
+                    .def_readonly("runtime", &helfand_moment::runtime_)
+
+              , def("helfand_moment", &std::make_shared<helfand_moment
+                  , std::shared_ptr<clock_type const>
+                  , std::shared_ptr<thermodynamics_type>
+                  , unsigned int
+                  , std::shared_ptr<logger>
+                >)
+            ]
+        ]
+    ];
+}
+
+HALMD_LUA_API int luaopen_libhalmd_observables_dynamics_helfand_moment(lua_State* L)
+{
+    helfand_moment<3>::luaopen(L);
+    helfand_moment<2>::luaopen(L);
+    correlation<helfand_moment<3>>::luaopen(L);
+    correlation<helfand_moment<2>>::luaopen(L);
+    return 0;
+}
+
+// explicit instantiation
+template class helfand_moment<3>;
+template class helfand_moment<2>;
+
+// explicit instantiation
+template class correlation<helfand_moment<3>>;
+template class correlation<helfand_moment<2>>;
+
+} // namespace dynamics
+} // namespace observables
+} // namespace halmd
@@ -0,0 +1,140 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_OBSERVABLES_DYNAMICS_HELFAND_MOMENT_HPP
+#define HALMD_OBSERVABLES_DYNAMICS_HELFAND_MOMENT_HPP
+
+#include <lua.hpp>
+#include <memory>
+
+#include <halmd/io/logger.hpp>
+#include <halmd/mdsim/clock.hpp>
+#include <halmd/numeric/accumulator.hpp>
+#include <halmd/numeric/blas/fixed_vector.hpp>
+#include <halmd/observables/thermodynamics.hpp>
+#include <halmd/utility/profiler.hpp>
+
+namespace halmd {
+namespace observables {
+namespace dynamics {
+
+/**
+ * Mean-square difference of the Helfand moment of the stress tensor
+ *
+ * The Helfand moment is the time integral of the off-diagonal elements of
+ * the stress tensor, which is integrated by the rectangular rule over
+ * intervals of a fixed number of integration steps. The class provides the
+ * samples of the Helfand moment for a blocking scheme, and serves as the
+ * correlation function of these samples.
+ */
+template <int dimension>
+class helfand_moment
+{
+public:
+    typedef fixed_vector<double, (dimension - 1) * dimension / 2> sample_type;
+    typedef double result_type;
+    /** operator() may be called concurrently for distinct results */
+    enum { concurrent = true };
+
+    typedef mdsim::clock clock_type;
+    typedef clock_type::step_type step_type;
+    typedef observables::thermodynamics<dimension> thermodynamics_type;
+
+    static void luaopen(lua_State* L);
+
+    /**
+     * @param clock           simulation clock
+     * @param thermodynamics  module providing the stress tensor
+     * @param interval        integration interval in simulation steps
+     */
+    helfand_moment(
+        std::shared_ptr<clock_type const> clock
+      , std::shared_ptr<thermodynamics_type> thermodynamics
+      , unsigned int interval
+      , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
+    );
+
+    /**
+     * Add the stress tensor of the current step to the Helfand moment.
+     *
+     * Repeated calls within the same step have no effect.
+     */
+    void integrate();
+
+    /**
+     * Returns the Helfand moment at the current step.
+     *
+     * The integration is performed first if the current step is an
+     * integration step.
+     */
+    std::shared_ptr<sample_type const> acquire();
+
+    /**
+     * Compute the sum of the squared differences of two samples over the
+     * off-diagonal elements, divided by the number of particles.
+     */
+    void operator() (sample_type const& first, sample_type const& second, accumulator<result_type>& result) const
+    {
+        double value = 0;
+        for (unsigned int i = 0; i < sample_type::static_size; ++i) {
+            double delta = second[i] - first[i];
+            value += delta * delta;
+        }
+        result(value / nparticle_);
+    }
+
+private:
+    typedef halmd::utility::profiler::accumulator_type accumulator_type;
+    typedef halmd::utility::profiler::scoped_timer_type scoped_timer_type;
+
+    struct runtime
+    {
+        accumulator_type integrate;
+    };
+
+    /** simulation clock */
+    std::shared_ptr<clock_type const> clock_;
+    /** module providing the stress tensor */
+    std::shared_ptr<thermodynamics_type> thermodynamics_;
+    /** integration interval in simulation steps */
+    unsigned int interval_;
+    /** module logger */
+    std::shared_ptr<logger> logger_;
+    /** number of particles used for normalisation */
+    double nparticle_;
+    /** step of first integration */
+    step_type origin_;
+    /** step of most recent integration */
+    step_type integrate_step_;
+    /** current value of the Helfand moment */
+    sample_type moment_;
+    /** sample of the Helfand moment at the most recent acquisition */
+    std::shared_ptr<sample_type const> sample_;
+    /** step of most recent acquisition */
+    step_type sample_step_;
+    /** profiling runtime accumulators */
+    runtime runtime_;
+};
+
+} // namespace dynamics
+} // namespace observables
+} // namespace halmd
+
+#endif /* ! HALMD_OBSERVABLES_DYNAMICS_HELFAND_MOMENT_HPP */
@@ -42,6 +42,8 @@ public:
     typedef raw_array<fixed_vector<double, 2>> sample_type;
     typedef double result_type;
     enum { result_rank = 1 };
+    /** operator() may be called concurrently for distinct results */
+    enum { concurrent = true };
 
     typedef observables::utility::wavevector<dimension> wavevector_type;
 
@@ -90,10 +90,15 @@ density_mode<dimension, float_type>::acquire()
 
         scoped_timer_type timer(runtime_.acquire);
 
-        // allocate new memory which allows modules (e.g.,
+        // obtain new result which allows modules (e.g.,
         // dynamics::blocking_scheme) to hold a previous copy of the result or
-        // to track the update via std::weak_ptr.
-        result_ = make_shared<result_type>(nq_);
+        // to track the update via std::weak_ptr, reuse the memory of a
+        // released result if available
+        result_.reset();
+        result_ = recycler_.get(
+            [&](result_type const& result) { return result.size() == nq_; }
+          , [&]() { return new result_type(nq_); }
+        );
 
         // compute density modes
         try {
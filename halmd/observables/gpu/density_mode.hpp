@@ -36,6 +36,7 @@
 #include <halmd/utility/owner_equal.hpp>
 #include <halmd/utility/profiler.hpp>
 #include <halmd/utility/raw_array.hpp>
+#include <halmd/utility/recycler.hpp>
 
 namespace halmd {
 namespace observables {
@@ -115,6 +116,8 @@ private:
 
     /** result for the density modes */
     std::shared_ptr<result_type> result_;
+    /** released results for reuse */
+    recycler<result_type> recycler_;
     /** cache observer for particle positions */
     cache<> position_cache_;
     /** cache observer for particle group */
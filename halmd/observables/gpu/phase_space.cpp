@@ -194,11 +194,18 @@ phase_space<host::samples::phase_space<dimension, float_type> >::acquire()
         throw;
     }
 
-    // re-allocate memory which allows modules (e.g., dynamics::blocking_scheme)
-    // to hold a previous copy of the sample
+    // obtain new sample which allows modules (e.g., dynamics::blocking_scheme)
+    // to hold a previous copy of the sample, reuse the memory of a released
+    // sample if available
     {
         scoped_timer_type timer(runtime_.reset);
-        sample_ = std::make_shared<sample_type>(group.size(), clock_->step());
+        std::size_t const nparticle = group.size();
+        sample_.reset();
+        sample_ = recycler_.get(
+            [&](sample_type const& sample) { return sample.position().size() == nparticle; }
+          , [&]() { return new sample_type(nparticle); }
+        );
+        sample_->set_step(clock_->step());
     }
 
     assert(group.size() == sample_->position().size());
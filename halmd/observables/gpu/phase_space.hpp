@@ -31,6 +31,7 @@
 #include <halmd/observables/gpu/samples/phase_space.hpp>
 #include <halmd/observables/host/samples/phase_space.hpp>
 #include <halmd/utility/profiler.hpp>
+#include <halmd/utility/recycler.hpp>
 
 namespace halmd {
 namespace observables {
@@ -164,6 +165,8 @@ private:
     std::shared_ptr<logger> logger_;
     /** cached phase_space sample */
     std::shared_ptr<sample_type> sample_;
+    /** released samples for reuse */
+    recycler<sample_type> recycler_;
 
     /** buffered positions in page-locked host memory */
     cuda::host::vector<float4> h_r_;
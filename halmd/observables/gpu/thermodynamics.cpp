@@ -187,6 +187,11 @@ thermodynamics<dimension, float_type>::stress_tensor()
     return stress_tensor_;
 }
 
+template <int dimension, typename float_type>
+void thermodynamics<dimension, float_type>::aux_enable()
+{
+    particle_->aux_enable();
+}
 
 template <int dimension, typename float_type>
 void thermodynamics<dimension, float_type>::luaopen(lua_State* L)
@@ -108,6 +108,11 @@ public:
      */
     virtual stress_tensor_type const& stress_tensor();
 
+    /**
+     * Enable computation of auxiliary variables in the next force computation.
+     */
+    virtual void aux_enable();
+
 private:
     typedef typename particle_type::size_type size_type;
     typedef typename particle_type::velocity_array_type velocity_array_type;
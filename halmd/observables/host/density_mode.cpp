@@ -22,6 +22,10 @@
 #include <halmd/observables/host/density_mode.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
 using namespace std;
 
 namespace halmd {
@@ -35,12 +39,58 @@ density_mode<dimension, float_type>::density_mode(
   , shared_ptr<wavevector_type const> wavevector
   , shared_ptr<logger> logger
 )
-    // dependency injection
-  : particle_(particle)
-  , particle_group_(particle_group)
-  , wavevector_(wavevector)
+  : sweep_(make_shared<sweep>())
+  , slot_(0)
+  , logger_(logger)
+{
+    sweep_->particle = particle;
+    sweep_->wavevector = wavevector;
+    sweep_->group.push_back(particle_group);
+    sweep_->result.push_back(nullptr);
+    sweep_->pool.push_back(recycler<result_type>());
+    sweep_->group_cache.push_back(cache<>());
+
+    // map wavevectors onto integer indices of the reciprocal lattice
+    auto const& box_length = wavevector->box_length();
+    for (int j = 0; j < dimension; ++j) {
+        sweep_->unit[j] = 2 * M_PI / box_length[j];
+        sweep_->index_max[j] = 0;
+    }
+    for (auto const& q : wavevector->value()) {
+        index_type n;
+        for (int j = 0; j < dimension; ++j) {
+            double x = q[j] / sweep_->unit[j];
+            n[j] = static_cast<int>(round(x));
+            if (abs(x - n[j]) > 1e-6) {
+                LOG_DEBUG("wavevectors are not on the reciprocal lattice, evaluate exponentials directly");
+                sweep_->index.clear();
+                return;
+            }
+            sweep_->index_max[j] = max(sweep_->index_max[j], abs(n[j]));
+        }
+        sweep_->index.push_back(n);
+    }
+    LOG_DEBUG("compute exponentials by recurrence on reciprocal lattice");
+}
+
+template <int dimension, typename float_type>
+density_mode<dimension, float_type>::density_mode(
+    shared_ptr<density_mode> share
+  , shared_ptr<particle_group_type> particle_group
+  , shared_ptr<logger> logger
+)
+  : sweep_(share->sweep_)
+  , slot_(sweep_->group.size())
   , logger_(logger)
-{}
+{
+    sweep_->group.push_back(particle_group);
+    sweep_->result.push_back(nullptr);
+    sweep_->pool.push_back(recycler<result_type>());
+    sweep_->group_cache.push_back(cache<>());
+    // invalidate results of all sharing instances to keep them in sync
+    sweep_->position_cache = cache<>();
+    LOG_DEBUG("share loop over particles with " << slot_ << " further particle group(s)");
+}
 
 /**
  * Acquire density modes from particle positions
@@ -50,48 +100,179 @@ shared_ptr<typename density_mode<dimension, float_type>::result_type const>
 density_mode<dimension, float_type>::acquire()
 {
     // check validity of caches
-    auto const& group_cache  = particle_group_->ordered();
-    auto const& position_cache = particle_->position();
-
-    if (group_cache_ != group_cache || position_cache_ != position_cache) {
-        // obtain read access to input caches
-        auto const& group = read_cache(group_cache);
-        auto const& position = read_cache(position_cache);
-
+    if (sweep_->group_cache[slot_] != sweep_->group[slot_]->ordered()
+        || sweep_->position_cache != sweep_->particle->position()) {
         LOG_TRACE("acquire sample");
 
         scoped_timer_type timer(runtime_.acquire);
+        compute_();
+    }
+    return sweep_->result[slot_];
+}
+
+/**
+ * Compute density modes of all outdated particle groups in a single loop over
+ * the particles.
+ */
+template <int dimension, typename float_type>
+void density_mode<dimension, float_type>::compute_()
+{
+    auto const& position_cache = sweep_->particle->position();
+    bool position_valid = (sweep_->position_cache == position_cache);
+    size_t nslot = sweep_->group.size();
+    size_t nq = sweep_->wavevector->value().size();
+
+    // collect members of outdated groups, ordered by particle index such that
+    // the exponentials of a particle are computed only once
+    vector<unsigned int> slots;
+    auto& member = sweep_->member;
+    member.clear();
+    for (unsigned int s = 0; s < nslot; ++s) {
+        auto const& group_cache = sweep_->group[s]->ordered();
+        if (position_valid && sweep_->group_cache[s] == group_cache) {
+            continue;
+        }
+        for (auto i : read_cache(group_cache)) {
+            member.push_back(make_pair(i, s));
+        }
+        slots.push_back(s);
+    }
+    if (slots.size() > 1) {
+        sort(member.begin(), member.end());
+    }
+
+    vector<complex_type> rho(nslot * nq, 0);
 
-        auto const& wavevector = wavevector_->value(); // array of wavevectors
+    // process chunks of members in parallel, accumulating the density modes
+    // per thread before reducing them
+    long const chunk = 1024;
+    long const nchunk = (member.size() + chunk - 1) / chunk;
+    bool const lattice = !sweep_->index.empty() || nq == 0;
+#pragma omp parallel
+    {
+        vector<complex_type> rho_thread(nslot * nq, 0);
+#pragma omp for schedule(dynamic)
+        for (long c = 0; c < nchunk; ++c) {
+            size_t first = c * chunk;
+            size_t last = min(first + chunk, member.size());
+            if (lattice) {
+                compute_lattice_(first, last, rho_thread);
+            }
+            else {
+                compute_direct_(first, last, rho_thread);
+            }
+        }
+#pragma omp critical
+        transform(rho.begin(), rho.end(), rho_thread.begin(), rho.begin(), plus<complex_type>());
+    }
 
-        // allocate new memory which allows modules (e.g.,
-        // dynamics::blocking_scheme) to hold a previous copy of the result or
-        // to track the update via std::weak_ptr.
-        result_ = make_shared<result_type>(wavevector.size());
+    // obtain new result which allows modules (e.g.,
+    // dynamics::blocking_scheme) to hold a previous copy of the result or
+    // to track the update via std::weak_ptr, reuse the memory of a released
+    // result if available
+    for (unsigned int s : slots) {
+        sweep_->result[s].reset();
+        auto result = sweep_->pool[s].get(
+            [&](result_type const& result) { return result.size() == nq; }
+          , [&]() { return new result_type(nq); }
+        );
+        for (size_t k = 0; k < nq; ++k) {
+            complex_type const& rho_q = rho[s * nq + k];
+            (*result)[k] = typename result_type::value_type({{ rho_q.real(), rho_q.imag() }});
+        }
+        sweep_->result[s] = result;
+        sweep_->group_cache[s] = sweep_->group[s]->ordered();
+    }
+    sweep_->position_cache = position_cache;
+}
+
+/**
+ * Compute sum of exponentials, rho_q = sum_r exp(-i q·r), for a range of
+ * members using the lattice indices of the wavevectors
+ *
+ * The powers exp(-i n_j u_j r_j), with u_j = 2π / L_j, are obtained per
+ * axis by repeated complex multiplication, negative powers by complex
+ * conjugation. Every few powers are evaluated directly, so that the rounding
+ * error does not grow with the magnitude of the lattice index.
+ */
+template <int dimension, typename float_type>
+void density_mode<dimension, float_type>::compute_lattice_(
+    size_t first
+  , size_t last
+  , vector<complex_type>& rho
+) const
+{
+    auto const& position = read_cache(sweep_->particle->position());
+    auto const& index = sweep_->index;
+    auto const& member = sweep_->member;
+    size_t nq = index.size();
 
-        // compute density modes
-        // initialise result array
-        fill(begin(*result_), end(*result_), 0);
+    // tables of powers of exp(-i u_j r_j) for each axis
+    unsigned int const anchor = 16;
+    vector<complex_type> power[dimension];
+    for (int j = 0; j < dimension; ++j) {
+        power[j].resize(sweep_->index_max[j] + 1);
+    }
 
-        // compute sum of exponentials: rho_q = sum_r exp(-i q·r)
-        // 1st loop: iterate over particle group
-        for (auto i : group) {
+    unsigned int i_prev = -1U;
+    for (size_t m = first; m < last; ++m) {
+        unsigned int i = member[m].first;
+        if (i != i_prev) {
             vector_type const& r = position[i];
-            // 2nd loop: iterate over wavevectors
-            typedef typename result_type::value_type mode_type;
-            auto rho_q = begin(*result_);
-            for (auto const& q : wavevector) {
-                float_type q_r = inner_prod(q, r);
-                *rho_q++ += mode_type({{ cos(q_r), -sin(q_r) }});
+            for (int j = 0; j < dimension; ++j) {
+                double phi = sweep_->unit[j] * r[j];
+                complex_type base(cos(phi), -sin(phi));
+                auto& p = power[j];
+                p[0] = 1;
+                for (size_t n = 1; n < p.size(); ++n) {
+                    // re-anchor the recurrence to bound the rounding error
+                    if (n % anchor == 0) {
+                        p[n] = polar(1., -(n * phi));
+                    }
+                    else {
+                        p[n] = p[n - 1] * base;
+                    }
+                }
             }
+            i_prev = i;
         }
 
-        // update cache observers
-        group_cache_ = group_cache;
-        position_cache_ = position_cache;
+        complex_type* rho_q = &rho[member[m].second * nq];
+        for (size_t k = 0; k < nq; ++k) {
+            index_type const& n = index[k];
+            complex_type z = n[0] < 0 ? conj(power[0][-n[0]]) : power[0][n[0]];
+            for (int j = 1; j < dimension; ++j) {
+                z *= n[j] < 0 ? conj(power[j][-n[j]]) : power[j][n[j]];
+            }
+            rho_q[k] += z;
+        }
     }
+}
 
-    return result_;
+/**
+ * Compute sum of exponentials, rho_q = sum_r exp(-i q·r), for a range of
+ * members by evaluating the trigonometric functions for each wavevector
+ */
+template <int dimension, typename float_type>
+void density_mode<dimension, float_type>::compute_direct_(
+    size_t first
+  , size_t last
+  , vector<complex_type>& rho
+) const
+{
+    auto const& position = read_cache(sweep_->particle->position());
+    auto const& wavevector = sweep_->wavevector->value();
+    auto const& member = sweep_->member;
+    size_t nq = wavevector.size();
+
+    for (size_t m = first; m < last; ++m) {
+        vector_type const& r = position[member[m].first];
+        complex_type* rho_q = &rho[member[m].second * nq];
+        for (size_t k = 0; k < nq; ++k) {
+            double q_r = inner_prod(wavevector[k], static_cast<fixed_vector<double, dimension>>(r));
+            rho_q[k] += complex_type(cos(q_r), -sin(q_r));
+        }
+    }
 }
 
 template <int dimension, typename float_type>
@@ -120,6 +301,11 @@ void density_mode<dimension, float_type>::luaopen(lua_State* L)
               , shared_ptr<wavevector_type const>
               , shared_ptr<logger>
             >)
+          , def("density_mode", &make_shared<density_mode
+              , shared_ptr<density_mode>
+              , shared_ptr<particle_group_type>
+              , shared_ptr<logger>
+            >)
         ]
     ];
 }
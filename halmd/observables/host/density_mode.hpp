@@ -22,8 +22,10 @@
 #ifndef HALMD_OBSERVABLES_HOST_DENSITY_MODE_HPP
 #define HALMD_OBSERVABLES_HOST_DENSITY_MODE_HPP
 
+#include <complex>
 #include <lua.hpp>
 #include <memory>
+#include <vector>
 
 #include <halmd/io/logger.hpp>
 #include <halmd/mdsim/host/particle.hpp>
@@ -33,6 +35,7 @@
 #include <halmd/utility/owner_equal.hpp>
 #include <halmd/utility/profiler.hpp>
 #include <halmd/utility/raw_array.hpp>
+#include <halmd/utility/recycler.hpp>
 
 namespace halmd {
 namespace observables {
@@ -47,6 +50,13 @@ namespace host {
  * efficient copying, e.g., in dynamics::blocking_scheme.  Further, the result
  * may be tracked by std::weak_ptr providing a similar functionality as
  * halmd::cache
+ *
+ * For wavevectors on the reciprocal lattice of the periodic box, @f$ \vec q =
+ * 2\pi (n_1/L_1, n_2/L_2, \ldots) @f$ with integers @f$ n_\alpha @f$, the
+ * exponentials are obtained by complex multiplication from the powers of
+ * @f$ \exp(2\pi\textrm{i} r_\alpha / L_\alpha) @f$ per axis, which are
+ * generated by recurrence. Several instances may share a single loop over the
+ * particles, accumulating the density modes of different particle groups.
  */
 template <int dimension, typename float_type>
 class density_mode
@@ -64,6 +74,18 @@ public:
       , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>("density_mode")
     );
 
+    /**
+     * Construct density modes of a further particle group, sharing the loop
+     * over the particles with the given instance.
+     *
+     * The group must refer to the same instance of particle.
+     */
+    density_mode(
+        std::shared_ptr<density_mode> share
+      , std::shared_ptr<particle_group_type> particle_group
+      , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>("density_mode")
+    );
+
     /** Compute density modes from particle group.
      *
      * The result is re-computed only if the particle positions have been
@@ -88,7 +110,7 @@ public:
      */
     std::shared_ptr<wavevector_type const> wavevector()
     {
-        return wavevector_;
+        return sweep_->wavevector;
     }
 
     /**
@@ -98,23 +120,53 @@ public:
 
 private:
     typedef fixed_vector<float_type, dimension> vector_type;
+    typedef fixed_vector<int, dimension> index_type;
+    typedef std::complex<double> complex_type;
 
-    /** system state */
-    std::shared_ptr<particle_type const> particle_;
-    /** particle group */
-    std::shared_ptr<particle_group_type> particle_group_;
-    /** wavevector list */
-    std::shared_ptr<wavevector_type const> wavevector_;
+    /**
+     * State shared by the instances that accumulate their density modes in
+     * a single loop over the particles.
+     */
+    struct sweep
+    {
+        /** system state */
+        std::shared_ptr<particle_type const> particle;
+        /** wavevector list */
+        std::shared_ptr<wavevector_type const> wavevector;
+        /** particle groups of the sharing instances */
+        std::vector<std::shared_ptr<particle_group_type>> group;
+        /** results of the sharing instances */
+        std::vector<std::shared_ptr<result_type>> result;
+        /** released results of the sharing instances for reuse */
+        std::vector<recycler<result_type>> pool;
+        /** cache observers for particle groups */
+        std::vector<cache<>> group_cache;
+        /** cache observer for particle positions */
+        cache<> position_cache;
+        /** pairs of particle index and group slot, ordered by particle index */
+        std::vector<std::pair<unsigned int, unsigned int>> member;
+        /** lattice indices of wavevectors, if all are on the reciprocal lattice */
+        std::vector<index_type> index;
+        /** maximum magnitude of lattice indices per axis */
+        index_type index_max;
+        /** base wavevector of reciprocal lattice */
+        fixed_vector<double, dimension> unit;
+    };
+
+    /** compute density modes of all groups sharing the sweep */
+    void compute_();
+    /** compute density modes of member range using lattice recurrence */
+    void compute_lattice_(std::size_t first, std::size_t last, std::vector<complex_type>& rho) const;
+    /** compute density modes of member range by direct evaluation */
+    void compute_direct_(std::size_t first, std::size_t last, std::vector<complex_type>& rho) const;
+
+    /** shared sweep over particles */
+    std::shared_ptr<sweep> sweep_;
+    /** slot of particle group and result within sweep */
+    unsigned int slot_;
     /** logger instance */
     std::shared_ptr<logger> logger_;
 
-    /** result for the density modes */
-    std::shared_ptr<result_type> result_;
-    /** cache observer for particle positions */
-    cache<> position_cache_;
-    /** cache observer for particle group */
-    cache<> group_cache_;
-
     typedef halmd::utility::profiler::accumulator_type accumulator_type;
     typedef halmd::utility::profiler::scoped_timer_type scoped_timer_type;
 
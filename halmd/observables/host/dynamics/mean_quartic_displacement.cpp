@@ -21,6 +21,7 @@
 #include <halmd/io/logger.hpp>
 #include <halmd/observables/dynamics/correlation.hpp>
 #include <halmd/observables/host/dynamics/mean_quartic_displacement.hpp>
+#include <halmd/observables/host/dynamics/partitioned.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
 namespace halmd {
@@ -42,13 +43,22 @@ void mean_quartic_displacement<dimension, float_type>::operator() (
   , accumulator<result_type>& result
 )
 {
-    accumulator<result_type> acc;
-    typename sample_type::position_array_type::const_iterator r1, r2, end = first.position().end();
-    for (r1 = first.position().begin(), r2 = second.position().begin(); r1 != end; ++r1, ++r2) {
-        // accumulate quartic displacement
-        acc(correlate_function_type()(*r1, *r2));
+    auto const& r1 = first.position();
+    auto const& r2 = second.position();
+    long const size = r1.size();
+
+    // accumulate per thread and merge partial results
+#pragma omp parallel
+    {
+        accumulator<result_type> acc;
+#pragma omp for
+        for (long i = 0; i < size; ++i) {
+            // accumulate quartic displacement
+            acc(correlate_function_type()(r1[i], r2[i]));
+        }
+#pragma omp critical
+        result(acc);
     }
-    result(acc);
 }
 
 template <typename tcf_type>
@@ -58,6 +68,26 @@ select_tcf_by_acquire(std::function<std::shared_ptr<typename tcf_type::sample_ty
     return std::make_shared<tcf_type>();
 }
 
+template <typename tcf_type>
+static std::shared_ptr<partitioned<tcf_type>>
+select_tcf_by_species(
+    std::function<std::shared_ptr<typename tcf_type::sample_type const> ()> const&
+  , unsigned int nspecies
+)
+{
+    return std::make_shared<partitioned<tcf_type>>(nspecies);
+}
+
+template <typename tcf_type>
+static std::shared_ptr<partitioned<tcf_type>>
+select_tcf_by_partition(
+    std::function<std::shared_ptr<typename tcf_type::sample_type const> ()> const&
+  , std::vector<unsigned int> const& partition
+)
+{
+    return std::make_shared<partitioned<tcf_type>>(partition);
+}
+
 template <int dimension, typename float_type>
 void mean_quartic_displacement<dimension, float_type>::luaopen(lua_State* L)
 {
@@ -69,8 +99,11 @@ void mean_quartic_displacement<dimension, float_type>::luaopen(lua_State* L)
             namespace_("dynamics")
             [
                 class_<mean_quartic_displacement>()
+              , class_<partitioned<mean_quartic_displacement>>()
 
               , def("mean_quartic_displacement", &select_tcf_by_acquire<mean_quartic_displacement>)
+              , def("mean_quartic_displacement", &select_tcf_by_species<mean_quartic_displacement>)
+              , def("mean_quartic_displacement", &select_tcf_by_partition<mean_quartic_displacement>)
             ]
         ]
     ];
@@ -86,6 +119,10 @@ HALMD_LUA_API int luaopen_libhalmd_observables_host_dynamics_mean_quartic_displa
     observables::dynamics::correlation<mean_quartic_displacement<2, double> >::luaopen(L);
     observables::dynamics::correlation<mean_quartic_displacement<3, float> >::luaopen(L);
     observables::dynamics::correlation<mean_quartic_displacement<2, float> >::luaopen(L);
+    observables::dynamics::correlation<partitioned<mean_quartic_displacement<3, double> > >::luaopen(L);
+    observables::dynamics::correlation<partitioned<mean_quartic_displacement<2, double> > >::luaopen(L);
+    observables::dynamics::correlation<partitioned<mean_quartic_displacement<3, float> > >::luaopen(L);
+    observables::dynamics::correlation<partitioned<mean_quartic_displacement<2, float> > >::luaopen(L);
     return 0;
 }
 
@@ -104,8 +141,12 @@ namespace dynamics
 // explicit instantiation
 template class correlation<host::dynamics::mean_quartic_displacement<3, double> >;
 template class correlation<host::dynamics::mean_quartic_displacement<2, double> >;
+template class correlation<host::dynamics::partitioned<host::dynamics::mean_quartic_displacement<3, double> > >;
+template class correlation<host::dynamics::partitioned<host::dynamics::mean_quartic_displacement<2, double> > >;
 template class correlation<host::dynamics::mean_quartic_displacement<3, float> >;
 template class correlation<host::dynamics::mean_quartic_displacement<2, float> >;
+template class correlation<host::dynamics::partitioned<host::dynamics::mean_quartic_displacement<3, float> > >;
+template class correlation<host::dynamics::partitioned<host::dynamics::mean_quartic_displacement<2, float> > >;
 
 } // namespace dynamics
 } // namespace observables
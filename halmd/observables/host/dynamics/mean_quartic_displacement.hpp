@@ -42,13 +42,23 @@ public:
     typedef host::samples::phase_space<dimension, float_type> sample_type;
     typedef typename sample_type::vector_type vector_type;
     typedef double result_type;
+    /** operator() may be called concurrently for distinct results */
+    enum { concurrent = true };
 
     static void luaopen(lua_State* L);
 
     void operator() (sample_type const& first, sample_type const& second, accumulator<result_type>& result);
 
-private:
+    /** correlation function of a single particle */
     typedef observables::dynamics::mean_quartic_displacement<dimension, float_type> correlate_function_type;
+
+    /**
+     * Returns particle positions of phase space sample.
+     */
+    static typename sample_type::position_array_type const& data(sample_type const& sample)
+    {
+        return sample.position();
+    }
 };
 
 } // namespace dynamics
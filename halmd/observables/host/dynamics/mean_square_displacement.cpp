@@ -20,10 +20,12 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <halmd/io/logger.hpp>
 #include <halmd/observables/dynamics/correlation.hpp>
 #include <halmd/observables/host/dynamics/mean_square_displacement.hpp>
+#include <halmd/observables/host/dynamics/partitioned.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
 namespace halmd {
@@ -38,13 +40,22 @@ void mean_square_displacement<dimension, float_type>::operator() (
   , accumulator<result_type>& result
 )
 {
-    accumulator<result_type> acc;
-    typename sample_type::position_array_type::const_iterator r1, r2, end = first.position().end();
-    for (r1 = first.position().begin(), r2 = second.position().begin(); r1 != end; ++r1, ++r2) {
-        // accumulate square displacement
-        acc(correlate_function_type()(*r1, *r2));
+    auto const& r1 = first.position();
+    auto const& r2 = second.position();
+    long const size = r1.size();
+
+    // accumulate per thread and merge partial results
+#pragma omp parallel
+    {
+        accumulator<result_type> acc;
+#pragma omp for
+        for (long i = 0; i < size; ++i) {
+            // accumulate square displacement
+            acc(correlate_function_type()(r1[i], r2[i]));
+        }
+#pragma omp critical
+        result(acc);
     }
-    result(acc);
 }
 
 template <typename tcf_type>
@@ -54,6 +65,26 @@ select_tcf_by_acquire(std::function<std::shared_ptr<typename tcf_type::sample_ty
     return std::make_shared<tcf_type>();
 }
 
+template <typename tcf_type>
+static std::shared_ptr<partitioned<tcf_type>>
+select_tcf_by_species(
+    std::function<std::shared_ptr<typename tcf_type::sample_type const> ()> const&
+  , unsigned int nspecies
+)
+{
+    return std::make_shared<partitioned<tcf_type>>(nspecies);
+}
+
+template <typename tcf_type>
+static std::shared_ptr<partitioned<tcf_type>>
+select_tcf_by_partition(
+    std::function<std::shared_ptr<typename tcf_type::sample_type const> ()> const&
+  , std::vector<unsigned int> const& partition
+)
+{
+    return std::make_shared<partitioned<tcf_type>>(partition);
+}
+
 template <int dimension, typename float_type>
 void mean_square_displacement<dimension, float_type>::luaopen(lua_State* L)
 {
@@ -65,8 +96,11 @@ void mean_square_displacement<dimension, float_type>::luaopen(lua_State* L)
             namespace_("dynamics")
             [
                 class_<mean_square_displacement>()
+              , class_<partitioned<mean_square_displacement>>()
 
               , def("mean_square_displacement", &select_tcf_by_acquire<mean_square_displacement>)
+              , def("mean_square_displacement", &select_tcf_by_species<mean_square_displacement>)
+              , def("mean_square_displacement", &select_tcf_by_partition<mean_square_displacement>)
             ]
         ]
     ];
@@ -82,6 +116,10 @@ HALMD_LUA_API int luaopen_libhalmd_observables_host_dynamics_mean_square_displac
     observables::dynamics::correlation<mean_square_displacement<2, double> >::luaopen(L);
     observables::dynamics::correlation<mean_square_displacement<3, float> >::luaopen(L);
     observables::dynamics::correlation<mean_square_displacement<2, float> >::luaopen(L);
+    observables::dynamics::correlation<partitioned<mean_square_displacement<3, double> > >::luaopen(L);
+    observables::dynamics::correlation<partitioned<mean_square_displacement<2, double> > >::luaopen(L);
+    observables::dynamics::correlation<partitioned<mean_square_displacement<3, float> > >::luaopen(L);
+    observables::dynamics::correlation<partitioned<mean_square_displacement<2, float> > >::luaopen(L);
     return 0;
 }
 
@@ -101,9 +139,13 @@ namespace dynamics
 #ifndef USE_HOST_SINGLE_PRECISION
 template class correlation<host::dynamics::mean_square_displacement<3, double> >;
 template class correlation<host::dynamics::mean_square_displacement<2, double> >;
+template class correlation<host::dynamics::partitioned<host::dynamics::mean_square_displacement<3, double> > >;
+template class correlation<host::dynamics::partitioned<host::dynamics::mean_square_displacement<2, double> > >;
 #else
 template class correlation<host::dynamics::mean_square_displacement<3, float> >;
 template class correlation<host::dynamics::mean_square_displacement<2, float> >;
+template class correlation<host::dynamics::partitioned<host::dynamics::mean_square_displacement<3, float> > >;
+template class correlation<host::dynamics::partitioned<host::dynamics::mean_square_displacement<2, float> > >;
 #endif
 
 } // namespace dynamics
@@ -0,0 +1,163 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_OBSERVABLES_HOST_DYNAMICS_PARTITIONED_HPP
+#define HALMD_OBSERVABLES_HOST_DYNAMICS_PARTITIONED_HPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <halmd/numeric/accumulator.hpp>
+
+namespace halmd {
+namespace observables {
+namespace host {
+namespace dynamics {
+
+/**
+ * Tagged-particle correlation function resolved by groups of particles
+ *
+ * The particles of a phase space sample are partitioned into groups, either
+ * by their species or by an explicit group index per particle, and the
+ * correlation function given as template parameter is accumulated for all
+ * groups in a single pass over a pair of samples. The result has an extra
+ * dimension of the number of groups.
+ *
+ * The correlation function must provide the per-particle functor
+ * correlate_function_type and the static method data(sample), which returns
+ * the particle array to be correlated.
+ */
+template <typename tcf_type>
+class partitioned
+{
+public:
+    typedef typename tcf_type::sample_type sample_type;
+    typedef typename tcf_type::result_type result_type;
+    enum { result_rank = 1 };
+    /** operator() may be called concurrently for distinct results */
+    enum { concurrent = true };
+
+    /**
+     * Partition particles by species.
+     *
+     * @param nspecies number of particle species
+     */
+    explicit partitioned(unsigned int nspecies)
+      : result_shape_(nspecies)
+    {
+        if (nspecies < 1) {
+            throw std::invalid_argument("number of particle species must be non-zero");
+        }
+    }
+
+    /**
+     * Partition particles by group index.
+     *
+     * @param partition group index of each particle in the order of the sample
+     */
+    explicit partitioned(std::vector<unsigned int> const& partition)
+      : partition_(partition)
+      , result_shape_(partition.empty() ? 0 : *std::max_element(partition.begin(), partition.end()) + 1)
+    {
+        if (partition_.empty()) {
+            throw std::invalid_argument("partition of particles must be non-empty");
+        }
+    }
+
+    /**
+     * Accumulate correlation function of each group of particles
+     *
+     * @param first  phase space sample at initial time t1
+     * @param second phase space sample at later time t2
+     * @param result returns correlation function at lag time t2 - t1 for each group
+     */
+    template <typename MultiArray>
+    void operator() (sample_type const& first, sample_type const& second, MultiArray&& result) const;
+
+    /**
+     * Return shape of result array.
+     */
+    unsigned int const* result_shape() const
+    {
+        return &result_shape_;
+    }
+
+private:
+    typedef typename tcf_type::correlate_function_type correlate_function_type;
+
+    /** group index of each particle, or empty to partition by species */
+    std::vector<unsigned int> partition_;
+    /** number of groups */
+    unsigned int result_shape_;
+};
+
+template <typename tcf_type> template <typename MultiArray>
+void partitioned<tcf_type>::operator() (
+    sample_type const& first
+  , sample_type const& second
+  , MultiArray&& result
+) const
+{
+    auto const& x1 = tcf_type::data(first);
+    auto const& x2 = tcf_type::data(second);
+    auto const& species = first.species();
+    long const size = x1.size();
+    bool const by_species = partition_.empty();
+
+    if (!by_species && partition_.size() != x1.size()) {
+        throw std::invalid_argument("partition and phase space sample have mismatching sizes");
+    }
+
+    // accumulate per thread and group, and merge partial results,
+    // particles of a species outside the range of groups are flagged
+    // and reported after the parallel region
+    bool invalid = false;
+#pragma omp parallel
+    {
+        std::vector<accumulator<result_type>> acc(result_shape_);
+#pragma omp for reduction(||:invalid)
+        for (long i = 0; i < size; ++i) {
+            unsigned int group = by_species ? species[i] : partition_[i];
+            if (group >= result_shape_) {
+                invalid = true;
+                continue;
+            }
+            acc[group](correlate_function_type()(x1[i], x2[i]));
+        }
+#pragma omp critical
+        {
+            auto output = result.begin();
+            for (unsigned int group = 0; group < result_shape_; ++group) {
+                (*output++)(acc[group]);
+            }
+        }
+    }
+    if (invalid) {
+        throw std::invalid_argument("particle species exceeds number of species of partition");
+    }
+}
+
+} // namespace dynamics
+} // namespace host
+} // namespace observables
+} // namespace halmd
+
+#endif /* ! HALMD_OBSERVABLES_HOST_DYNAMICS_PARTITIONED_HPP */
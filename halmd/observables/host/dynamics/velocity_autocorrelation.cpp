@@ -21,6 +21,7 @@
 #include <halmd/io/logger.hpp>
 #include <halmd/observables/dynamics/correlation.hpp>
 #include <halmd/observables/host/dynamics/velocity_autocorrelation.hpp>
+#include <halmd/observables/host/dynamics/partitioned.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
 namespace halmd {
@@ -42,13 +43,22 @@ void velocity_autocorrelation<dimension, float_type>::operator() (
   , accumulator<result_type>& result
 )
 {
-    accumulator<result_type> acc;
-    typename sample_type::position_array_type::const_iterator v1, v2, end = first.velocity().end();
-    for (v1 = first.velocity().begin(), v2 = second.velocity().begin(); v1 != end; ++v1, ++v2) {
-        // accumulate velocity autocorrelation
-        acc(correlate_function_type()(*v1, *v2));
+    auto const& v1 = first.velocity();
+    auto const& v2 = second.velocity();
+    long const size = v1.size();
+
+    // accumulate per thread and merge partial results
+#pragma omp parallel
+    {
+        accumulator<result_type> acc;
+#pragma omp for
+        for (long i = 0; i < size; ++i) {
+            // accumulate velocity autocorrelation
+            acc(correlate_function_type()(v1[i], v2[i]));
+        }
+#pragma omp critical
+        result(acc);
     }
-    result(acc);
 }
 
 template <typename tcf_type>
@@ -58,6 +68,26 @@ select_tcf_by_acquire(std::function<std::shared_ptr<typename tcf_type::sample_ty
     return std::make_shared<tcf_type>();
 }
 
+template <typename tcf_type>
+static std::shared_ptr<partitioned<tcf_type>>
+select_tcf_by_species(
+    std::function<std::shared_ptr<typename tcf_type::sample_type const> ()> const&
+  , unsigned int nspecies
+)
+{
+    return std::make_shared<partitioned<tcf_type>>(nspecies);
+}
+
+template <typename tcf_type>
+static std::shared_ptr<partitioned<tcf_type>>
+select_tcf_by_partition(
+    std::function<std::shared_ptr<typename tcf_type::sample_type const> ()> const&
+  , std::vector<unsigned int> const& partition
+)
+{
+    return std::make_shared<partitioned<tcf_type>>(partition);
+}
+
 template <int dimension, typename float_type>
 void velocity_autocorrelation<dimension, float_type>::luaopen(lua_State* L)
 {
@@ -69,8 +99,11 @@ void velocity_autocorrelation<dimension, float_type>::luaopen(lua_State* L)
             namespace_("dynamics")
             [
                 class_<velocity_autocorrelation>()
+              , class_<partitioned<velocity_autocorrelation>>()
 
               , def("velocity_autocorrelation", &select_tcf_by_acquire<velocity_autocorrelation>)
+              , def("velocity_autocorrelation", &select_tcf_by_species<velocity_autocorrelation>)
+              , def("velocity_autocorrelation", &select_tcf_by_partition<velocity_autocorrelation>)
             ]
         ]
     ];
@@ -86,6 +119,10 @@ HALMD_LUA_API int luaopen_libhalmd_observables_host_dynamics_velocity_autocorrel
     observables::dynamics::correlation<velocity_autocorrelation<2, double> >::luaopen(L);
     observables::dynamics::correlation<velocity_autocorrelation<3, float> >::luaopen(L);
     observables::dynamics::correlation<velocity_autocorrelation<2, float> >::luaopen(L);
+    observables::dynamics::correlation<partitioned<velocity_autocorrelation<3, double> > >::luaopen(L);
+    observables::dynamics::correlation<partitioned<velocity_autocorrelation<2, double> > >::luaopen(L);
+    observables::dynamics::correlation<partitioned<velocity_autocorrelation<3, float> > >::luaopen(L);
+    observables::dynamics::correlation<partitioned<velocity_autocorrelation<2, float> > >::luaopen(L);
     return 0;
 }
 
@@ -104,8 +141,12 @@ namespace dynamics
 // explicit instantiation
 template class correlation<host::dynamics::velocity_autocorrelation<3, double> >;
 template class correlation<host::dynamics::velocity_autocorrelation<2, double> >;
+template class correlation<host::dynamics::partitioned<host::dynamics::velocity_autocorrelation<3, double> > >;
+template class correlation<host::dynamics::partitioned<host::dynamics::velocity_autocorrelation<2, double> > >;
 template class correlation<host::dynamics::velocity_autocorrelation<3, float> >;
 template class correlation<host::dynamics::velocity_autocorrelation<2, float> >;
+template class correlation<host::dynamics::partitioned<host::dynamics::velocity_autocorrelation<3, float> > >;
+template class correlation<host::dynamics::partitioned<host::dynamics::velocity_autocorrelation<2, float> > >;
 
 } // namespace dynamics
 } // namespace observables
@@ -21,8 +21,10 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include <halmd/observables/host/phase_space.hpp>
+#include <halmd/utility/deferred_array.hpp>
 #include <halmd/utility/lua/lua.hpp>
 #include <halmd/utility/scoped_timer.hpp>
 #include <halmd/utility/signal.hpp>
@@ -69,11 +71,18 @@ phase_space<dimension, float_type>::acquire()
 
     scoped_timer_type timer(runtime_.acquire);
 
-    // re-allocate memory which allows modules (e.g., dynamics::blocking_scheme)
-    // to hold a previous copy of the sample
+    // obtain new sample which allows modules (e.g., dynamics::blocking_scheme)
+    // to hold a previous copy of the sample, reuse the memory of a released
+    // sample if available
     {
         scoped_timer_type timer(runtime_.reset);
-        sample_ = std::make_shared<sample_type>(group.size(), clock_->step());
+        std::size_t const nparticle = group.size();
+        sample_.reset();
+        sample_ = recycler_.get(
+            [&](sample_type const& sample) { return sample.position().size() == nparticle; }
+          , [&]() { return new sample_type(nparticle); }
+        );
+        sample_->set_step(clock_->step());
     }
 
     typename sample_type::position_array_type& sample_position = sample_->position();
@@ -146,6 +155,76 @@ void phase_space<dimension, float_type>::set(std::shared_ptr<sample_type const>
     }
 }
 
+template <int dimension, typename float_type>
+void phase_space<dimension, float_type>::copy_position(vector_type* output)
+{
+    group_array_type const& group = read_cache(particle_group_->ordered());
+    position_array_type const& particle_position = read_cache(particle_->position());
+    image_array_type const& particle_image = read_cache(particle_->image());
+
+    scoped_timer_type timer(runtime_.acquire);
+
+    for (std::size_t i : group) {
+        vector_type& r = *output++;
+        r = particle_position[i];
+        box_->extend_periodic(r, particle_image[i]);
+    }
+}
+
+template <int dimension, typename float_type>
+void phase_space<dimension, float_type>::copy_velocity(vector_type* output)
+{
+    group_array_type const& group = read_cache(particle_group_->ordered());
+    velocity_array_type const& particle_velocity = read_cache(particle_->velocity());
+
+    scoped_timer_type timer(runtime_.acquire);
+
+    for (std::size_t i : group) {
+        *output++ = particle_velocity[i];
+    }
+}
+
+template <int dimension, typename float_type>
+template <typename array_type>
+bool phase_space<dimension, float_type>::changed(
+    cache<array_type> const& array
+  , field_observer<array_type>& observer
+)
+{
+    cache<group_array_type> const& group_cache = particle_group_->ordered();
+    if (observer.valid && observer.array_cache == array && observer.group_cache == group_cache) {
+        return false;
+    }
+    group_array_type const& group = read_cache(group_cache);
+    array_type const& particle_array = read_cache(array);
+
+    // compare the elements, since a reordering of the particles, e.g.,
+    // by sorting, invalidates the caches without changing the data
+    std::vector<typename array_type::value_type> value;
+    value.reserve(group.size());
+    for (std::size_t i : group) {
+        value.push_back(particle_array[i]);
+    }
+    bool changed = !observer.valid || value != observer.value;
+    observer.value = std::move(value);
+    observer.array_cache = array;
+    observer.group_cache = group_cache;
+    observer.valid = true;
+    return changed;
+}
+
+template <int dimension, typename float_type>
+bool phase_space<dimension, float_type>::species_changed()
+{
+    return changed(particle_->species(), species_observer_);
+}
+
+template <int dimension, typename float_type>
+bool phase_space<dimension, float_type>::mass_changed()
+{
+    return changed(particle_->mass(), mass_observer_);
+}
+
 template <typename phase_space_type>
 static std::function<std::shared_ptr<typename phase_space_type::sample_type const> ()>
 wrap_acquire(std::shared_ptr<phase_space_type> self)
@@ -191,6 +270,62 @@ wrap_mass(std::shared_ptr<phase_space_type> self)
     };
 }
 
+/**
+ * Returns slot for writing positions directly from the particle arrays,
+ * which avoids the copy to an intermediate sample.
+ */
+template <typename phase_space_type>
+static std::function<deferred_array<typename phase_space_type::sample_type::vector_type> ()>
+wrap_gather_position(std::shared_ptr<phase_space_type> self)
+{
+    typedef typename phase_space_type::sample_type::vector_type vector_type;
+    return [=]() {
+        return deferred_array<vector_type>(self->nparticle(), [=](vector_type* output) {
+            self->copy_position(output);
+        });
+    };
+}
+
+/**
+ * Returns slot for writing velocities directly from the particle arrays.
+ */
+template <typename phase_space_type>
+static std::function<deferred_array<typename phase_space_type::sample_type::vector_type> ()>
+wrap_gather_velocity(std::shared_ptr<phase_space_type> self)
+{
+    typedef typename phase_space_type::sample_type::vector_type vector_type;
+    return [=]() {
+        return deferred_array<vector_type>(self->nparticle(), [=](vector_type* output) {
+            self->copy_velocity(output);
+        });
+    };
+}
+
+/**
+ * Returns slot that checks for changes of the particle species, which
+ * allows writing the species only upon changes.
+ */
+template <typename phase_space_type>
+static std::function<bool ()>
+wrap_species_changed(std::shared_ptr<phase_space_type> self)
+{
+    return [=]() {
+        return self->species_changed();
+    };
+}
+
+/**
+ * Returns slot that checks for changes of the particle masses.
+ */
+template <typename phase_space_type>
+static std::function<bool ()>
+wrap_mass_changed(std::shared_ptr<phase_space_type> self)
+{
+    return [=]() {
+        return self->mass_changed();
+    };
+}
+
 template <typename phase_space_type>
 static int wrap_dimension(phase_space_type const&)
 {
@@ -213,6 +348,10 @@ void phase_space<dimension, float_type>::luaopen(lua_State* L)
                     .property("velocity", &wrap_velocity<phase_space>)
                     .property("species", &wrap_species<phase_space>)
                     .property("mass", &wrap_mass<phase_space>)
+                    .property("gather_position", &wrap_gather_position<phase_space>)
+                    .property("gather_velocity", &wrap_gather_velocity<phase_space>)
+                    .property("species_changed", &wrap_species_changed<phase_space>)
+                    .property("mass_changed", &wrap_mass_changed<phase_space>)
                     .property("dimension", &wrap_dimension<phase_space>)
                     .def("set", &phase_space::set)
                     .scope
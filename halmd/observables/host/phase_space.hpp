@@ -22,6 +22,7 @@
 #define HALMD_OBSERVABLES_HOST_PHASE_SPACE_HPP
 
 #include <lua.hpp>
+#include <vector>
 
 #include <halmd/io/logger.hpp>
 #include <halmd/mdsim/box.hpp>
@@ -29,7 +30,9 @@
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/mdsim/host/particle_group.hpp>
 #include <halmd/observables/host/samples/phase_space.hpp>
+#include <halmd/utility/cache.hpp>
 #include <halmd/utility/profiler.hpp>
+#include <halmd/utility/recycler.hpp>
 
 namespace halmd {
 namespace observables {
@@ -66,6 +69,38 @@ public:
      */
     void set(std::shared_ptr<sample_type const> sample);
 
+    /**
+     * Copy periodically extended particle positions in the order of the
+     * particle group to given output, without acquiring a sample.
+     */
+    void copy_position(typename sample_type::vector_type* output);
+
+    /**
+     * Copy particle velocities in the order of the particle group to given
+     * output, without acquiring a sample.
+     */
+    void copy_velocity(typename sample_type::vector_type* output);
+
+    /**
+     * Returns true if the particle species in the order of the particle
+     * group have changed since the last call, or upon the first call.
+     */
+    bool species_changed();
+
+    /**
+     * Returns true if the particle masses in the order of the particle
+     * group have changed since the last call, or upon the first call.
+     */
+    bool mass_changed();
+
+    /**
+     * Returns number of particles in group.
+     */
+    std::size_t nparticle() const
+    {
+        return read_cache(particle_group_->size());
+    }
+
     /**
      * Bind class to Lua.
      */
@@ -81,6 +116,26 @@ private:
     typedef typename particle_type::mass_array_type mass_array_type;
     typedef typename particle_group_type::array_type group_array_type;
 
+    /**
+     * Observer of a particle array in the order of the particle group.
+     */
+    template <typename array_type>
+    struct field_observer
+    {
+        /** observer of particle array */
+        cache<> array_cache;
+        /** observer of particle group */
+        cache<> group_cache;
+        /** elements in the order of the particle group at the last call */
+        std::vector<typename array_type::value_type> value;
+        /** false before the first call */
+        bool valid = false;
+    };
+
+    /** returns true if observed particle array has changed since last call */
+    template <typename array_type>
+    bool changed(cache<array_type> const& array, field_observer<array_type>& observer);
+
     /** particle instance to particle group */
     std::shared_ptr<particle_type> particle_;
     /** particle group */
@@ -93,6 +148,12 @@ private:
     std::shared_ptr<logger> logger_;
     /** cached phase_space sample */
     std::shared_ptr<sample_type> sample_;
+    /** released samples for reuse */
+    recycler<sample_type> recycler_;
+    /** observer of particle species */
+    field_observer<species_array_type> species_observer_;
+    /** observer of particle masses */
+    field_observer<mass_array_type> mass_observer_;
 
     typedef typename sample_type::vector_type vector_type;
     typedef halmd::utility::profiler::accumulator_type accumulator_type;
@@ -0,0 +1,252 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/observables/host/rdf.hpp>
+#include <halmd/utility/lua/lua.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+using namespace std;
+
+namespace halmd {
+namespace observables {
+namespace host {
+
+template <int dimension, typename float_type>
+rdf<dimension, float_type>::rdf(
+    pair<shared_ptr<particle_type const>, shared_ptr<particle_type const>> particle
+  , shared_ptr<box_type const> box
+  , shared_ptr<neighbour_type> neighbour
+  , double r_max
+  , unsigned int nbin
+  , shared_ptr<logger> logger
+)
+  // dependency injection
+  : particle1_(particle.first)
+  , particle2_(particle.second)
+  , box_(box)
+  , neighbour_(neighbour)
+  , r_max_(r_max)
+  , nbin_(nbin)
+  , logger_(logger)
+  // initialise members
+  , position_(nbin)
+  , histogram_(particle1_->nspecies() * particle2_->nspecies() * nbin, 0)
+  , norm_(particle1_->nspecies() * particle2_->nspecies(), 0)
+  , count_(0)
+  , result_(histogram_.size())
+{
+    if (!(r_max_ > 0) || nbin_ == 0) {
+        throw invalid_argument("histogram of pair distances requires positive range and number of bins");
+    }
+    double dr = r_max_ / nbin_;
+    for (unsigned int k = 0; k < nbin_; ++k) {
+        position_[k] = (k + 0.5) * dr;
+    }
+    LOG("maximum pair distance: " << r_max_);
+    LOG("number of bins: " << nbin_);
+}
+
+template <int dimension, typename float_type>
+void rdf<dimension, float_type>::sample()
+{
+    cache<typename particle_type::position_array_type> const& position1_cache = particle1_->position();
+    cache<typename particle_type::position_array_type> const& position2_cache = particle2_->position();
+    cache<species_array_type> const& species1_cache = particle1_->species();
+    cache<species_array_type> const& species2_cache = particle2_->species();
+
+    auto current_state = tie(position1_cache, position2_cache, species1_cache, species2_cache);
+
+    if (sample_cache_ == current_state) {
+        return;
+    }
+
+    // update neighbour lists before timing the histogram
+    auto const& lists = read_cache(neighbour_->lists());
+    auto const& position1 = read_cache(position1_cache);
+    auto const& position2 = read_cache(position2_cache);
+    auto const& species1 = read_cache(species1_cache);
+    auto const& species2 = read_cache(species2_cache);
+    unsigned int nspecies1 = particle1_->nspecies();
+    unsigned int nspecies2 = particle2_->nspecies();
+    long nparticle1 = particle1_->nparticle();
+
+    LOG_TRACE("sample histogram of pair distances");
+
+    scoped_timer_type timer(runtime_.sample);
+
+    // whether each pair is stored only once in the neighbour lists
+    bool const reactio = (particle1_ == particle2_);
+    float_type const rr_max = r_max_ * r_max_;
+    double const bin_scale = nbin_ / r_max_;
+
+#pragma omp parallel
+    {
+        vector<double> histogram(histogram_.size(), 0);
+#pragma omp for schedule(dynamic, 256)
+        for (long i = 0; i < nparticle1; ++i) {
+            unsigned int a = species1[i];
+            for (auto j : lists[i]) {
+                vector_type r = position1[i] - position2[j];
+                box_->reduce_periodic(r);
+                float_type rr = inner_prod(r, r);
+                if (rr >= rr_max) {
+                    continue;
+                }
+                unsigned int b = species2[j];
+                unsigned int k = min(static_cast<unsigned int>(sqrt(rr) * bin_scale), nbin_ - 1);
+                histogram[(a * nspecies2 + b) * nbin_ + k] += 1;
+                if (reactio) {
+                    histogram[(b * nspecies2 + a) * nbin_ + k] += 1;
+                }
+            }
+        }
+#pragma omp critical
+        transform(histogram_.begin(), histogram_.end(), histogram.begin(), histogram_.begin(), plus<double>());
+    }
+
+    // accumulate pair densities of the ideal gas
+    vector<double> count1(nspecies1, 0);
+    vector<double> count2(nspecies2, 0);
+    for (auto a : species1) {
+        ++count1[a];
+    }
+    for (auto b : species2) {
+        ++count2[b];
+    }
+    double volume = box_->volume();
+    for (unsigned int a = 0; a < nspecies1; ++a) {
+        for (unsigned int b = 0; b < nspecies2; ++b) {
+            double n = (reactio && a == b) ? count2[b] - 1 : count2[b];
+            norm_[a * nspecies2 + b] += count1[a] * n / volume;
+        }
+    }
+
+    ++count_;
+    sample_cache_ = current_state;
+}
+
+template <int dimension, typename float_type>
+typename rdf<dimension, float_type>::result_type const&
+rdf<dimension, float_type>::value()
+{
+    // volume of unit sphere
+    double const unit_volume = (dimension == 3) ? 4 * M_PI / 3 : M_PI;
+    double const dr = r_max_ / nbin_;
+
+    for (unsigned int ab = 0; ab < norm_.size(); ++ab) {
+        for (unsigned int k = 0; k < nbin_; ++k) {
+            double shell = unit_volume * (pow((k + 1) * dr, dimension) - pow(k * dr, dimension));
+            double ideal = norm_[ab] * shell;
+            result_[ab * nbin_ + k] = (ideal > 0) ? histogram_[ab * nbin_ + k] / ideal : 0;
+        }
+    }
+    return result_;
+}
+
+template <int dimension, typename float_type>
+void rdf<dimension, float_type>::reset()
+{
+    fill(histogram_.begin(), histogram_.end(), 0);
+    fill(norm_.begin(), norm_.end(), 0);
+    count_ = 0;
+    sample_cache_ = decltype(sample_cache_)();
+}
+
+template <typename rdf_type>
+static function<typename rdf_type::result_type const& ()>
+wrap_value(shared_ptr<rdf_type> self)
+{
+    return [=]() -> typename rdf_type::result_type const& {
+        return self->value();
+    };
+}
+
+template <typename rdf_type>
+static function<typename rdf_type::position_array_type const& ()>
+wrap_position(shared_ptr<rdf_type const> self)
+{
+    return [=]() -> typename rdf_type::position_array_type const& {
+        return self->position();
+    };
+}
+
+template <int dimension, typename float_type>
+void rdf<dimension, float_type>::luaopen(lua_State* L)
+{
+    using namespace luaponte;
+    module(L, "libhalmd")
+    [
+        namespace_("observables")
+        [
+            namespace_("host")
+            [
+                class_<rdf>()
+                    .def("sample", &rdf::sample)
+                    .def("reset", &rdf::reset)
+                    .property("value", &wrap_value<rdf>)
+                    .property("position", &wrap_position<rdf>)
+                    .property("count", &rdf::count)
+                    .scope
+                    [
+                        class_<runtime>("runtime")
+                            .def_readonly("sample", &runtime::sample)
+                    ]
+                    .def_readonly("runtime", &rdf::runtime_)
+            ]
+          , def("rdf", &make_shared<rdf
+              , pair<shared_ptr<particle_type const>, shared_ptr<particle_type const>>
+              , shared_ptr<box_type const>
+              , shared_ptr<neighbour_type>
+              , double
+              , unsigned int
+              , shared_ptr<logger>
+            >)
+        ]
+    ];
+}
+
+HALMD_LUA_API int luaopen_libhalmd_observables_host_rdf(lua_State* L)
+{
+#ifndef USE_HOST_SINGLE_PRECISION
+    rdf<3, double>::luaopen(L);
+    rdf<2, double>::luaopen(L);
+#else
+    rdf<3, float>::luaopen(L);
+    rdf<2, float>::luaopen(L);
+#endif
+    return 0;
+}
+
+// explicit instantiation
+#ifndef USE_HOST_SINGLE_PRECISION
+template class rdf<3, double>;
+template class rdf<2, double>;
+#else
+template class rdf<3, float>;
+template class rdf<2, float>;
+#endif
+
+} // namespace host
+} // namespace observables
+} // namespace halmd
@@ -0,0 +1,171 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_OBSERVABLES_HOST_RDF_HPP
+#define HALMD_OBSERVABLES_HOST_RDF_HPP
+
+#include <functional>
+#include <lua.hpp>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <halmd/io/logger.hpp>
+#include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/host/neighbour.hpp>
+#include <halmd/mdsim/host/particle.hpp>
+#include <halmd/utility/cache.hpp>
+#include <halmd/utility/profiler.hpp>
+#include <halmd/utility/raw_array.hpp>
+
+namespace halmd {
+namespace observables {
+namespace host {
+
+/**
+ * Compute radial distribution functions from neighbour lists.
+ *
+ * The pair distances are histogrammed for each pair of species (α, β) of the
+ * two particle instances, and the histograms are accumulated over samples.
+ * The partial radial distribution function is obtained by normalisation with
+ * the ideal gas,
+ *
+ * @f$ g_{\alpha\beta}(r) = \frac{\langle H_{\alpha\beta}(r) \rangle}{N_\alpha
+ * (N_\beta - \delta_{\alpha\beta}) / V \cdot \Delta V(r)} @f$,
+ *
+ * where @f$ \Delta V(r) @f$ is the volume of the spherical shell of the bin.
+ *
+ * The neighbour lists contain all pairs within the cutoff radius of the
+ * potential, @f$ r_c @f$, and some, but not all, pairs within @f$ r_c + r_s
+ * @f$ with the neighbour list skin @f$ r_s @f$. The maximum distance of the
+ * histogram must thus not exceed the smallest cutoff radius.
+ */
+template <int dimension, typename float_type>
+class rdf
+{
+public:
+    typedef mdsim::host::particle<dimension, float_type> particle_type;
+    typedef mdsim::host::neighbour neighbour_type;
+    typedef mdsim::box<dimension> box_type;
+    typedef raw_array<double> result_type;
+    typedef std::vector<double> position_array_type;
+
+    /**
+     * Construct radial distribution function of particle pairs in neighbour
+     * lists with a histogram of 'nbin' bins over [0, r_max).
+     */
+    rdf(
+        std::pair<std::shared_ptr<particle_type const>, std::shared_ptr<particle_type const>> particle
+      , std::shared_ptr<box_type const> box
+      , std::shared_ptr<neighbour_type> neighbour
+      , double r_max
+      , unsigned int nbin
+      , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>("rdf")
+    );
+
+    /**
+     * Accumulate histogram of pair distances.
+     *
+     * The sample is skipped if the particle positions and species are unchanged.
+     */
+    void sample();
+
+    /**
+     * Returns radial distribution functions averaged over samples since the
+     * last reset, in row-major order of species pairs and bins.
+     */
+    result_type const& value();
+
+    /**
+     * Discard accumulated samples.
+     */
+    void reset();
+
+    /**
+     * Returns number of accumulated samples.
+     */
+    unsigned int count() const
+    {
+        return count_;
+    }
+
+    /**
+     * Returns bin centres.
+     */
+    position_array_type const& position() const
+    {
+        return position_;
+    }
+
+    /**
+     * Bind class to Lua.
+     */
+    static void luaopen(lua_State* L);
+
+private:
+    typedef typename particle_type::vector_type vector_type;
+    typedef typename particle_type::species_array_type species_array_type;
+
+    /** system state */
+    std::shared_ptr<particle_type const> particle1_;
+    std::shared_ptr<particle_type const> particle2_;
+    /** simulation domain */
+    std::shared_ptr<box_type const> box_;
+    /** neighbour lists */
+    std::shared_ptr<neighbour_type> neighbour_;
+    /** maximum pair distance */
+    double r_max_;
+    /** number of bins */
+    unsigned int nbin_;
+    /** logger instance */
+    std::shared_ptr<logger> logger_;
+
+    /** bin centres */
+    position_array_type position_;
+    /** accumulated histograms of species pairs */
+    std::vector<double> histogram_;
+    /** accumulated ideal gas pair densities of species pairs */
+    std::vector<double> norm_;
+    /** number of accumulated samples */
+    unsigned int count_;
+    /** radial distribution functions */
+    result_type result_;
+
+    /** cache observer of particle positions and species */
+    std::tuple<cache<>, cache<>, cache<>, cache<>> sample_cache_;
+
+    typedef halmd::utility::profiler::accumulator_type accumulator_type;
+    typedef halmd::utility::profiler::scoped_timer_type scoped_timer_type;
+
+    struct runtime
+    {
+        accumulator_type sample;
+    };
+
+    /** profiling runtime accumulators */
+    runtime runtime_;
+};
+
+} // namespace host
+} // namespace observables
+} // namespace halmd
+
+#endif /* ! HALMD_OBSERVABLES_HOST_RDF_HPP */
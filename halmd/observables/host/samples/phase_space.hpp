@@ -133,6 +133,14 @@ public:
         return step_;
     }
 
+    /**
+     * Set simulation step when the sample was taken.
+     */
+    void set_step(step_type step)
+    {
+        step_ = step;
+    }
+
     /**
      * Bind class to Lua.
      */
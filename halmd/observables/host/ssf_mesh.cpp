@@ -0,0 +1,367 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/numeric/accumulator.hpp>
+#include <halmd/observables/host/ssf_mesh.hpp>
+#include <halmd/utility/lua/lua.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace halmd {
+namespace observables {
+namespace host {
+
+/**
+ * Compute weights of assignment function of given order along one axis
+ *
+ * @param u position in units of the mesh spacing
+ * @param order order of assignment function
+ * @param w output array of weights for mesh points first, first+1, …
+ * @returns index of first mesh point
+ */
+static long assignment_weights(double u, unsigned int order, double* w)
+{
+    switch (order) {
+      case 1: {
+        // nearest grid point
+        w[0] = 1;
+        return lround(u);
+      }
+      case 2: {
+        // cloud in cell
+        double i = floor(u);
+        double d = u - i;
+        w[0] = 1 - d;
+        w[1] = d;
+        return i;
+      }
+      case 3: {
+        // triangular shaped cloud
+        double i = round(u);
+        double d = u - i;
+        w[0] = (0.5 - d) * (0.5 - d) / 2;
+        w[1] = 0.75 - d * d;
+        w[2] = (0.5 + d) * (0.5 + d) / 2;
+        return i - 1;
+      }
+      default: {
+        // piecewise cubic spline
+        double i = floor(u);
+        double d = u - i;
+        double d2 = d * d;
+        double d3 = d2 * d;
+        w[0] = (1 - d) * (1 - d) * (1 - d) / 6;
+        w[1] = (4 - 6 * d2 + 3 * d3) / 6;
+        w[2] = (1 + 3 * d + 3 * d2 - 3 * d3) / 6;
+        w[3] = d3 / 6;
+        return i - 1;
+      }
+    }
+}
+
+template <int dimension, typename float_type>
+ssf_mesh<dimension, float_type>::ssf_mesh(
+    shared_ptr<particle_type const> particle
+  , shared_ptr<particle_group_type> particle_group
+  , shared_ptr<wavevector_type const> wavevector
+  , shape_type const& shape
+  , unsigned int order
+  , double norm
+  , shared_ptr<logger> logger
+)
+  // dependency injection
+  : particle_(particle)
+  , particle_group_(particle_group)
+  , wavevector_(wavevector)
+  , shape_(shape)
+  , order_(order)
+  , norm_(norm)
+  , logger_(logger)
+  // initialise members
+  , mesh_(nullptr)
+  , mode_(nullptr)
+  , plan_(nullptr)
+  , result_(wavevector_->wavenumber().size())
+{
+    if (order_ < 1 || order_ > 4) {
+        throw invalid_argument("order of assignment function must be 1, 2, 3, or 4");
+    }
+    size_t nreal = 1;
+    size_t ncomplex = 1;
+    int n[dimension];
+    for (int j = 0; j < dimension; ++j) {
+        if (shape_[j] < order_) {
+            throw invalid_argument("mesh must have at least as many points per axis as the order of the assignment function");
+        }
+        n[j] = shape_[j];
+        nreal *= shape_[j];
+        ncomplex *= (j < dimension - 1) ? shape_[j] : shape_[j] / 2 + 1;
+    }
+
+    mesh_ = fftw_alloc_real(nreal);
+    mode_ = fftw_alloc_complex(ncomplex);
+    if (!mesh_ || !mode_) {
+        fftw_free(mesh_);
+        fftw_free(mode_);
+        throw bad_alloc();
+    }
+    // planning with FFTW_ESTIMATE leaves the arrays untouched and is fast
+    plan_ = fftw_plan_dft_r2c(dimension, n, mesh_, mode_, FFTW_ESTIMATE);
+    grid_.resize(ncomplex);
+
+    LOG("mesh points per axis: " << shape_);
+    LOG("order of assignment function: " << order_);
+    LOG("normalisation factor: " << norm_);
+
+    // warn about wavenumbers beyond the Nyquist limit of the mesh
+    auto const& wavenumber = wavevector_->wavenumber();
+    auto const& box_length = wavevector_->box_length();
+    for (int j = 0; j < dimension; ++j) {
+        double q_nyquist = M_PI * shape_[j] / box_length[j];
+        if (!wavenumber.empty() && wavenumber.back() > q_nyquist) {
+            LOG_WARNING("maximum wavenumber exceeds Nyquist wavenumber " << q_nyquist << " along axis " << j);
+        }
+    }
+}
+
+template <int dimension, typename float_type>
+ssf_mesh<dimension, float_type>::~ssf_mesh()
+{
+    fftw_destroy_plan(plan_);
+    fftw_free(mode_);
+    fftw_free(mesh_);
+}
+
+template <int dimension, typename float_type>
+typename ssf_mesh<dimension, float_type>::result_type const&
+ssf_mesh<dimension, float_type>::sample()
+{
+    // check validity of caches
+    auto const& group_cache = particle_group_->ordered();
+    auto const& position_cache = particle_->position();
+
+    if (group_cache_ != group_cache || position_cache_ != position_cache) {
+        LOG_TRACE("sampling");
+
+        scoped_timer_type timer(runtime_.sample);
+
+        assign_();
+        {
+            scoped_timer_type timer(runtime_.fft);
+            fftw_execute(plan_);
+        }
+        reduce_();
+
+        // update cache observers
+        group_cache_ = group_cache;
+        position_cache_ = position_cache;
+    }
+    return result_;
+}
+
+/**
+ * Assign particles of group to density mesh
+ */
+template <int dimension, typename float_type>
+void ssf_mesh<dimension, float_type>::assign_()
+{
+    auto const& group = read_cache(particle_group_->ordered());
+    auto const& position = read_cache(particle_->position());
+    auto const& box_length = wavevector_->box_length();
+
+    scoped_timer_type timer(runtime_.assign);
+
+    size_t nreal = 1;
+    for (int j = 0; j < dimension; ++j) {
+        nreal *= shape_[j];
+    }
+    fill(mesh_, mesh_ + nreal, 0.);
+
+    unsigned int nstencil = 1;
+    for (int j = 0; j < dimension; ++j) {
+        nstencil *= order_;
+    }
+
+    for (auto i : group) {
+        vector_type const& r = position[i];
+        double w[dimension][4];
+        long first[dimension];
+        for (int j = 0; j < dimension; ++j) {
+            double u = (r[j] / box_length[j] + 0.5) * shape_[j];
+            first[j] = assignment_weights(u, order_, w[j]);
+        }
+        // iterate over stencil of order^dimension mesh points
+        for (unsigned int k = 0; k < nstencil; ++k) {
+            size_t offset = 0;
+            double weight = 1;
+            unsigned int m = k;
+            for (int j = 0; j < dimension; ++j) {
+                unsigned int a = m % order_;
+                m /= order_;
+                long M = shape_[j];
+                long x = ((first[j] + a) % M + M) % M;
+                offset = offset * M + x;
+                weight *= w[j][a];
+            }
+            mesh_[offset] += weight;
+        }
+    }
+}
+
+/**
+ * Compute structure factor on reciprocal mesh and average over shells
+ */
+template <int dimension, typename float_type>
+void ssf_mesh<dimension, float_type>::reduce_()
+{
+    auto const& box_length = wavevector_->box_length();
+    auto const& wavenumber = wavevector_->wavenumber();
+    double tolerance = wavevector_->tolerance();
+
+    // extents of the output of the real-to-complex transform
+    fixed_vector<long, dimension> extent;
+    for (int j = 0; j < dimension; ++j) {
+        extent[j] = (j < dimension - 1) ? shape_[j] : shape_[j] / 2 + 1;
+    }
+    long const size = grid_.size();
+
+    // map flat index of transform output to wavevector and multiplicity,
+    // counting the omitted complex conjugate of the last axis
+    auto wavevector = [&](long k, unsigned int& multiplicity) {
+        fixed_vector<double, dimension> q;
+        double window = 1;
+        for (int j = dimension - 1; j >= 0; --j) {
+            long M = shape_[j];
+            long x = k % extent[j];
+            k /= extent[j];
+            if (j == dimension - 1) {
+                multiplicity = (x > 0 && 2 * x != M) ? 2 : 1;
+            }
+            long n = (2 * x < M) ? x : x - M;
+            q[j] = 2 * M_PI * n / box_length[j];
+            // Fourier transform of assignment function
+            double arg = M_PI * n / M;
+            window *= (n != 0) ? pow(sin(arg) / arg, int(order_)) : 1;
+        }
+        return make_pair(q, window);
+    };
+
+#pragma omp parallel for
+    for (long k = 0; k < size; ++k) {
+        unsigned int multiplicity;
+        double window = wavevector(k, multiplicity).second;
+        double re = mode_[k][0];
+        double im = mode_[k][1];
+        grid_[k] = (re * re + im * im) / (norm_ * window * window);
+    }
+
+    // average over wavevectors of similar magnitude
+    vector<accumulator<double>> acc(wavenumber.size());
+    for (long k = 0; k < size; ++k) {
+        unsigned int multiplicity;
+        double q = norm_2(wavevector(k, multiplicity).first);
+        // find wavenumber shells containing q within relative tolerance
+        auto first = lower_bound(wavenumber.begin(), wavenumber.end(), q / (1 + tolerance));
+        for (auto it = first; it != wavenumber.end() && *it <= q / (1 - tolerance); ++it) {
+            auto& a = acc[it - wavenumber.begin()];
+            for (unsigned int m = 0; m < multiplicity; ++m) {
+                a(grid_[k]);
+            }
+        }
+    }
+
+    // transform accumulators to array (mean, error_of_mean, count)
+    auto result = begin(result_);
+    for (auto const& a : acc) {
+        *result++ = {{
+            count(a) > 0 ? mean(a) : 0
+          , count(a) > 1 ? error_of_mean(a) : 0
+          , static_cast<double>(count(a))
+        }};
+    }
+}
+
+template <int dimension, typename float_type>
+void ssf_mesh<dimension, float_type>::luaopen(lua_State* L)
+{
+    using namespace luaponte;
+    module(L, "libhalmd")
+    [
+        namespace_("observables")
+        [
+            namespace_("host")
+            [
+                class_<ssf_mesh>()
+                    .property("sampler", &ssf_mesh::sampler)
+                    .property("grid_sampler", &ssf_mesh::grid_sampler)
+                    .property("shape", &ssf_mesh::shape)
+                    .property("order", &ssf_mesh::order)
+                    .scope
+                    [
+                        class_<runtime>("runtime")
+                            .def_readonly("sample", &runtime::sample)
+                            .def_readonly("assign", &runtime::assign)
+                            .def_readonly("fft", &runtime::fft)
+                    ]
+                    .def_readonly("runtime", &ssf_mesh::runtime_)
+            ]
+          , def("ssf_mesh", &make_shared<ssf_mesh
+              , shared_ptr<particle_type const>
+              , shared_ptr<particle_group_type>
+              , shared_ptr<wavevector_type const>
+              , shape_type const&
+              , unsigned int
+              , double
+              , shared_ptr<logger>
+            >)
+        ]
+    ];
+}
+
+HALMD_LUA_API int luaopen_libhalmd_observables_host_ssf_mesh(lua_State* L)
+{
+#ifndef USE_HOST_SINGLE_PRECISION
+    ssf_mesh<3, double>::luaopen(L);
+    ssf_mesh<2, double>::luaopen(L);
+#else
+    ssf_mesh<3, float>::luaopen(L);
+    ssf_mesh<2, float>::luaopen(L);
+#endif
+    return 0;
+}
+
+// explicit instantiation
+#ifndef USE_HOST_SINGLE_PRECISION
+template class ssf_mesh<3, double>;
+template class ssf_mesh<2, double>;
+#else
+template class ssf_mesh<3, float>;
+template class ssf_mesh<2, float>;
+#endif
+
+} // namespace host
+} // namespace observables
+} // namespace halmd
@@ -0,0 +1,213 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_OBSERVABLES_HOST_SSF_MESH_HPP
+#define HALMD_OBSERVABLES_HOST_SSF_MESH_HPP
+
+#include <boost/array.hpp>
+#include <fftw3.h>
+#include <functional>
+#include <lua.hpp>
+#include <memory>
+
+#include <halmd/io/logger.hpp>
+#include <halmd/mdsim/host/particle.hpp>
+#include <halmd/mdsim/host/particle_group.hpp>
+#include <halmd/numeric/blas/fixed_vector.hpp>
+#include <halmd/observables/utility/wavevector.hpp>
+#include <halmd/utility/cache.hpp>
+#include <halmd/utility/profiler.hpp>
+#include <halmd/utility/raw_array.hpp>
+
+namespace halmd {
+namespace observables {
+namespace host {
+
+/**
+ * Compute static structure factor on the reciprocal lattice of a mesh.
+ *
+ * The particles are assigned to a regular mesh by a charge assignment
+ * function of order p (1: nearest grid point, 2: cloud in cell, 3: triangular
+ * shaped cloud, 4: piecewise cubic), and the mesh density is transformed by a
+ * real-to-complex FFT. The structure factor
+ *
+ * @f$ S(\vec q) = |\rho_{\vec q}|^2 / (N\, W(\vec q)^2) @f$
+ *
+ * is corrected for the Fourier transform of the assignment function,
+ * @f$ W(\vec q) = \prod_\alpha \mathrm{sinc}(q_\alpha h_\alpha / 2)^p @f$,
+ * with mesh spacing @f$ h_\alpha @f$. The cost is O(N + M log M) for M mesh
+ * points, and the result is valid for wavenumbers well below the Nyquist
+ * wavenumber @f$ \pi / h_\alpha @f$.
+ *
+ * The full grid is available in the layout of the real-to-complex FFT, i.e.,
+ * in row-major order with the last axis truncated to @f$ M_d / 2 + 1 @f$
+ * points; the remaining half follows from @f$ S(-\vec q) = S(\vec q) @f$.
+ * Shell averages are computed for the wavenumbers and the relative tolerance
+ * of the given wavevector instance, taking into account all mesh wavevectors.
+ */
+template <int dimension, typename float_type>
+class ssf_mesh
+{
+public:
+    typedef mdsim::host::particle<dimension, float_type> particle_type;
+    typedef mdsim::host::particle_group particle_group_type;
+    typedef observables::utility::wavevector<dimension> wavevector_type;
+    typedef raw_array<boost::array<double, 3>> result_type;
+    typedef raw_array<double> grid_type;
+    typedef fixed_vector<unsigned int, dimension> shape_type;
+
+    /**
+     * Construct structure factor on mesh of given shape.
+     *
+     * The argument 'norm' is the normalisation factor (e.g. total number of particles).
+     */
+    ssf_mesh(
+        std::shared_ptr<particle_type const> particle
+      , std::shared_ptr<particle_group_type> particle_group
+      , std::shared_ptr<wavevector_type const> wavevector
+      , shape_type const& shape
+      , unsigned int order
+      , double norm
+      , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>("ssf_mesh")
+    );
+
+    /**
+     * Release FFT plan and mesh arrays.
+     */
+    ~ssf_mesh();
+
+    /** deleted implicit copy constructor */
+    ssf_mesh(ssf_mesh const&) = delete;
+    /** deleted implicit assignment operator */
+    ssf_mesh& operator=(ssf_mesh const&) = delete;
+
+    /**
+     * Compute shell averages of static structure factor from particle
+     * positions.
+     *
+     * The result is re-computed only if the particle positions or the
+     * particle group have been modified.
+     */
+    result_type const& sample();
+
+    /**
+     * Compute static structure factor on the full mesh.
+     */
+    grid_type const& grid()
+    {
+        sample();
+        return grid_;
+    }
+
+    /**
+     * Functor wrapping sample() for class instance stored within std::shared_ptr
+     */
+    static std::function<result_type const& ()> sampler(std::shared_ptr<ssf_mesh> self)
+    {
+        return [=]() -> result_type const& {
+            return self->sample();
+        };
+    }
+
+    /**
+     * Functor wrapping grid() for class instance stored within std::shared_ptr
+     */
+    static std::function<grid_type const& ()> grid_sampler(std::shared_ptr<ssf_mesh> self)
+    {
+        return [=]() -> grid_type const& {
+            return self->grid();
+        };
+    }
+
+    /** returns number of mesh points per axis */
+    shape_type const& shape() const
+    {
+        return shape_;
+    }
+
+    /** returns order of assignment function */
+    unsigned int order() const
+    {
+        return order_;
+    }
+
+    /**
+     * Bind class to Lua.
+     */
+    static void luaopen(lua_State* L);
+
+private:
+    typedef typename particle_type::vector_type vector_type;
+
+    /** assign particles to density mesh */
+    void assign_();
+    /** compute structure factor on mesh and shell averages */
+    void reduce_();
+
+    /** system state */
+    std::shared_ptr<particle_type const> particle_;
+    /** particle group */
+    std::shared_ptr<particle_group_type> particle_group_;
+    /** wavenumber grid and box edge lengths */
+    std::shared_ptr<wavevector_type const> wavevector_;
+    /** number of mesh points per axis */
+    shape_type shape_;
+    /** order of assignment function */
+    unsigned int order_;
+    /** normalisation factor */
+    double norm_;
+    /** logger instance */
+    std::shared_ptr<logger> logger_;
+
+    /** density mesh */
+    double* mesh_;
+    /** Fourier transform of density mesh */
+    fftw_complex* mode_;
+    /** FFT plan */
+    fftw_plan plan_;
+
+    /** structure factor on reciprocal mesh */
+    grid_type grid_;
+    /** cached shell averages of structure factor */
+    result_type result_;
+
+    /** cache observers of particle group and positions */
+    cache<> group_cache_;
+    cache<> position_cache_;
+
+    typedef halmd::utility::profiler::accumulator_type accumulator_type;
+    typedef halmd::utility::profiler::scoped_timer_type scoped_timer_type;
+
+    struct runtime
+    {
+        accumulator_type sample;
+        accumulator_type assign;
+        accumulator_type fft;
+    };
+
+    /** profiling runtime accumulators */
+    runtime runtime_;
+};
+
+} // namespace host
+} // namespace observables
+} // namespace halmd
+
+#endif /* ! HALMD_OBSERVABLES_HOST_SSF_MESH_HPP */
@@ -38,6 +38,7 @@ thermodynamics<dimension, float_type>::thermodynamics(
   , group_(group)
   , box_(box)
   , logger_(logger)
+  , enabled_(0)
 {
 }
 
@@ -61,10 +62,7 @@ double thermodynamics<dimension, float_type>::en_kin()
     cache<size_type> const& group_cache = group_->size();
 
     if (en_kin_cache_ != std::tie(velocity_cache, mass_cache, group_cache)) {
-        LOG_TRACE("acquire kinetic energy");
-        scoped_timer_type timer(runtime_.en_kin);
-        en_kin_ = get_mean_en_kin(*particle_, *group_);
-        en_kin_cache_ = std::tie(velocity_cache, mass_cache, group_cache);
+        sample_(EN_KIN);
     }
     return en_kin_;
 }
@@ -78,10 +76,7 @@ thermodynamics<dimension, float_type>::v_cm()
     cache<size_type> const& group_cache = group_->size();
 
     if (v_cm_cache_ != std::tie(velocity_cache, mass_cache, group_cache)) {
-        LOG_TRACE("acquire centre-of-mass velocity");
-        scoped_timer_type timer(runtime_.v_cm);
-        std::tie(v_cm_, mean_mass_) = get_v_cm_and_mean_mass(*particle_, *group_);
-        v_cm_cache_ = std::tie(velocity_cache, mass_cache, group_cache);
+        sample_(V_CM);
     }
     return v_cm_;
 }
@@ -90,15 +85,12 @@ template <int dimension, typename float_type>
 typename thermodynamics<dimension, float_type>::vector_type const&
 thermodynamics<dimension, float_type>::r_cm()
 {
-    cache<velocity_array_type> const& position_cache = particle_->position();
+    cache<position_array_type> const& position_cache = particle_->position();
     cache<mass_array_type> const& mass_cache = particle_->mass();
     cache<size_type> const& group_cache = group_->size();
 
     if (r_cm_cache_ != std::tie(position_cache, mass_cache, group_cache)) {
-        LOG_TRACE("acquire centre of mass");
-        scoped_timer_type timer(runtime_.r_cm);
-        r_cm_ = get_r_cm(*particle_, *group_, *box_);
-        r_cm_cache_ = std::tie(position_cache, mass_cache, group_cache);
+        sample_(R_CM);
     }
     return r_cm_;
 }
@@ -111,10 +103,7 @@ double thermodynamics<dimension, float_type>::mean_mass()
     cache<size_type> const& group_cache = group_->size();
 
     if (v_cm_cache_ != std::tie(velocity_cache, mass_cache, group_cache)) {
-        LOG_TRACE("acquire mean particle mass");
-        scoped_timer_type timer(runtime_.v_cm);
-        std::tie(v_cm_, mean_mass_) = get_v_cm_and_mean_mass(*particle_, *group_);
-        v_cm_cache_ = std::tie(velocity_cache, mass_cache, group_cache);
+        sample_(V_CM);
     }
     return mean_mass_;
 }
@@ -122,14 +111,19 @@ double thermodynamics<dimension, float_type>::mean_mass()
 template <int dimension, typename float_type>
 double thermodynamics<dimension, float_type>::en_pot()
 {
-    cache<en_pot_array_type> const& en_pot_cache = particle_->potential_energy();
     cache<size_type> const& group_cache = group_->size();
 
-    if (en_pot_cache_ != std::tie(en_pot_cache, group_cache)) {
-        LOG_TRACE("acquire potential energy");
-        scoped_timer_type timer(runtime_.en_pot);
-        en_pot_ = get_mean_en_pot(*particle_, *group_);
-        en_pot_cache_ = std::tie(en_pot_cache, group_cache);
+    if (complete_()) {
+        cache<en_pot_sum_type> const& en_pot_cache = particle_->potential_energy_sum();
+        if (en_pot_cache_ != std::tie(en_pot_cache, group_cache)) {
+            sample_(EN_POT);
+        }
+    }
+    else {
+        cache<en_pot_array_type> const& en_pot_cache = particle_->potential_energy();
+        if (en_pot_cache_ != std::tie(en_pot_cache, group_cache)) {
+            sample_(EN_POT);
+        }
     }
     return en_pot_;
 }
@@ -137,14 +131,19 @@ double thermodynamics<dimension, float_type>::en_pot()
 template <int dimension, typename float_type>
 double thermodynamics<dimension, float_type>::virial()
 {
-    cache<stress_pot_array_type> const& stress_pot_cache = particle_->stress_pot();
     cache<size_type> const& group_cache = group_->size();
 
-    if (virial_cache_ != std::tie(stress_pot_cache, group_cache)) {
-        LOG_TRACE("acquire virial");
-        scoped_timer_type timer(runtime_.virial);
-        virial_ = get_mean_virial(*particle_, *group_);
-        virial_cache_ = std::tie(stress_pot_cache, group_cache);
+    if (complete_()) {
+        cache<stress_pot_sum_type> const& stress_pot_cache = particle_->stress_pot_sum();
+        if (virial_cache_ != std::tie(stress_pot_cache, group_cache)) {
+            sample_(VIRIAL);
+        }
+    }
+    else {
+        cache<stress_pot_array_type> const& stress_pot_cache = particle_->stress_pot();
+        if (virial_cache_ != std::tie(stress_pot_cache, group_cache)) {
+            sample_(VIRIAL);
+        }
     }
     return virial_;
 }
@@ -153,19 +152,224 @@ template <int dimension, typename float_type>
 typename thermodynamics<dimension, float_type>::stress_tensor_type const&
 thermodynamics<dimension, float_type>::stress_tensor()
 {
-    cache<stress_pot_array_type> const& stress_pot_cache = particle_->stress_pot();
     cache<velocity_array_type> const& velocity_cache = particle_->velocity();
     cache<size_type> const& group_cache = group_->size();
 
-    if (stress_tensor_cache_ != std::tie(stress_pot_cache, velocity_cache, group_cache)) {
-        LOG_TRACE("acquire stress tensor");
-        scoped_timer_type timer(runtime_.stress_tensor);
-        stress_tensor_ = get_stress_tensor(*particle_, *group_);
-        stress_tensor_cache_ = std::tie(stress_pot_cache, velocity_cache, group_cache);
+    if (complete_()) {
+        cache<stress_pot_sum_type> const& stress_pot_cache = particle_->stress_pot_sum();
+        if (stress_tensor_cache_ != std::tie(stress_pot_cache, velocity_cache, group_cache)) {
+            sample_(STRESS_TENSOR);
+        }
+    }
+    else {
+        cache<stress_pot_array_type> const& stress_pot_cache = particle_->stress_pot();
+        if (stress_tensor_cache_ != std::tie(stress_pot_cache, velocity_cache, group_cache)) {
+            sample_(STRESS_TENSOR);
+        }
     }
     return stress_tensor_;
 }
 
+template <int dimension, typename float_type>
+void thermodynamics<dimension, float_type>::aux_enable()
+{
+    if (complete_()) {
+        particle_->aux_sum_enable();
+    }
+    else {
+        particle_->aux_enable();
+    }
+}
+
+template <int dimension, typename float_type>
+void thermodynamics<dimension, float_type>::sample_(unsigned int request)
+{
+    enabled_ |= request;
+
+    cache<position_array_type> const& position_cache = particle_->position();
+    cache<velocity_array_type> const& velocity_cache = particle_->velocity();
+    cache<mass_array_type> const& mass_cache = particle_->mass();
+    cache<size_type> const& group_cache = group_->size();
+
+    // select outdated state variables
+    unsigned int outdated = 0;
+    if ((enabled_ & EN_KIN) && en_kin_cache_ != std::tie(velocity_cache, mass_cache, group_cache)) {
+        outdated |= EN_KIN;
+    }
+    if ((enabled_ & V_CM) && v_cm_cache_ != std::tie(velocity_cache, mass_cache, group_cache)) {
+        outdated |= V_CM;
+    }
+    if ((enabled_ & R_CM) && r_cm_cache_ != std::tie(position_cache, mass_cache, group_cache)) {
+        outdated |= R_CM;
+    }
+    // reading the auxiliary variables triggers a force computation if they are dirty
+    bool const complete = complete_();
+    bool const aux_dirty = complete ? particle_->aux_sum_dirty() : particle_->aux_dirty();
+    bool const aux = (request & (EN_POT | VIRIAL | STRESS_TENSOR)) || !aux_dirty;
+    if (aux && complete) {
+        cache<en_pot_sum_type> const& en_pot_cache = particle_->potential_energy_sum();
+        cache<stress_pot_sum_type> const& stress_pot_cache = particle_->stress_pot_sum();
+        if ((enabled_ & EN_POT) && en_pot_cache_ != std::tie(en_pot_cache, group_cache)) {
+            outdated |= EN_POT;
+        }
+        if ((enabled_ & VIRIAL) && virial_cache_ != std::tie(stress_pot_cache, group_cache)) {
+            outdated |= VIRIAL;
+        }
+        if ((enabled_ & STRESS_TENSOR) && stress_tensor_cache_ != std::tie(stress_pot_cache, velocity_cache, group_cache)) {
+            outdated |= STRESS_TENSOR;
+        }
+    }
+    else if (aux) {
+        cache<en_pot_array_type> const& en_pot_cache = particle_->potential_energy();
+        cache<stress_pot_array_type> const& stress_pot_cache = particle_->stress_pot();
+        if ((enabled_ & EN_POT) && en_pot_cache_ != std::tie(en_pot_cache, group_cache)) {
+            outdated |= EN_POT;
+        }
+        if ((enabled_ & VIRIAL) && virial_cache_ != std::tie(stress_pot_cache, group_cache)) {
+            outdated |= VIRIAL;
+        }
+        if ((enabled_ & STRESS_TENSOR) && stress_tensor_cache_ != std::tie(stress_pot_cache, velocity_cache, group_cache)) {
+            outdated |= STRESS_TENSOR;
+        }
+    }
+
+    LOG_TRACE("acquire thermodynamic state variables (mask: " << outdated << ")");
+    scoped_timer_type timer(runtime_.reduce);
+
+    group_array_type const& unordered = read_cache(group_->unordered());
+    auto const& position = read_cache(position_cache);
+    auto const& image = read_cache(particle_->image());
+    velocity_array_type const& velocity = read_cache(velocity_cache);
+    mass_array_type const& mass = read_cache(mass_cache);
+    en_pot_array_type const* en_pot = nullptr;
+    stress_pot_array_type const* stress_pot = nullptr;
+    if (!complete && (outdated & EN_POT)) {
+        en_pot = &read_cache(particle_->potential_energy());
+    }
+    if (!complete && (outdated & (VIRIAL | STRESS_TENSOR))) {
+        stress_pot = &read_cache(particle_->stress_pot());
+    }
+
+    // accumulate the sums of all outdated state variables in a single sweep
+    double mv2 = 0;
+    double m = 0;
+    vector_type mv = 0;
+    vector_type mr = 0;
+    double en_pot_sum = 0;
+    double virial_sum = 0;
+    stress_tensor_type stress_sum = 0;
+
+    long const size = unordered.size();
+#pragma omp parallel
+    {
+        double mv2_thread = 0;
+        double m_thread = 0;
+        vector_type mv_thread = 0;
+        vector_type mr_thread = 0;
+        double en_pot_thread = 0;
+        double virial_thread = 0;
+        stress_tensor_type stress_tensor_thread = 0;
+
+#pragma omp for
+        for (long j = 0; j < size; ++j) {
+            size_type i = unordered[j];
+            m_thread += mass[i];
+            if (outdated & EN_KIN) {
+                mv2_thread += mass[i] * inner_prod(velocity[i], velocity[i]);
+            }
+            if (outdated & V_CM) {
+                mv_thread += mass[i] * velocity[i];
+            }
+            if (outdated & R_CM) {
+                auto r = position[i];
+                box_->extend_periodic(r, image[i]);
+                mr_thread += mass[i] * r;
+            }
+            if (en_pot) {
+                en_pot_thread += (*en_pot)[i];
+            }
+            if (stress_pot && (outdated & VIRIAL)) {
+                // compute trace of the stress tensor
+                for (int k = 0; k < dimension; ++k) {
+                    virial_thread += (*stress_pot)[i][k];
+                }
+            }
+            if (outdated & STRESS_TENSOR) {
+                stress_tensor_type stress_kin = mass[i] * mdsim::make_stress_tensor(velocity[i]);
+                stress_tensor_thread += stress_kin;
+                if (stress_pot) {
+                    stress_tensor_thread += (*stress_pot)[i];
+                }
+            }
+        }
+
+#pragma omp critical
+        {
+            mv2 += mv2_thread;
+            m += m_thread;
+            mv += mv_thread;
+            mr += mr_thread;
+            en_pot_sum += en_pot_thread;
+            virial_sum += virial_thread;
+            stress_sum += stress_tensor_thread;
+        }
+    }
+
+    // add the sums of the auxiliary variables over all particles
+    if (complete && (outdated & EN_POT)) {
+        en_pot_sum = read_cache(particle_->potential_energy_sum());
+    }
+    if (complete && (outdated & (VIRIAL | STRESS_TENSOR))) {
+        stress_pot_sum_type const& stress_pot_sum = read_cache(particle_->stress_pot_sum());
+        for (int k = 0; k < dimension; ++k) {
+            virial_sum += stress_pot_sum[k];
+        }
+        stress_sum += stress_pot_sum;
+    }
+
+    // store results and update all individual caches
+    if (outdated & EN_KIN) {
+        en_kin_ = 0.5 * mv2 / size;
+        en_kin_cache_ = std::tie(velocity_cache, mass_cache, group_cache);
+    }
+    if (outdated & V_CM) {
+        v_cm_ = mv / m;
+        mean_mass_ = m / size;
+        v_cm_cache_ = std::tie(velocity_cache, mass_cache, group_cache);
+    }
+    if (outdated & R_CM) {
+        r_cm_ = mr / m;
+        r_cm_cache_ = std::tie(position_cache, mass_cache, group_cache);
+    }
+    if (outdated & EN_POT) {
+        en_pot_ = en_pot_sum / size;
+        if (complete) {
+            en_pot_cache_ = std::tie(particle_->potential_energy_sum(), group_cache);
+        }
+        else {
+            en_pot_cache_ = std::tie(particle_->potential_energy(), group_cache);
+        }
+    }
+    if (outdated & VIRIAL) {
+        virial_ = virial_sum / size;
+        if (complete) {
+            virial_cache_ = std::tie(particle_->stress_pot_sum(), group_cache);
+        }
+        else {
+            virial_cache_ = std::tie(particle_->stress_pot(), group_cache);
+        }
+    }
+    if (outdated & STRESS_TENSOR) {
+        stress_tensor_ = stress_sum;
+        if (complete) {
+            stress_tensor_cache_ = std::tie(particle_->stress_pot_sum(), velocity_cache, group_cache);
+        }
+        else {
+            stress_tensor_cache_ = std::tie(particle_->stress_pot(), velocity_cache, group_cache);
+        }
+    }
+}
+
 template <int dimension, typename float_type>
 void thermodynamics<dimension, float_type>::luaopen(lua_State* L)
 {
@@ -178,12 +382,7 @@ void thermodynamics<dimension, float_type>::luaopen(lua_State* L)
                 .scope
                 [
                     class_<runtime>("runtime")
-                        .def_readonly("en_kin", &runtime::en_kin)
-                        .def_readonly("v_cm", &runtime::v_cm)
-                        .def_readonly("r_cm", &runtime::r_cm)
-                        .def_readonly("en_pot", &runtime::en_pot)
-                        .def_readonly("virial", &runtime::virial)
-                        .def_readonly("stress_tensor", &runtime::stress_tensor)
+                        .def_readonly("reduce", &runtime::reduce)
                 ]
                 .def_readonly("runtime", &thermodynamics::runtime_)
 
@@ -108,16 +108,60 @@ public:
      */
     virtual stress_tensor_type const& stress_tensor();
 
+    /**
+     * Enable computation of auxiliary variables in the next force computation.
+     *
+     * For a group of all particles, only the sums over all particles are
+     * requested.
+     */
+    virtual void aux_enable();
+
 private:
     typedef typename particle_type::size_type size_type;
+    typedef typename particle_type::position_array_type position_array_type;
     typedef typename particle_type::velocity_array_type velocity_array_type;
     typedef typename particle_type::velocity_type velocity_type;
     typedef typename particle_type::mass_array_type mass_array_type;
     typedef typename particle_type::mass_type mass_type;
     typedef typename particle_type::en_pot_array_type en_pot_array_type;
     typedef typename particle_type::stress_pot_array_type stress_pot_array_type;
+    typedef typename particle_type::en_pot_sum_type en_pot_sum_type;
+    typedef typename particle_type::stress_pot_sum_type stress_pot_sum_type;
     typedef typename particle_group_type::array_type group_array_type;
 
+    /** flags of state variables computed in a single sweep */
+    enum {
+        EN_KIN = 1
+      , V_CM = 2
+      , R_CM = 4
+      , EN_POT = 8
+      , VIRIAL = 16
+      , STRESS_TENSOR = 32
+    };
+
+    /**
+     * Compute the requested state variables and all other outdated state
+     * variables that have been requested before in a single sweep over the
+     * particles of the group.
+     *
+     * State variables that depend on the auxiliary variables are included
+     * only if requested or if the auxiliary variables are up to date, in
+     * order to avoid an additional force computation.
+     */
+    void sample_(unsigned int request);
+
+    /**
+     * Returns true if the group comprises all particles.
+     *
+     * The state variables that depend on the auxiliary variables are then
+     * obtained from the sums over all particles computed by the force
+     * modules, which do not require the per-particle arrays.
+     */
+    bool complete_()
+    {
+        return *group_->size() == particle_->nparticle();
+    }
+
     /** system state */
     std::shared_ptr<particle_type> particle_;
     /** particle group */
@@ -141,6 +185,8 @@ private:
     double virial_;
     /** mean stress tensor elements per particle */
     stress_tensor_type stress_tensor_;
+    /** flags of state variables that have been requested */
+    unsigned int enabled_;
 
     /** cache observers of mean kinetic energy per particle */
     std::tuple<cache<>, cache<>, cache<>> en_kin_cache_;
@@ -160,12 +206,7 @@ private:
 
     struct runtime
     {
-        accumulator_type en_kin;
-        accumulator_type v_cm;
-        accumulator_type r_cm;
-        accumulator_type en_pot;
-        accumulator_type virial;
-        accumulator_type stress_tensor;
+        accumulator_type reduce;
     };
 
     /** profiling runtime accumulators */
@@ -56,12 +56,16 @@ HALMD_LUA_API int luaopen_libhalmd_observables_samples_blocking_scheme(lua_State
     ];
     blocking_scheme<luaponte::object>::luaopen(L);
     blocking_scheme<raw_array<fixed_vector<double, 2>>>::luaopen(L);
+    blocking_scheme<fixed_vector<double, 3>>::luaopen(L);
+    blocking_scheme<fixed_vector<double, 1>>::luaopen(L);
     return 0;
 }
 
 // explicit instantiation
 template class blocking_scheme<luaponte::object>;
 template class blocking_scheme<raw_array<fixed_vector<double, 2>>>;
+template class blocking_scheme<fixed_vector<double, 3>>;
+template class blocking_scheme<fixed_vector<double, 1>>;
 
 } // namespace samples
 } // namespace observables
@@ -141,6 +141,15 @@ wrap_stress_tensor(std::shared_ptr<thermodynamics_type> self)
     };
 }
 
+template <typename thermodynamics_type>
+static std::function<void ()>
+wrap_aux_enable(std::shared_ptr<thermodynamics_type> self)
+{
+    return [=]() {
+        self->aux_enable();
+    };
+}
+
 template <int dimension>
 void thermodynamics<dimension>::luaopen(lua_State* L)
 {
@@ -161,6 +170,7 @@ void thermodynamics<dimension>::luaopen(lua_State* L)
             .property("mean_mass", &wrap_mean_mass<thermodynamics>)
             .property("virial", &wrap_virial<thermodynamics>)
             .property("stress_tensor", &wrap_stress_tensor<thermodynamics>)
+            .property("aux_enable", &wrap_aux_enable<thermodynamics>)
     ];
 }
 
@@ -71,6 +71,8 @@ public:
     virtual double virial() = 0;
     /** (symmetric) stress tensor */
     virtual stress_tensor_type const& stress_tensor() = 0;
+    /** enable auxiliary variables for the next force computation */
+    virtual void aux_enable() = 0;
 
     // compute derived quantities on the fly
 
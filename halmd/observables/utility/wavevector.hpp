@@ -80,6 +80,12 @@ public:
         return wavenumber_;
     }
 
+    //! returns edge lengths of simulation box
+    vector_type const& box_length() const
+    {
+        return box_length_;
+    }
+
     /*
      * returns list of wavevector shells
      *
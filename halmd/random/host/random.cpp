@@ -20,6 +20,8 @@
  */
 
 #include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <vector>
 
 #include <halmd/io/logger.hpp>
@@ -44,6 +46,23 @@ void random::seed(unsigned int seed)
     rng_.seed(seed);
 }
 
+std::string random::state() const
+{
+    std::ostringstream stream;
+    stream << rng_;
+    return stream.str();
+}
+
+void random::set_state(std::string const& state)
+{
+    std::istringstream stream(state);
+    stream >> rng_;
+    if (stream.fail()) {
+        throw std::invalid_argument("invalid state of random number generator");
+    }
+    LOG("restore RNG state");
+}
+
 /**
  * shuffle sequence of abstract Lua type (number, table, userdata, …)
  * and returned shuffled sequence
@@ -69,6 +88,8 @@ void random::luaopen(lua_State* L)
                     .def(constructor<>())
                     .def(constructor<unsigned int>())
                     .def("seed", &random::seed)
+                    .property("state", &random::state)
+                    .def("set_state", &random::set_state)
                     .def("shuffle", &wrap_shuffle)
 //                    .def("shuffle", &wrap_shuffle, out_value(_2)) FIXME does not compile
             ]
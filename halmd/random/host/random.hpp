@@ -29,6 +29,7 @@
 #include <boost/random/variate_generator.hpp>
 #include <lua.hpp>
 #include <iterator>
+#include <string>
 #include <utility>
 
 #include <halmd/numeric/blas/fixed_vector.hpp>
@@ -58,6 +59,16 @@ public:
      */
     void seed(unsigned int seed);
 
+    /**
+     * Returns state of random number generator in text form.
+     */
+    std::string state() const;
+
+    /**
+     * Restore state of random number generator, e.g., from a checkpoint.
+     */
+    void set_state(std::string const& state);
+
     template <typename input_iterator>
     void shuffle(input_iterator first, input_iterator last);
     template <typename value_type>
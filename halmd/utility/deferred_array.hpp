@@ -0,0 +1,76 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_UTILITY_DEFERRED_ARRAY_HPP
+#define HALMD_UTILITY_DEFERRED_ARRAY_HPP
+
+#include <cstddef>
+#include <functional>
+
+namespace halmd {
+
+/**
+ * Array of fixed size, whose elements are produced on demand.
+ *
+ * Instead of holding the elements, the array holds a function that writes
+ * the elements to a given output buffer. This allows a consumer, e.g., a
+ * file writer, to receive the data of a producer directly in its own buffer
+ * without an intermediate copy.
+ */
+template <typename T>
+class deferred_array
+{
+public:
+    typedef std::size_t size_type;
+    typedef T value_type;
+    typedef std::function<void (T*)> fill_function_type;
+
+    deferred_array() : size_(0) {}
+
+    /**
+     * Construct array of given number of elements.
+     *
+     * @param fill  function that writes the elements to a contiguous output
+     */
+    deferred_array(size_type size, fill_function_type const& fill)
+      : size_(size), fill_(fill) {}
+
+    /** returns number of elements */
+    size_type size() const
+    {
+        return size_;
+    }
+
+    /** write elements to output, which must hold size() elements */
+    void fill(T* output) const
+    {
+        if (size_ > 0) {
+            fill_(output);
+        }
+    }
+
+private:
+    size_type size_;
+    fill_function_type fill_;
+};
+
+} // namespace halmd
+
+#endif /* ! HALMD_UTILITY_DEFERRED_ARRAY_HPP */
@@ -0,0 +1,124 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_UTILITY_RECYCLER_HPP
+#define HALMD_UTILITY_RECYCLER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace halmd {
+
+/**
+ * Recycle objects that are handed out by std::shared_ptr.
+ *
+ * An object is returned to a free list of limited capacity when the last
+ * std::shared_ptr to it is released, and get() hands it out again as a new
+ * std::shared_ptr. This avoids repeated allocation and first touch of large
+ * arrays, while each object returned by get() has a fresh owner, so that
+ * holding previous copies and tracking updates via std::weak_ptr are
+ * unaffected.
+ *
+ * Objects released after destruction of the recycler are deleted.
+ */
+template <typename T>
+class recycler
+{
+public:
+    typedef T value_type;
+
+    /**
+     * Construct recycler holding at most 'capacity' released objects.
+     */
+    explicit recycler(std::size_t capacity = 4)
+      : pool_(std::make_shared<pool>(capacity)) {}
+
+    /**
+     * Returns released object for which reusable(object) yields true, or a
+     * new object constructed by make() otherwise.
+     *
+     * Released objects that are not reusable are deleted.
+     */
+    template <typename Reusable, typename Factory>
+    std::shared_ptr<T> get(Reusable const& reusable, Factory const& make)
+    {
+        std::unique_ptr<T> object;
+        {
+            std::lock_guard<std::mutex> lock(pool_->mutex);
+            while (!object && !pool_->free.empty()) {
+                object = std::move(pool_->free.back());
+                pool_->free.pop_back();
+                if (!reusable(*object)) {
+                    object.reset();
+                }
+            }
+        }
+        if (!object) {
+            object.reset(make());
+        }
+        std::weak_ptr<pool> weak = pool_;
+        return std::shared_ptr<T>(object.release(), [=](T* ptr) {
+            std::unique_ptr<T> object(ptr);
+            if (auto pool = weak.lock()) {
+                std::lock_guard<std::mutex> lock(pool->mutex);
+                if (pool->free.size() < pool->capacity) {
+                    pool->free.push_back(std::move(object));
+                }
+            }
+        });
+    }
+
+    /**
+     * Returns number of released objects available for reuse.
+     */
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(pool_->mutex);
+        return pool_->free.size();
+    }
+
+    /**
+     * Delete all released objects.
+     */
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(pool_->mutex);
+        pool_->free.clear();
+    }
+
+private:
+    struct pool
+    {
+        pool(std::size_t capacity) : capacity(capacity) {}
+
+        std::mutex mutex;
+        std::vector<std::unique_ptr<T>> free;
+        std::size_t capacity;
+    };
+
+    /** free list, shared with the deleters of the objects handed out */
+    std::shared_ptr<pool> pool_;
+};
+
+} // namespace halmd
+
+#endif /* ! HALMD_UTILITY_RECYCLER_HPP */
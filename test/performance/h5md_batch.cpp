@@ -0,0 +1,74 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE h5md_batch
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <halmd/io/writers/h5md/append.hpp>
+#include <halmd/io/writers/h5md/file.hpp>
+#include <halmd/mdsim/clock.hpp>
+#include <halmd/utility/timer.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd;
+using namespace std;
+
+/**
+ * benchmark appending scalar samples to an H5MD time series
+ *
+ * Each sample consists of a scalar value and its step and time. With
+ * batches of several samples, the writes of single samples are replaced
+ * by a single write per batch, which is written directly as a chunk.
+ */
+static double append_scalars(unsigned int batch, unsigned int nsample)
+{
+    auto clock = make_shared<mdsim::clock>();
+    clock->set_timestep(0.001);
+    auto file = make_shared<io::writers::h5md::file>("test_performance_h5md_batch.h5");
+    auto writer = make_shared<io::writers::h5md::append>(file->root(), vector<string>{"observables"}, clock, 0, batch);
+    double value = 0;
+    H5::Group group;
+    writer->on_write<double>(group, [&]() { return value; }, {"value"});
+
+    halmd::timer timer;
+    for (unsigned int n = 0; n < nsample; ++n) {
+        value = n;
+        writer->write();
+        clock->advance();
+    }
+    writer->drain();
+    file->flush();
+    return timer.elapsed();
+}
+
+BOOST_AUTO_TEST_CASE( batch )
+{
+    unsigned int const nsample = 50000;
+    for (unsigned int batch : {1, 8, 64, 512}) {
+        double elapsed = append_scalars(batch, nsample);
+        BOOST_TEST_MESSAGE("  appending " << nsample << " scalar samples in batches of " << batch << ": " << elapsed * 1e3 << " ms");
+    }
+}
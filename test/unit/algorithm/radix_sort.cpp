@@ -37,6 +37,7 @@
 #include <boost/iterator/transform_iterator.hpp>
 
 #include <algorithm>
+#include <numeric>
 #include <random>
 #include <vector>
 
@@ -106,6 +107,77 @@ static void test_radix_sort_host(int count, int repeat)
     BOOST_TEST_MESSAGE( "  " << mean(elapsed) * 1e3 << " ± " << error_of_mean(elapsed) * 1e3 << " ms per iteration" );
 }
 
+/**
+ * Test generation of permutation using std::stable_sort.
+ */
+static void test_std_sort_permutation(int count, int repeat)
+{
+    std::vector<unsigned int> input_key = make_uniform_array(count);
+
+    BOOST_TEST_MESSAGE( "  " << count << " elements" );
+    BOOST_TEST_MESSAGE( "  " << repeat << " iterations" );
+
+    halmd::accumulator<double> elapsed;
+    for (int i = 0; i < repeat; ++i) {
+        std::vector<unsigned int> output_value(count);
+        std::iota(output_value.begin(), output_value.end(), 0);
+        {
+            halmd::scoped_timer<halmd::timer> t(elapsed);
+            std::stable_sort(output_value.begin(), output_value.end(), [&](unsigned int a, unsigned int b) {
+                return input_key[a] < input_key[b];
+            });
+        }
+        BOOST_CHECK( std::is_sorted(output_value.begin(), output_value.end(), [&](unsigned int a, unsigned int b) {
+            return input_key[a] < input_key[b];
+        }));
+    }
+    BOOST_TEST_MESSAGE( "  " << mean(elapsed) * 1e3 << " ± " << error_of_mean(elapsed) * 1e3 << " ms per iteration" );
+}
+
+/**
+ * Test generation of permutation using halmd::radix_sort on host.
+ */
+static void test_permutation_host(int count, int repeat)
+{
+    std::vector<unsigned int> input_key = make_uniform_array(count);
+    // reduce range of keys to obtain equal keys, which test stability
+    for (unsigned int& key : input_key) {
+        key >>= 20;
+    }
+    std::vector<unsigned int> input_value(count);
+    std::iota(input_value.begin(), input_value.end(), 0);
+
+    std::vector<unsigned int> result(input_value.begin(), input_value.end());
+    std::stable_sort(result.begin(), result.end(), [&](unsigned int a, unsigned int b) {
+        return input_key[a] < input_key[b];
+    });
+
+    BOOST_TEST_MESSAGE( "  " << count << " elements" );
+    BOOST_TEST_MESSAGE( "  " << repeat << " iterations" );
+
+    halmd::accumulator<double> elapsed;
+    for (int i = 0; i < repeat; ++i) {
+        std::vector<unsigned int> output_key(input_key.begin(), input_key.end());
+        std::vector<unsigned int> output_value(input_value.begin(), input_value.end());
+        {
+            halmd::scoped_timer<halmd::timer> t(elapsed);
+            BOOST_CHECK( halmd::radix_sort(
+                output_key.begin()
+              , output_key.end()
+              , output_value.begin()) == output_value.end()
+            );
+        }
+        BOOST_CHECK( std::is_sorted(output_key.begin(), output_key.end()) );
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            output_value.begin()
+          , output_value.end()
+          , result.begin()
+          , result.end()
+        );
+    }
+    BOOST_TEST_MESSAGE( "  " << mean(elapsed) * 1e3 << " ± " << error_of_mean(elapsed) * 1e3 << " ms per iteration" );
+}
+
 #ifdef HALMD_WITH_GPU
 /**
  * Test halmd::radix_sort on GPU.
@@ -259,6 +331,20 @@ HALMD_TEST_INIT( radix_sort )
             };
             ts->add(BOOST_TEST_CASE( radix_sort_host ));
         }
+        {
+            int const repeat = std::max(100000 / count, 5);
+            auto std_sort_permutation = [=]() {
+                test_std_sort_permutation(count, repeat);
+            };
+            ts->add(BOOST_TEST_CASE( std_sort_permutation ));
+        }
+        {
+            int const repeat = std::max(100000 / count, 5);
+            auto permutation_host = [=]() {
+                test_permutation_host(count, repeat);
+            };
+            ts->add(BOOST_TEST_CASE( permutation_host ));
+        }
 #ifdef HALMD_WITH_GPU
         {
             int const repeat = std::max(100 / count, 5);
@@ -0,0 +1,121 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_TEST_UNIT_IO_H5MD_APPEND_FIXTURE_HPP
+#define HALMD_TEST_UNIT_IO_H5MD_APPEND_FIXTURE_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <halmd/io/readers/h5md/append.hpp>
+#include <halmd/io/readers/h5md/file.hpp>
+#include <halmd/io/writers/h5md/append.hpp>
+#include <halmd/io/writers/h5md/file.hpp>
+#include <halmd/mdsim/clock.hpp>
+
+/**
+ * Write time series with an H5MD append writer and read them back
+ *
+ * The constructor creates a new file and an append writer at the given
+ * location, which is driven by the clock. The datasets registered with the
+ * writer are opened in writer_group. After writing, close() writes pending
+ * samples, closes the file, and opens the same location with an append
+ * reader, whose datasets are opened in reader_group.
+ */
+struct append_fixture
+{
+    typedef halmd::mdsim::clock clock_type;
+    typedef halmd::io::writers::h5md::append writer_type;
+    typedef halmd::io::readers::h5md::append reader_type;
+
+    std::string filename;
+    std::vector<std::string> location;
+
+    std::shared_ptr<clock_type> clock;
+    std::shared_ptr<halmd::io::writers::h5md::file> writer_file;
+    std::shared_ptr<writer_type> writer;
+    H5::Group writer_group;
+
+    std::shared_ptr<halmd::io::readers::h5md::file> reader_file;
+    std::shared_ptr<reader_type> reader;
+    H5::Group reader_group;
+
+    append_fixture(
+        std::string const& filename
+      , std::vector<std::string> const& location
+      , double timestep = 0.01
+      , unsigned int queue_depth = 0
+      , unsigned int batch = 1
+    )
+      : filename(filename)
+      , location(location)
+      , clock(std::make_shared<clock_type>())
+    {
+        clock->set_timestep(timestep);
+        writer_file = std::make_shared<halmd::io::writers::h5md::file>(filename);
+        writer = std::make_shared<writer_type>(writer_file->root(), location, clock, queue_depth, batch);
+    }
+
+    /**
+     * Write sample at current step and advance the clock by one step.
+     */
+    void write_and_advance()
+    {
+        writer->write();
+        clock->advance();
+    }
+
+    /**
+     * Advance the clock to the given step.
+     */
+    void advance_to(clock_type::step_type step)
+    {
+        while (clock->step() < step) {
+            clock->advance();
+        }
+    }
+
+    /**
+     * Write pending samples, close the file, and open the reader.
+     */
+    void close()
+    {
+        writer->drain();
+        writer.reset();
+        writer_group = H5::Group();
+        writer_file->close();
+        writer_file.reset();
+        open_reader();
+    }
+
+    /**
+     * Open a new reader of the written file.
+     */
+    void open_reader()
+    {
+        reader.reset();
+        reader_group = H5::Group();
+        reader_file = std::make_shared<halmd::io::readers::h5md::file>(filename);
+        reader = std::make_shared<reader_type>(reader_file->root(), location);
+    }
+};
+
+#endif /* ! HALMD_TEST_UNIT_IO_H5MD_APPEND_FIXTURE_HPP */
@@ -0,0 +1,169 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE async
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include <halmd/io/writers/h5md/io_thread.hpp>
+#include <halmd/numeric/blas/fixed_vector.hpp>
+#include <test/tools/ctest.hpp>
+#include <test/unit/io/h5md/append_fixture.hpp>
+
+using namespace halmd;
+using namespace std;
+
+typedef fixed_vector<double, 3> vector_type;
+
+/**
+ * Write samples asynchronously, while the data returned by the slots are
+ * overwritten right after each write, and compare the samples read back.
+ */
+static void test_async(unsigned int queue_depth, unsigned int batch)
+{
+    unsigned int const nparticle = 1000;
+    unsigned int const nsample = 20;
+
+    BOOST_TEST_MESSAGE("queue depth: " << queue_depth << ", batch size: " << batch);
+
+    auto sample_value = [](unsigned int n, unsigned int i) {
+        return vector_type(n + i / 1024.);
+    };
+
+    vector<vector_type> position(nparticle);
+    double energy = 0;
+
+    append_fixture fixture("test_io_h5md_async.h5", {"particles"}, 0.01, queue_depth, batch);
+    fixture.writer->on_write<vector<vector_type> const&>(
+        fixture.writer_group
+      , [&]() -> vector<vector_type> const& { return position; }
+      , {"position"}
+    );
+    fixture.writer->on_write<double>(fixture.writer_group, [&]() { return energy; }, {"energy"});
+    for (unsigned int n = 0; n < nsample; ++n) {
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            position[i] = sample_value(n, i);
+        }
+        energy = n;
+        fixture.write_and_advance();
+        // the writer holds a copy of the sample
+        fill(position.begin(), position.end(), vector_type(-1));
+        energy = -1;
+    }
+
+    fixture.close();
+    auto reader = fixture.reader;
+    vector<vector_type> sample;
+    reader->on_read<vector<vector_type>&>(
+        fixture.reader_group
+      , [&]() -> vector<vector_type>& { return sample; }
+      , {"position"}
+    );
+    reader->on_read<double&>(fixture.reader_group, [&]() -> double& { return energy; }, {"energy"});
+    for (unsigned int n = 0; n < nsample; ++n) {
+        reader->read_next();
+        BOOST_CHECK_EQUAL(energy, n);
+        BOOST_REQUIRE_EQUAL(sample.size(), nparticle);
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            BOOST_CHECK_EQUAL(sample[i], sample_value(n, i));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( async_write )
+{
+    if (!io::writers::h5md::io_thread::threadsafe()) {
+        BOOST_TEST_MESSAGE("skip test for HDF5 library without thread-safety");
+        return;
+    }
+    test_async(1, 1);
+    test_async(3, 1);
+    test_async(2, 4);
+    test_async(5, 7);
+}
+
+/**
+ * Closing the file writes buffered and pending samples of the writers
+ * connected to on_prepend_flush, without draining at the end of a run.
+ */
+BOOST_AUTO_TEST_CASE( async_close )
+{
+    if (!io::writers::h5md::io_thread::threadsafe()) {
+        BOOST_TEST_MESSAGE("skip test for HDF5 library without thread-safety");
+        return;
+    }
+    unsigned int const nsample = 17;
+    double value = 0;
+
+    append_fixture fixture("test_io_h5md_async_close.h5", {"observables"}, 0.01, 2, 5);
+    fixture.writer->on_write<double>(fixture.writer_group, [&]() { return value; }, {"value"});
+    auto writer = fixture.writer.get();
+    connection conn = fixture.writer_file->on_prepend_flush([=]() { writer->drain(); });
+    for (unsigned int n = 0; n < nsample; ++n) {
+        value = n;
+        fixture.write_and_advance();
+    }
+    fixture.writer_file->close();
+    conn.disconnect();
+    fixture.writer.reset();
+    fixture.writer_group = H5::Group();
+    fixture.open_reader();
+
+    hsize_t dims[1];
+    H5::Group group = fixture.reader_file->root().openGroup("observables/value");
+    group.openDataSet("value").getSpace().getSimpleExtentDims(dims);
+    BOOST_CHECK_EQUAL(dims[0], nsample);
+    group.openDataSet("step").getSpace().getSimpleExtentDims(dims);
+    BOOST_CHECK_EQUAL(dims[0], nsample);
+
+    fixture.reader->on_read<double&>(fixture.reader_group, [&]() -> double& { return value; }, {"value"});
+    for (unsigned int n = 0; n < nsample; ++n) {
+        fixture.reader->read_next();
+        BOOST_CHECK_EQUAL(value, n);
+    }
+}
+
+/**
+ * An exception thrown in the I/O thread is rethrown to the writer.
+ */
+BOOST_AUTO_TEST_CASE( async_error )
+{
+    if (!io::writers::h5md::io_thread::threadsafe()) {
+        BOOST_TEST_MESSAGE("skip test for HDF5 library without thread-safety");
+        return;
+    }
+    vector<double> data(10);
+
+    append_fixture fixture("test_io_h5md_async_error.h5", {"observables"}, 0.01, 2);
+    fixture.writer->on_write<vector<double> const&>(
+        fixture.writer_group
+      , [&]() -> vector<double> const& { return data; }
+      , {"data"}
+    );
+    fixture.write_and_advance();
+    // the size of a sample must not change
+    data.resize(11);
+    fixture.write_and_advance();
+    BOOST_CHECK_THROW(fixture.writer->drain(), logic_error);
+}
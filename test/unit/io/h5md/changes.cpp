@@ -0,0 +1,121 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE changes
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <halmd/utility/raw_array.hpp>
+#include <test/tools/ctest.hpp>
+#include <test/unit/io/h5md/append_fixture.hpp>
+
+using namespace halmd;
+using namespace std;
+
+/**
+ * Write a time series at every step and a dataset that changes only at a
+ * few steps, and read both back by step, by time, and sequentially.
+ */
+BOOST_AUTO_TEST_CASE( piecewise_constant )
+{
+    double const timestep = 0.001;
+    unsigned int const nstep = 100;
+    // steps at which the species change
+    vector<unsigned int> const changes = {0, 30, 31, 70};
+    string const filename = "test_io_h5md_changes.h5";
+
+    raw_array<unsigned int> species(3);
+    double value = 0;
+    unsigned int ncall = 0;
+
+    append_fixture fixture(filename, {"particles"}, timestep);
+    auto clock = fixture.clock;
+    H5::Group& group = fixture.writer_group;
+    fixture.writer->on_write<double>(group, [&]() { return value; }, {"value"});
+    fixture.writer->on_write_changes<raw_array<unsigned int> const&>(
+        group
+      , [&]() -> raw_array<unsigned int> const& { return species; }
+      , [&]() { ++ncall; return find(changes.begin(), changes.end(), clock->step()) != changes.end(); }
+      , {"species"}
+    );
+    BOOST_CHECK(group.attrExists("piecewise_constant"));
+
+    unsigned int current = 0;
+    for (unsigned int step = 0; step <= nstep; ++step) {
+        if (find(changes.begin(), changes.end(), step) != changes.end()) {
+            current = step;
+        }
+        fill(species.begin(), species.end(), current);
+        value = step;
+        fixture.write_and_advance();
+    }
+    BOOST_CHECK_EQUAL(ncall, nstep + 1);
+    // only changes are stored
+    BOOST_CHECK_EQUAL(group.openDataSet("value").getSpace().getSimpleExtentNpoints(), changes.size() * species.size());
+    BOOST_CHECK_EQUAL(group.openDataSet("step").getSpace().getSimpleExtentNpoints(), changes.size());
+
+    fixture.close();
+    auto reader = fixture.reader;
+    vector<unsigned int> result;
+    reader->on_read<double&>(fixture.reader_group, [&]() -> double& { return value; }, {"value"});
+    reader->on_read<vector<unsigned int>&>(fixture.reader_group, [&]() -> vector<unsigned int>& { return result; }, {"species"});
+
+    for (unsigned int step = 0; step <= nstep; ++step) {
+        unsigned int expected = *(upper_bound(changes.begin(), changes.end(), step) - 1);
+        reader->read_at_step(step);
+        BOOST_CHECK_EQUAL(value, step);
+        BOOST_CHECK_EQUAL(result.size(), species.size());
+        BOOST_CHECK_EQUAL(result.front(), expected);
+        BOOST_CHECK_EQUAL(result.back(), expected);
+        reader->read_at_time(step * timestep);
+        BOOST_CHECK_EQUAL(value, step);
+        BOOST_CHECK_EQUAL(result.front(), expected);
+    }
+    reader->read_at_step(-1);
+    BOOST_CHECK_EQUAL(result.front(), changes.back());
+
+    // sequential reading follows the steps of the time series of values,
+    // from the first sample and from a lookup
+    auto check_next = [&](unsigned int step) {
+        unsigned int expected = *(upper_bound(changes.begin(), changes.end(), step) - 1);
+        BOOST_CHECK_EQUAL(value, step);
+        BOOST_CHECK_EQUAL(result.front(), expected);
+    };
+    fixture.open_reader();
+    reader = fixture.reader;
+    reader->on_read<vector<unsigned int>&>(fixture.reader_group, [&]() -> vector<unsigned int>& { return result; }, {"species"});
+    reader->on_read<double&>(fixture.reader_group, [&]() -> double& { return value; }, {"value"});
+    for (unsigned int step = 0; step <= nstep; ++step) {
+        reader->read_next();
+        check_next(step);
+    }
+    BOOST_CHECK_THROW(reader->read_next(), domain_error);
+    reader->read_at_step(25);
+    for (unsigned int step = 26; step <= 75; ++step) {
+        reader->read_next();
+        check_next(step);
+    }
+}
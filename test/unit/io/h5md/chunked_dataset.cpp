@@ -0,0 +1,157 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE chunked_dataset
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <halmd/io/writers/h5md/chunked_dataset.hpp>
+#include <halmd/numeric/blas/fixed_vector.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd;
+using namespace std;
+
+typedef fixed_vector<double, 3> vector_type;
+typedef io::writers::h5md::chunked_dataset chunked_dataset;
+typedef io::writers::h5md::dataset_layout dataset_layout;
+
+/**
+ * Returns number of samples stored in dataset.
+ */
+static hsize_t stored_samples(chunked_dataset const& dataset)
+{
+    hsize_t dims[2];
+    dataset.dataset().getSpace().getSimpleExtentDims(dims);
+    return dims[0];
+}
+
+/**
+ * Append samples of particle positions with the given batch size and number
+ * of samples per chunk, flush the dataset after some samples, and compare
+ * the dataset with the samples.
+ */
+static void test_batch(unsigned int batch, unsigned int chunk, unsigned int nsample, vector<unsigned int> const& flush)
+{
+    unsigned int const nparticle = 100;
+
+    BOOST_TEST_MESSAGE("batch size: " << batch << ", chunk size: " << chunk << ", samples: " << nsample);
+
+    auto sample_value = [](unsigned int n, unsigned int i) {
+        vector_type r(n + i / 128.);
+        r[0] = i;
+        return r;
+    };
+
+    H5::H5File file("test_io_h5md_chunked_dataset.h5", H5F_ACC_TRUNC);
+    H5::Group group = file.openGroup("/");
+    vector<vector_type> sample(nparticle);
+    dataset_layout layout;
+    layout.chunk = {chunk};
+    auto dataset = chunked_dataset::create(group, "position", sample, batch, layout);
+    auto scalar = chunked_dataset::create(group, "step", unsigned(0), batch, dataset_layout());
+
+    hsize_t chunk_dims[3];
+    dataset->dataset().getCreatePlist().getChunk(3, chunk_dims);
+    BOOST_CHECK_EQUAL(chunk_dims[0], chunk > 0 ? chunk : batch);
+    BOOST_CHECK_EQUAL(chunk_dims[1], nparticle);
+    BOOST_CHECK_EQUAL(chunk_dims[2], 3u);
+
+    hsize_t written = 0;
+    for (unsigned int n = 0; n < nsample; ++n) {
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            sample[i] = sample_value(n, i);
+        }
+        dataset->append(sample);
+        scalar->append(n);
+        // a batch is written upon completion
+        if ((n + 1 - written) % batch == 0) {
+            written = n + 1;
+        }
+        if (find(flush.begin(), flush.end(), n) != flush.end()) {
+            dataset->flush();
+            scalar->flush();
+            written = n + 1;
+        }
+        BOOST_CHECK_EQUAL(stored_samples(*dataset), written);
+        BOOST_CHECK_EQUAL(stored_samples(*scalar), written);
+    }
+    dataset->flush();
+    scalar->flush();
+    BOOST_CHECK_EQUAL(stored_samples(*dataset), nsample);
+
+    vector<vector_type> result(nsample * nparticle);
+    dataset->dataset().read(&result[0], H5::PredType::NATIVE_DOUBLE);
+    vector<unsigned int> steps(nsample);
+    scalar->dataset().read(&steps[0], H5::PredType::NATIVE_UINT);
+    for (unsigned int n = 0; n < nsample; ++n) {
+        BOOST_CHECK_EQUAL(steps[n], n);
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            BOOST_CHECK_EQUAL(result[n * nparticle + i], sample_value(n, i));
+        }
+    }
+}
+
+/**
+ * Complete batches coincide with chunks and are written directly.
+ */
+BOOST_AUTO_TEST_CASE( chunk_aligned )
+{
+    test_batch(1, 0, 5, {});
+    test_batch(4, 0, 16, {});
+    test_batch(5, 5, 20, {});
+}
+
+/**
+ * Partial batches are written upon flush, which misaligns the following
+ * batches with the chunks.
+ */
+BOOST_AUTO_TEST_CASE( partial_batch )
+{
+    test_batch(4, 0, 18, {});
+    test_batch(4, 0, 17, {1, 9});
+    test_batch(7, 0, 3, {});
+}
+
+/**
+ * Chunks holding several batches, or a fraction of a batch.
+ */
+BOOST_AUTO_TEST_CASE( chunk_shape )
+{
+    test_batch(2, 8, 19, {});
+    test_batch(6, 4, 25, {12});
+}
+
+/**
+ * The size of a sample must match the dataset.
+ */
+BOOST_AUTO_TEST_CASE( sample_size )
+{
+    H5::H5File file("test_io_h5md_chunked_dataset_size.h5", H5F_ACC_TRUNC);
+    auto dataset = chunked_dataset::create(file.openGroup("/"), "value", vector<double>(10), 2, dataset_layout());
+    dataset->append(vector<double>(10));
+    BOOST_CHECK_THROW(dataset->append(vector<double>(11)), logic_error);
+}
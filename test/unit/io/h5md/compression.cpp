@@ -0,0 +1,214 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE compression
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+#include <halmd/numeric/blas/fixed_vector.hpp>
+#include <test/tools/ctest.hpp>
+#include <test/unit/io/h5md/append_fixture.hpp>
+
+using namespace halmd;
+using namespace std;
+
+typedef fixed_vector<double, 3> vector_type;
+
+/** registered identifier of the Zstandard filter plugin */
+static H5Z_filter_t const H5Z_FILTER_ZSTD = 32015;
+
+/**
+ * Filter of the pipeline of a dataset with its first parameter.
+ */
+struct filter
+{
+    H5Z_filter_t id;
+    unsigned int level;
+};
+
+/**
+ * Returns filter pipeline of dataset "value" in given group.
+ */
+static vector<filter> filters(H5::Group const& group, string const& name)
+{
+    H5::DataSet dataset = group.openGroup(name).openDataSet("value");
+    H5::DSetCreatPropList dcpl = dataset.getCreatePlist();
+    vector<filter> result;
+    int nfilter = H5Pget_nfilters(dcpl.getId());
+    BOOST_REQUIRE(nfilter >= 0);
+    for (int i = 0; i < nfilter; ++i) {
+        unsigned int flags;
+        size_t nvalue = 1;
+        unsigned int value = 0;
+        char name[64];
+        unsigned int config;
+        H5Z_filter_t id = H5Pget_filter2(dcpl.getId(), i, &flags, &nvalue, &value, sizeof(name), name, &config);
+        BOOST_REQUIRE(id >= 0);
+        result.push_back({id, nvalue > 0 ? value : 0});
+    }
+    return result;
+}
+
+/**
+ * Compare the filter pipeline of a dataset with the expected filters.
+ */
+static void check_filters(
+    H5::Group const& group
+  , string const& name
+  , vector<H5Z_filter_t> const& id
+  , vector<unsigned int> const& level
+)
+{
+    BOOST_TEST_MESSAGE("filters of dataset " << name);
+    vector<filter> result = filters(group, name);
+    BOOST_REQUIRE_EQUAL(result.size(), id.size());
+    for (unsigned int i = 0; i < id.size(); ++i) {
+        BOOST_CHECK_EQUAL(result[i].id, id[i]);
+        // the shuffle filter holds the size of the scalar type instead of a level
+        if (id[i] != H5Z_FILTER_SHUFFLE) {
+            BOOST_CHECK_EQUAL(result[i].level, level[i]);
+        }
+    }
+}
+
+/**
+ * Append compressed samples of positions, velocities and energies with the
+ * layouts chosen by setup(), and compare the samples read back.
+ */
+template <typename setup_type>
+static void test_compression(string const& filename, unsigned int batch, setup_type const& setup)
+{
+    unsigned int const nparticle = 500;
+    unsigned int const nsample = 13;
+
+    auto sample_value = [](unsigned int n, unsigned int i) {
+        return vector_type(n + i / 512.);
+    };
+
+    vector<vector_type> position(nparticle);
+    vector<vector_type> velocity(nparticle);
+    double energy = 0;
+
+    append_fixture fixture(filename, {"particles"}, 0.01, 0, batch);
+    setup(*fixture.writer);
+    fixture.writer->on_write<vector<vector_type> const&>(
+        fixture.writer_group
+      , [&]() -> vector<vector_type> const& { return position; }
+      , {"position"}
+    );
+    fixture.writer->on_write<vector<vector_type> const&>(
+        fixture.writer_group
+      , [&]() -> vector<vector_type> const& { return velocity; }
+      , {"velocity"}
+    );
+    fixture.writer->on_write<double>(fixture.writer_group, [&]() { return energy; }, {"energy"});
+    for (unsigned int n = 0; n < nsample; ++n) {
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            position[i] = sample_value(n, i);
+            velocity[i] = -sample_value(n, i);
+        }
+        energy = n;
+        fixture.write_and_advance();
+    }
+
+    fixture.close();
+    auto reader = fixture.reader;
+    reader->on_read<vector<vector_type>&>(
+        fixture.reader_group
+      , [&]() -> vector<vector_type>& { return position; }
+      , {"position"}
+    );
+    reader->on_read<vector<vector_type>&>(
+        fixture.reader_group
+      , [&]() -> vector<vector_type>& { return velocity; }
+      , {"velocity"}
+    );
+    reader->on_read<double&>(fixture.reader_group, [&]() -> double& { return energy; }, {"energy"});
+    for (unsigned int n = 0; n < nsample; ++n) {
+        reader->read_next();
+        BOOST_CHECK_EQUAL(energy, n);
+        BOOST_REQUIRE_EQUAL(position.size(), nparticle);
+        BOOST_REQUIRE_EQUAL(velocity.size(), nparticle);
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            BOOST_CHECK_EQUAL(position[i], sample_value(n, i));
+            BOOST_CHECK_EQUAL(velocity[i], -sample_value(n, i));
+        }
+    }
+}
+
+/**
+ * Shuffle and deflate filters for all datasets of a writer.
+ */
+BOOST_AUTO_TEST_CASE( shuffle_deflate )
+{
+    string const filename = "test_io_h5md_compression_deflate.h5";
+    test_compression(filename, 4, [](append_fixture::writer_type& writer) {
+        writer.compression({}, true, 6, 0);
+    });
+    H5::Group group = H5::H5File(filename, H5F_ACC_RDONLY).openGroup("particles");
+    for (string name : {"position", "velocity", "energy"}) {
+        check_filters(group, name, {H5Z_FILTER_SHUFFLE, H5Z_FILTER_DEFLATE}, {0, 6});
+    }
+}
+
+/**
+ * The filters of a single dataset replace the default filters, while the
+ * layout of a single dataset preserves them.
+ */
+BOOST_AUTO_TEST_CASE( default_and_dataset )
+{
+    string const filename = "test_io_h5md_compression_default.h5";
+    test_compression(filename, 3, [](append_fixture::writer_type& writer) {
+        writer.compression({}, true, 4, 0);
+        writer.layout({"position"}, {6}, 0);
+        writer.compression({"velocity"}, false, 1, 0);
+    });
+    H5::Group group = H5::H5File(filename, H5F_ACC_RDONLY).openGroup("particles");
+    check_filters(group, "position", {H5Z_FILTER_SHUFFLE, H5Z_FILTER_DEFLATE}, {0, 4});
+    check_filters(group, "velocity", {H5Z_FILTER_DEFLATE}, {1});
+    check_filters(group, "energy", {H5Z_FILTER_SHUFFLE, H5Z_FILTER_DEFLATE}, {0, 4});
+
+    hsize_t chunk[3];
+    group.openGroup("position").openDataSet("value").getCreatePlist().getChunk(3, chunk);
+    BOOST_CHECK_EQUAL(chunk[0], 6u);
+}
+
+/**
+ * Zstandard filter, if the plugin is found in HDF5_PLUGIN_PATH.
+ */
+BOOST_AUTO_TEST_CASE( zstd )
+{
+    if (H5Zfilter_avail(H5Z_FILTER_ZSTD) <= 0) {
+        BOOST_TEST_MESSAGE("skip test without Zstandard filter plugin for HDF5");
+        return;
+    }
+    string const filename = "test_io_h5md_compression_zstd.h5";
+    test_compression(filename, 5, [](append_fixture::writer_type& writer) {
+        writer.compression({}, true, 0, 3);
+    });
+    H5::Group group = H5::H5File(filename, H5F_ACC_RDONLY).openGroup("particles");
+    for (string name : {"position", "velocity", "energy"}) {
+        check_filters(group, name, {H5Z_FILTER_SHUFFLE, H5Z_FILTER_ZSTD}, {0, 3});
+    }
+}
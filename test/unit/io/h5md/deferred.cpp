@@ -0,0 +1,99 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE deferred
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <halmd/numeric/blas/fixed_vector.hpp>
+#include <halmd/utility/deferred_array.hpp>
+#include <test/tools/ctest.hpp>
+#include <test/unit/io/h5md/append_fixture.hpp>
+
+using namespace halmd;
+using namespace std;
+
+typedef fixed_vector<float, 3> vector_type;
+
+/**
+ * Write particle data produced on demand directly into the buffer of the
+ * writer, and compare the data read back with the produced data.
+ */
+static void test_deferred(unsigned int queue_depth, unsigned int batch)
+{
+    unsigned int const nparticle = 500;
+    unsigned int const nsample = 7;
+
+    BOOST_TEST_MESSAGE("queue depth: " << queue_depth << ", batch size: " << batch);
+
+    auto produce = [&](unsigned int step, vector_type* output) {
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            output[i] = vector_type(step + i / 8.f);
+            output[i][0] = i;
+        }
+    };
+
+    append_fixture fixture("test_io_h5md_deferred.h5", {"particles"}, 0.01, queue_depth, batch);
+    auto clock = fixture.clock;
+    fixture.writer->on_write<deferred_array<vector_type>>(
+        fixture.writer_group
+      , [&]() {
+            unsigned int step = clock->step();
+            return deferred_array<vector_type>(nparticle, [=](vector_type* output) {
+                produce(step, output);
+            });
+        }
+      , {"position"}
+    );
+    for (unsigned int n = 0; n < nsample; ++n) {
+        fixture.write_and_advance();
+    }
+
+    fixture.close();
+    auto reader = fixture.reader;
+    vector<vector_type> sample;
+    reader->on_read<vector<vector_type>&>(
+        fixture.reader_group
+      , [&]() -> vector<vector_type>& { return sample; }
+      , {"position"}
+    );
+    vector<vector_type> expected(nparticle);
+    for (unsigned int n = 0; n < nsample; ++n) {
+        reader->read_at_step(n);
+        produce(n, &expected[0]);
+        BOOST_CHECK_EQUAL_COLLECTIONS(sample.begin(), sample.end(), expected.begin(), expected.end());
+    }
+}
+
+BOOST_AUTO_TEST_CASE( synchronous )
+{
+    test_deferred(0, 1);
+    test_deferred(0, 3);
+}
+
+BOOST_AUTO_TEST_CASE( asynchronous )
+{
+    test_deferred(2, 1);
+    test_deferred(4, 3);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE lookup
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <test/tools/ctest.hpp>
+#include <test/unit/io/h5md/append_fixture.hpp>
+
+using namespace halmd;
+using namespace std;
+
+/**
+ * Write a time series at the given steps, and read it back by step, by
+ * time, and sequentially.
+ */
+static void test_lookup(vector<unsigned int> const& steps, string const& filename)
+{
+    double const timestep = 0.001;
+    double value = 0;
+
+    append_fixture fixture(filename, {"observables"}, timestep);
+    fixture.writer->on_write<double>(fixture.writer_group, [&]() { return value; }, {"value"});
+    for (unsigned int step : steps) {
+        fixture.advance_to(step);
+        value = step;
+        fixture.writer->write();
+    }
+
+    fixture.close();
+    auto reader = fixture.reader;
+    reader->on_read<double&>(fixture.reader_group, [&]() -> double& { return value; }, {"value"});
+
+    for (unsigned int step : steps) {
+        reader->read_at_step(step);
+        BOOST_CHECK_EQUAL(value, step);
+        reader->read_at_time(step * timestep);
+        BOOST_CHECK_EQUAL(value, step);
+    }
+    reader->read_at_step(-1);
+    BOOST_CHECK_EQUAL(value, steps.back());
+    reader->read_at_time(-0.);
+    BOOST_CHECK_EQUAL(value, steps.back());
+    BOOST_CHECK_THROW(reader->read_at_step(steps.back() + 1), domain_error);
+    BOOST_CHECK_THROW(reader->read_at_time((steps.back() + 0.5) * timestep), domain_error);
+
+    // sequential reading following the first sample
+    reader->read_at_step(steps.front());
+    for (unsigned int i = 1; i < steps.size(); ++i) {
+        reader->read_next();
+        BOOST_CHECK_EQUAL(value, steps[i]);
+    }
+    BOOST_CHECK_THROW(reader->read_next(), domain_error);
+}
+
+BOOST_AUTO_TEST_CASE( regular )
+{
+    vector<unsigned int> steps;
+    for (unsigned int step = 10; step <= 1000; step += 10) {
+        steps.push_back(step);
+    }
+    test_lookup(steps, "test_io_h5md_lookup_regular.h5");
+}
+
+BOOST_AUTO_TEST_CASE( irregular )
+{
+    vector<unsigned int> steps;
+    for (unsigned int step = 1; step <= 1000; step *= 2) {
+        steps.push_back(step - 1);
+    }
+    test_lookup(steps, "test_io_h5md_lookup_irregular.h5");
+}
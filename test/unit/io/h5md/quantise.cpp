@@ -0,0 +1,154 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE quantise
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <halmd/numeric/blas/fixed_vector.hpp>
+#include <test/tools/ctest.hpp>
+#include <test/unit/io/h5md/append_fixture.hpp>
+
+using namespace halmd;
+using namespace std;
+
+/**
+ * Write a random walk of particles with quantised, delta-encoded positions
+ * and compare each sample read back with the original sample.
+ */
+template <int dimension>
+static void test_quantise(unsigned int batch, unsigned int chunk)
+{
+    typedef fixed_vector<double, dimension> vector_type;
+
+    unsigned int const nparticle = 1000;
+    unsigned int const nsample = 25;
+    vector<double> const scale = {1e-4, 2e-4, 5e-4};
+
+    BOOST_TEST_MESSAGE("batch size: " << batch << ", chunk size: " << chunk);
+
+    std::mt19937 gen;
+    std::normal_distribution<double> normal(0, 0.1);
+    std::uniform_real_distribution<double> uniform(-10, 10);
+
+    vector<vector<vector_type>> samples(nsample, vector<vector_type>(nparticle));
+    for (unsigned int i = 0; i < nparticle; ++i) {
+        for (unsigned int j = 0; j < dimension; ++j) {
+            samples[0][i][j] = uniform(gen);
+        }
+    }
+    for (unsigned int n = 1; n < nsample; ++n) {
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            for (unsigned int j = 0; j < dimension; ++j) {
+                samples[n][i][j] = samples[n - 1][i][j] + normal(gen);
+            }
+        }
+    }
+
+    string filename = "test_io_h5md_quantise_" + to_string(dimension) + "d.h5";
+    append_fixture fixture(filename, {"particles"}, 0.01, 0, batch);
+    fixture.writer->layout({"position"}, {chunk}, 0);
+    fixture.writer->quantise({"position"}, vector<double>(scale.begin(), scale.begin() + dimension));
+    fixture.writer->compression({"position"}, true, 6, 0);
+
+    unsigned int n = 0;
+    fixture.writer->on_write<vector<vector_type> const&>(
+        fixture.writer_group
+      , [&]() -> vector<vector_type> const& { return samples[n]; }
+      , {"position"}
+    );
+    for (n = 0; n < nsample; ++n) {
+        fixture.write_and_advance();
+    }
+    fixture.writer->drain();
+
+    H5::DataSet dataset = fixture.writer_group.openDataSet("value");
+    BOOST_CHECK(dataset.getTypeClass() == H5T_INTEGER);
+    BOOST_CHECK(dataset.attrExists("scale_factor"));
+    dataset = H5::DataSet();
+
+    fixture.close();
+    auto reader = fixture.reader;
+    vector<vector_type> sample;
+    reader->on_read<vector<vector_type>&>(
+        fixture.reader_group
+      , [&]() -> vector<vector_type>& { return sample; }
+      , {"position"}
+    );
+
+    // read samples in reverse order to check decoding without preceding reads
+    for (int n = nsample - 1; n >= 0; --n) {
+        reader->read_at_step(n);
+        BOOST_REQUIRE_EQUAL(sample.size(), nparticle);
+        double max_error = 0;
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            for (unsigned int j = 0; j < dimension; ++j) {
+                max_error = max(max_error, abs(sample[i][j] - samples[n][i][j]) / scale[j]);
+            }
+        }
+        BOOST_CHECK_LE(max_error, 0.5 + 1e-6);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( quantise_2d )
+{
+    test_quantise<2>(1, 1);
+    test_quantise<2>(4, 8);
+}
+
+BOOST_AUTO_TEST_CASE( quantise_3d )
+{
+    test_quantise<3>(5, 5);
+    test_quantise<3>(1, 10);
+}
+
+/**
+ * Values that exceed the range of 32-bit integers after quantisation are
+ * refused, including values that exceed the range of 64-bit integers.
+ */
+BOOST_AUTO_TEST_CASE( quantise_range )
+{
+    typedef fixed_vector<double, 3> vector_type;
+    vector<vector_type> sample(10, vector_type(1));
+
+    append_fixture fixture("test_io_h5md_quantise_range.h5", {"particles"});
+    fixture.writer->quantise({"position"}, {1e-3});
+    fixture.writer->on_write<vector<vector_type> const&>(
+        fixture.writer_group
+      , [&]() -> vector<vector_type> const& { return sample; }
+      , {"position"}
+    );
+    fixture.write_and_advance();
+
+    for (double value : {3e6, -3e6, 1e30, numeric_limits<double>::quiet_NaN()}) {
+        BOOST_TEST_MESSAGE("value: " << value);
+        sample[5][1] = value;
+        BOOST_CHECK_THROW(fixture.writer->write(), range_error);
+        fixture.clock->advance();
+    }
+}
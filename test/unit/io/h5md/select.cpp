@@ -0,0 +1,141 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE select
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <halmd/numeric/blas/fixed_vector.hpp>
+#include <test/tools/ctest.hpp>
+#include <test/unit/io/h5md/append_fixture.hpp>
+
+using namespace halmd;
+using namespace std;
+
+typedef fixed_vector<double, 3> vector_type;
+
+/**
+ * Write samples of particle positions, and read subsets of the particles
+ * given by a range and by a list of indices.
+ */
+static void test_select(bool quantise)
+{
+    unsigned int const nparticle = 1000;
+    unsigned int const nsample = 5;
+    double const scale = 1e-3;
+
+    BOOST_TEST_MESSAGE("quantised dataset: " << quantise);
+
+    std::mt19937 gen;
+    std::uniform_real_distribution<double> uniform(-10, 10);
+    vector<vector<vector_type>> samples(nsample, vector<vector_type>(nparticle));
+    for (auto& sample : samples) {
+        for (auto& r : sample) {
+            r = vector_type(uniform(gen));
+            r[1] = uniform(gen);
+        }
+    }
+
+    string filename = string("test_io_h5md_select") + (quantise ? "_quantised" : "") + ".h5";
+    append_fixture fixture(filename, {"particles"}, 0.01, 0, 2);
+    fixture.writer->layout({"position"}, {2, 64}, 0);
+    if (quantise) {
+        fixture.writer->quantise({"position"}, {scale});
+    }
+    unsigned int n = 0;
+    fixture.writer->on_write<vector<vector_type> const&>(
+        fixture.writer_group
+      , [&]() -> vector<vector_type> const& { return samples[n]; }
+      , {"position"}
+    );
+    for (n = 0; n < nsample; ++n) {
+        fixture.write_and_advance();
+    }
+    fixture.close();
+
+    // unsorted list of indices with duplicates
+    vector<unsigned int> index = {999, 3, 4, 5, 500, 70, 71, 4, 0, 640};
+    vector<unsigned int> sorted(index);
+    sort(sorted.begin(), sorted.end());
+    sorted.erase(unique(sorted.begin(), sorted.end()), sorted.end());
+
+    auto reader = fixture.reader;
+    H5::Group& group = fixture.reader_group;
+    vector<vector_type> range_sample, index_sample, empty_sample;
+    reader->on_read_range<vector<vector_type>&>(
+        group
+      , [&]() -> vector<vector_type>& { return range_sample; }
+      , {"position"}
+      , 100, 300
+    );
+    reader->on_read_index<vector<vector_type>&>(
+        group
+      , [&]() -> vector<vector_type>& { return index_sample; }
+      , {"position"}
+      , index
+    );
+    reader->on_read_range<vector<vector_type>&>(
+        group
+      , [&]() -> vector<vector_type>& { return empty_sample; }
+      , {"position"}
+      , 10, 10
+    );
+
+    auto check = [&](double value, double expected) {
+        if (quantise) {
+            BOOST_CHECK_SMALL(value - expected, scale / 2 * (1 + 1e-6));
+        }
+        else {
+            BOOST_CHECK_EQUAL(value, expected);
+        }
+    };
+    for (n = 0; n < nsample; ++n) {
+        reader->read_at_step(n);
+        BOOST_REQUIRE_EQUAL(range_sample.size(), 200u);
+        for (unsigned int i = 0; i < range_sample.size(); ++i) {
+            for (unsigned int j = 0; j < 3; ++j) {
+                check(range_sample[i][j], samples[n][100 + i][j]);
+            }
+        }
+        BOOST_REQUIRE_EQUAL(index_sample.size(), sorted.size());
+        for (unsigned int i = 0; i < index_sample.size(); ++i) {
+            for (unsigned int j = 0; j < 3; ++j) {
+                check(index_sample[i][j], samples[n][sorted[i]][j]);
+            }
+        }
+        BOOST_CHECK(empty_sample.empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE( select_rows )
+{
+    test_select(false);
+}
+
+BOOST_AUTO_TEST_CASE( select_quantised_rows )
+{
+    test_select(true);
+}
@@ -0,0 +1,236 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE checkpoint
+#include <boost/test/unit_test.hpp>
+
+#include <boost/numeric/ublas/banded.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/clock.hpp>
+#include <halmd/mdsim/host/checkpoint.hpp>
+#include <halmd/mdsim/host/particle.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd;
+
+template <int dimension, typename float_type>
+struct checkpoint_fixture
+{
+    typedef mdsim::host::particle<dimension, float_type> particle_type;
+    typedef mdsim::box<dimension> box_type;
+    typedef mdsim::clock clock_type;
+    typedef mdsim::host::checkpoint<dimension, float_type> checkpoint_type;
+    typedef typename particle_type::vector_type vector_type;
+
+    static std::shared_ptr<box_type> make_box(double length)
+    {
+        boost::numeric::ublas::diagonal_matrix<double> edges(dimension);
+        for (int i = 0; i < dimension; ++i) {
+            edges(i, i) = length * (i + 1);
+        }
+        return std::make_shared<box_type>(edges);
+    }
+};
+
+/**
+ * Write checkpoint of particles with distinct data, and restore it into
+ * newly constructed particles.
+ */
+template <int dimension, typename float_type>
+static void test_checkpoint(std::string const& filename)
+{
+    typedef checkpoint_fixture<dimension, float_type> fixture;
+    typedef typename fixture::vector_type vector_type;
+    unsigned int const nparticle = 1000;
+    unsigned int const nspecies = 3;
+
+    auto box = fixture::make_box(10);
+    {
+        auto particle = std::make_shared<typename fixture::particle_type>(nparticle, nspecies);
+        auto clock = std::make_shared<typename fixture::clock_type>();
+        clock->set_timestep(0.005);
+        for (unsigned int i = 0; i < 123; ++i) {
+            clock->advance();
+        }
+        {
+            auto position = make_cache_mutable(particle->position());
+            auto image = make_cache_mutable(particle->image());
+            auto velocity = make_cache_mutable(particle->velocity());
+            auto tag = make_cache_mutable(particle->tag());
+            auto reverse_tag = make_cache_mutable(particle->reverse_tag());
+            auto species = make_cache_mutable(particle->species());
+            auto mass = make_cache_mutable(particle->mass());
+            for (unsigned int i = 0; i < nparticle; ++i) {
+                (*position)[i] = vector_type(float_type(i) / 7);
+                (*image)[i] = vector_type(float_type(i % 5) - 2);
+                (*velocity)[i] = vector_type(float_type(i) / 3);
+                (*tag)[i] = nparticle - 1 - i;
+                (*reverse_tag)[nparticle - 1 - i] = i;
+                (*species)[i] = i % nspecies;
+                (*mass)[i] = 1 + (i % nspecies);
+            }
+        }
+        std::string state = "heat bath";
+        typename fixture::checkpoint_type checkpoint(particle, box, clock);
+        checkpoint.add_state("thermostat", [&]() { return state; }, [](std::string const&) {});
+        BOOST_CHECK_THROW(checkpoint.add_state("thermostat", nullptr, nullptr), std::invalid_argument);
+        checkpoint.write(filename);
+    }
+
+    mdsim::host::checkpoint_info info = mdsim::host::checkpoint_info::read(filename);
+    BOOST_CHECK_EQUAL(info.dimension, unsigned(dimension));
+    BOOST_CHECK_EQUAL(info.float_size, sizeof(float_type));
+    BOOST_CHECK_EQUAL(info.nparticle, nparticle);
+    BOOST_CHECK_EQUAL(info.nspecies, nspecies);
+    BOOST_CHECK_EQUAL(info.step, 123u);
+    BOOST_CHECK_EQUAL(info.timestep, 0.005);
+    BOOST_CHECK_EQUAL(info.length.size(), unsigned(dimension));
+    for (int i = 0; i < dimension; ++i) {
+        BOOST_CHECK_EQUAL(info.length[i], box->length()[i]);
+    }
+
+    auto particle = std::make_shared<typename fixture::particle_type>(nparticle, nspecies);
+    auto clock = std::make_shared<typename fixture::clock_type>();
+    std::string state;
+    typename fixture::checkpoint_type checkpoint(particle, box, clock);
+    checkpoint.add_state("thermostat", []() { return std::string(); }, [&](std::string const& s) { state = s; });
+    checkpoint.read(filename);
+
+    BOOST_CHECK_EQUAL(clock->step(), 123u);
+    BOOST_CHECK_EQUAL(clock->time(), info.time);
+    BOOST_CHECK_EQUAL(state, "heat bath");
+
+    auto const& position = read_cache(particle->position());
+    auto const& image = read_cache(particle->image());
+    auto const& velocity = read_cache(particle->velocity());
+    auto const& tag = read_cache(particle->tag());
+    auto const& reverse_tag = read_cache(particle->reverse_tag());
+    auto const& species = read_cache(particle->species());
+    auto const& mass = read_cache(particle->mass());
+    for (unsigned int i = 0; i < nparticle; ++i) {
+        BOOST_CHECK_EQUAL(position[i], vector_type(float_type(i) / 7));
+        BOOST_CHECK_EQUAL(image[i], vector_type(float_type(i % 5) - 2));
+        BOOST_CHECK_EQUAL(velocity[i], vector_type(float_type(i) / 3));
+        BOOST_CHECK_EQUAL(tag[i], nparticle - 1 - i);
+        BOOST_CHECK_EQUAL(reverse_tag[nparticle - 1 - i], i);
+        BOOST_CHECK_EQUAL(species[i], i % nspecies);
+        BOOST_CHECK_EQUAL(mass[i], 1 + (i % nspecies));
+    }
+
+    // the system must match the checkpoint
+    auto other_particle = std::make_shared<typename fixture::particle_type>(nparticle + 1, nspecies);
+    typename fixture::checkpoint_type other_checkpoint(other_particle, box, clock);
+    BOOST_CHECK_THROW(other_checkpoint.read(filename), std::runtime_error);
+    typename fixture::checkpoint_type other_box(particle, fixture::make_box(11), clock);
+    BOOST_CHECK_THROW(other_box.read(filename), std::runtime_error);
+    BOOST_CHECK_THROW(checkpoint.read(filename + ".missing"), std::runtime_error);
+}
+
+/**
+ * Write checkpoint in forked child process while modifying the particles,
+ * and restore the snapshot at the time of forking.
+ */
+template <int dimension, typename float_type>
+static void test_fork_checkpoint(std::string const& filename)
+{
+    typedef checkpoint_fixture<dimension, float_type> fixture;
+    typedef typename fixture::vector_type vector_type;
+    unsigned int const nparticle = 100000;
+
+    auto box = fixture::make_box(10);
+    auto particle = std::make_shared<typename fixture::particle_type>(nparticle, 1);
+    auto clock = std::make_shared<typename fixture::clock_type>();
+    clock->set_timestep(0.001);
+    typename fixture::checkpoint_type checkpoint(particle, box, clock);
+    BOOST_CHECK(checkpoint.poll());
+
+    {
+        auto position = make_cache_mutable(particle->position());
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            (*position)[i] = vector_type(float_type(i) / 11);
+        }
+    }
+    clock->advance();
+    checkpoint.fork_write(filename);
+
+    // continue simulation in parent process
+    clock->advance();
+    {
+        auto position = make_cache_mutable(particle->position());
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            (*position)[i] = vector_type(-1);
+        }
+    }
+    checkpoint.wait();
+    BOOST_CHECK(checkpoint.poll());
+
+    checkpoint.read(filename);
+    BOOST_CHECK_EQUAL(clock->step(), 1u);
+    auto const& position = read_cache(particle->position());
+    for (unsigned int i = 0; i < nparticle; ++i) {
+        BOOST_CHECK_EQUAL(position[i], vector_type(float_type(i) / 11));
+    }
+
+    // failure of child process is reported upon waiting
+    checkpoint.fork_write("nonexistent/" + filename);
+    BOOST_CHECK_THROW(checkpoint.wait(), std::runtime_error);
+    BOOST_CHECK_NO_THROW(checkpoint.wait());
+
+    // failure is reported even if followed by a successful snapshot
+    checkpoint.fork_write("nonexistent/" + filename);
+    clock->advance();
+    checkpoint.fork_write(filename);
+    BOOST_CHECK_THROW(checkpoint.wait(), std::runtime_error);
+    BOOST_CHECK_NO_THROW(checkpoint.wait());
+    checkpoint.read(filename);
+    BOOST_CHECK_EQUAL(clock->step(), 2u);
+}
+
+#ifndef USE_HOST_SINGLE_PRECISION
+BOOST_AUTO_TEST_CASE( host_2d )
+{
+    test_checkpoint<2, double>("test_mdsim_checkpoint_2d.ckp");
+    test_fork_checkpoint<2, double>("test_mdsim_checkpoint_fork_2d.ckp");
+}
+
+BOOST_AUTO_TEST_CASE( host_3d )
+{
+    test_checkpoint<3, double>("test_mdsim_checkpoint_3d.ckp");
+    test_fork_checkpoint<3, double>("test_mdsim_checkpoint_fork_3d.ckp");
+}
+#else
+BOOST_AUTO_TEST_CASE( host_2d )
+{
+    test_checkpoint<2, float>("test_mdsim_checkpoint_2d.ckp");
+    test_fork_checkpoint<2, float>("test_mdsim_checkpoint_fork_2d.ckp");
+}
+
+BOOST_AUTO_TEST_CASE( host_3d )
+{
+    test_checkpoint<3, float>("test_mdsim_checkpoint_3d.ckp");
+    test_fork_checkpoint<3, float>("test_mdsim_checkpoint_fork_3d.ckp");
+}
+#endif
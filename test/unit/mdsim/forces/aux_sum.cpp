@@ -0,0 +1,219 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE aux_sum
+#include <boost/test/unit_test.hpp>
+
+#include <boost/numeric/ublas/assignment.hpp> // <<=
+#include <boost/numeric/ublas/banded.hpp>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/force_kernel.hpp>
+#include <halmd/mdsim/host/forces/pair_full.hpp>
+#include <halmd/mdsim/host/forces/pair_trunc.hpp>
+#include <halmd/mdsim/host/max_displacement.hpp>
+#include <halmd/mdsim/host/neighbours/from_particle.hpp>
+#include <halmd/mdsim/host/particle.hpp>
+#include <halmd/mdsim/host/particle_groups/all.hpp>
+#include <halmd/mdsim/host/potentials/pair/lennard_jones.hpp>
+#include <halmd/observables/host/thermodynamics.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd;
+using namespace std;
+
+/**
+ * Compute the force of a Lennard-Jones fluid on a perturbed lattice twice,
+ * once with the per-particle auxiliary variables and once with only their
+ * sums over all particles, and compare the potential energy, the virial and
+ * the stress tensor. The thermodynamics module of a group of all particles
+ * takes these from the sums, which are compared with the reduction of the
+ * per-particle arrays.
+ */
+template <int dimension, typename float_type>
+static void test_aux_sum(bool truncated)
+{
+    typedef mdsim::box<dimension> box_type;
+    typedef mdsim::host::particle<dimension, float_type> particle_type;
+    typedef mdsim::host::potentials::pair::lennard_jones<float_type> potential_type;
+    typedef mdsim::host::forces::pair_full<dimension, float_type, potential_type> pair_full_type;
+    typedef mdsim::host::forces::pair_trunc<dimension, float_type, potential_type> pair_trunc_type;
+    typedef mdsim::host::max_displacement<dimension, float_type> max_displacement_type;
+    typedef mdsim::host::neighbours::from_particle<dimension, float_type> neighbour_type;
+    typedef mdsim::host::particle_groups::all<particle_type> particle_group_type;
+    typedef observables::host::thermodynamics<dimension, float_type> thermodynamics_type;
+    typedef typename particle_type::position_type position_type;
+    typedef typename particle_type::velocity_type velocity_type;
+    typedef typename particle_type::stress_pot_sum_type stress_pot_sum_type;
+    typedef typename thermodynamics_type::stress_tensor_type stress_tensor_type;
+    typedef typename potential_type::matrix_type matrix_type;
+
+    unsigned int const nlattice = (dimension == 3) ? 6 : 12;
+    unsigned int const nparticle = pow(nlattice, dimension);
+    double const spacing = 1.1;
+    double const skin = 0.5;
+    float_type const tolerance = 100 * numeric_limits<float_type>::epsilon();
+
+    BOOST_TEST_MESSAGE("dimension: " << dimension << ", " << (truncated ? "pair_trunc" : "pair_full"));
+
+    boost::numeric::ublas::diagonal_matrix<typename box_type::matrix_type::value_type> edges(dimension);
+    for (unsigned int i = 0; i < dimension; ++i) {
+        edges(i, i) = nlattice * spacing;
+    }
+    auto box = make_shared<box_type>(edges);
+
+    matrix_type cutoff(1, 1);
+    cutoff <<= 2.5;
+    matrix_type epsilon(1, 1);
+    epsilon <<= 1.;
+    matrix_type sigma(1, 1);
+    sigma <<= 1.;
+    auto potential = make_shared<potential_type>(cutoff, epsilon, sigma);
+
+    // simple cubic lattice with random displacements and velocities
+    mt19937 gen(42);
+    uniform_real_distribution<double> displacement(-0.1, 0.1);
+    uniform_real_distribution<double> speed(-1, 1);
+    vector<position_type> position(nparticle);
+    vector<velocity_type> velocity(nparticle);
+    for (unsigned int i = 0; i < nparticle; ++i) {
+        unsigned int index = i;
+        for (unsigned int j = 0; j < dimension; ++j) {
+            position[i][j] = box->origin()[j] + ((index % nlattice) + 0.5) * spacing + displacement(gen);
+            velocity[i][j] = speed(gen);
+            index /= nlattice;
+        }
+    }
+
+    auto make_particle = [&]() {
+        auto particle = make_shared<particle_type>(nparticle, 1);
+        set_position(*particle, position.begin());
+        set_velocity(*particle, velocity.begin());
+        if (truncated) {
+            auto max_displacement = make_shared<max_displacement_type>(particle, box);
+            auto neighbour = make_shared<neighbour_type>(
+                make_pair(particle, particle)
+              , make_pair(max_displacement, max_displacement)
+              , box
+              , potential->r_cut()
+              , skin
+            );
+            auto force = make_shared<pair_trunc_type>(potential, particle, particle, box, neighbour);
+            particle->on_prepend_force([=]() { force->check_cache(); });
+            particle->on_force([=]() { force->apply(); });
+        }
+        else {
+            auto force = make_shared<pair_full_type>(potential, particle, particle, box);
+            particle->on_prepend_force([=]() { force->check_cache(); });
+            particle->on_force([=]() { force->apply(); });
+        }
+        // the auxiliary variables are enabled by default for the initial
+        // state, so a second force computation is needed for each mode
+        read_cache(particle->force());
+        set_position(*particle, position.begin());
+        return particle;
+    };
+
+    // reduce per-particle auxiliary variables
+    auto particle = make_particle();
+    particle->aux_enable();
+    auto const& en_pot = read_cache(particle->potential_energy());
+    auto const& stress_pot = read_cache(particle->stress_pot());
+    auto const& mass = read_cache(particle->mass());
+
+    double en_pot_sum = 0;
+    stress_pot_sum_type stress_pot_sum = 0;
+    stress_tensor_type stress_tensor = 0;
+    for (unsigned int i = 0; i < nparticle; ++i) {
+        en_pot_sum += en_pot[i];
+        stress_pot_sum += static_cast<stress_pot_sum_type>(stress_pot[i]);
+        stress_tensor += static_cast<stress_tensor_type>(mass[i] * mdsim::make_stress_tensor(velocity[i]));
+    }
+    stress_tensor += stress_pot_sum;
+    double virial = 0;
+    for (int k = 0; k < dimension; ++k) {
+        virial += stress_pot_sum[k];
+    }
+    BOOST_CHECK(en_pot_sum < 0);
+    float_type const stress_norm = norm_inf(stress_pot_sum);
+
+    // the regular mode computes the sums along with the per-particle arrays
+    BOOST_CHECK_CLOSE_FRACTION(read_cache(particle->potential_energy_sum()), en_pot_sum, tolerance);
+    stress_pot_sum_type const& stress_pot_sum_aux = read_cache(particle->stress_pot_sum());
+    for (unsigned int k = 0; k < stress_pot_sum_type::static_size; ++k) {
+        BOOST_CHECK_SMALL(stress_pot_sum_aux[k] - stress_pot_sum[k], tolerance * stress_norm);
+    }
+
+    // compute only the sums of the auxiliary variables
+    auto particle_sum = make_particle();
+    particle_sum->aux_sum_enable();
+    BOOST_CHECK_CLOSE_FRACTION(read_cache(particle_sum->potential_energy_sum()), en_pot_sum, tolerance);
+    stress_pot_sum_type const& stress_pot_sum_only = read_cache(particle_sum->stress_pot_sum());
+    for (unsigned int k = 0; k < stress_pot_sum_type::static_size; ++k) {
+        BOOST_CHECK_SMALL(stress_pot_sum_only[k] - stress_pot_sum[k], tolerance * stress_norm);
+    }
+    BOOST_CHECK(particle_sum->aux_dirty());
+
+    // a group of all particles takes the state variables from the sums
+    auto group = make_shared<particle_group_type>(particle_sum);
+    auto thermodynamics = make_shared<thermodynamics_type>(particle_sum, group, box);
+    BOOST_CHECK_CLOSE_FRACTION(thermodynamics->en_pot(), en_pot_sum / nparticle, tolerance);
+    BOOST_CHECK_CLOSE_FRACTION(thermodynamics->virial(), virial / nparticle, tolerance);
+    stress_tensor_type const& stress_tensor_sum = thermodynamics->stress_tensor();
+    float_type const stress_tensor_norm = norm_inf(stress_tensor);
+    for (unsigned int k = 0; k < stress_tensor_type::static_size; ++k) {
+        BOOST_CHECK_SMALL(stress_tensor_sum[k] - stress_tensor[k], tolerance * stress_tensor_norm);
+    }
+    // the per-particle arrays were never computed
+    BOOST_CHECK(particle_sum->aux_dirty());
+}
+
+#ifndef USE_HOST_SINGLE_PRECISION
+typedef double float_type;
+#else
+typedef float float_type;
+#endif
+
+BOOST_AUTO_TEST_CASE( pair_full_2d )
+{
+    test_aux_sum<2, float_type>(false);
+}
+
+BOOST_AUTO_TEST_CASE( pair_full_3d )
+{
+    test_aux_sum<3, float_type>(false);
+}
+
+BOOST_AUTO_TEST_CASE( pair_trunc_2d )
+{
+    test_aux_sum<2, float_type>(true);
+}
+
+BOOST_AUTO_TEST_CASE( pair_trunc_3d )
+{
+    test_aux_sum<3, float_type>(true);
+}
@@ -33,6 +33,7 @@
 #include <halmd/mdsim/host/integrators/verlet.hpp>
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/mdsim/host/particle_groups/all.hpp>
+#include <halmd/mdsim/host/particle_groups/from_range.hpp>
 #include <halmd/mdsim/host/positions/lattice.hpp>
 #include <halmd/mdsim/host/velocities/boltzmann.hpp>
 #include <halmd/numeric/accumulator.hpp>
@@ -257,6 +258,65 @@ BOOST_AUTO_TEST_CASE( ideal_gas_host_3d ) {
     ideal_gas<host_modules<3, double> >().test();
 }
 
+/**
+ * test Verlet integrator restricted to a particle group: particles outside of
+ * the group must remain at their initial positions
+ */
+template <int dimension, typename float_type>
+void frozen_particles()
+{
+    typedef mdsim::box<dimension> box_type;
+    typedef mdsim::host::particle<dimension, float_type> particle_type;
+    typedef mdsim::host::particle_groups::from_range<particle_type> particle_group_type;
+    typedef mdsim::host::integrators::verlet<dimension, float_type> integrator_type;
+    typedef typename particle_type::vector_type vector_type;
+
+    unsigned int const npart = 1000;
+    unsigned int const nmobile = 600;
+    unsigned int const steps = 100;
+    double const timestep = 0.001;
+
+    boost::numeric::ublas::diagonal_matrix<typename box_type::matrix_type::value_type> edges(dimension);
+    for (unsigned int i = 0; i < dimension; ++i) {
+        edges(i, i) = 10;
+    }
+
+    auto particle = std::make_shared<particle_type>(npart, 1);
+    auto box = std::make_shared<box_type>(edges);
+    auto group = std::make_shared<particle_group_type>(particle, std::make_pair(0u, nmobile));
+    auto integrator = std::make_shared<integrator_type>(particle, group, box, timestep);
+
+    // move all particles at unit speed along the diagonal
+    {
+        auto velocity = make_cache_mutable(particle->velocity());
+        std::fill(velocity->begin(), velocity->end(), vector_type(1));
+    }
+
+    BOOST_TEST_MESSAGE("integrate " << nmobile << " out of " << npart << " particles");
+    for (unsigned int i = 0; i < steps; ++i) {
+        integrator->integrate();
+        integrator->finalize();
+    }
+
+    // particles are not sorted, thus index equals tag
+    auto const& position = read_cache(particle->position());
+    for (unsigned int i = 0; i < npart; ++i) {
+        if (i < nmobile) {
+            BOOST_CHECK_CLOSE_FRACTION(norm_inf(position[i]), steps * timestep, 10 * eps_float);
+        }
+        else {
+            BOOST_CHECK_EQUAL(norm_inf(position[i]), 0);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( frozen_particles_host_2d ) {
+    frozen_particles<2, double>();
+}
+BOOST_AUTO_TEST_CASE( frozen_particles_host_3d ) {
+    frozen_particles<3, double>();
+}
+
 #ifdef HALMD_WITH_GPU
 template <int dimension, typename float_type>
 struct gpu_modules
@@ -38,6 +38,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <numeric>
 
 /**
  * Primitive lattice with equal number of lattice points per dimension.
@@ -660,6 +661,74 @@ static void test_stress_pot(particle_type& particle)
     );
 }
 
+/**
+ * Test rearrangement of particles in memory.
+ */
+template <typename particle_type>
+static void test_rearrange(particle_type& particle)
+{
+    typedef typename particle_type::position_type position_type;
+    typedef typename particle_type::species_type species_type;
+    typedef typename particle_type::tag_type tag_type;
+    typedef typename particle_type::force_type force_type;
+    typedef typename particle_type::en_pot_type en_pot_type;
+    particle_type const& const_particle = particle;
+    unsigned int const nparticle = particle.nparticle();
+
+    // assign square/cubic lattice vectors to positions and forces
+    equilateral_lattice<position_type> lattice(nparticle);
+    set_position(particle, make_lattice_iterator(lattice, 0));
+    set_species(particle, boost::counting_iterator<species_type>(0));
+    set_force(
+        particle
+      , make_lattice_iterator(lattice, 0)
+      , make_lattice_iterator(lattice, nparticle)
+    );
+    set_potential_energy(
+        particle
+      , boost::counting_iterator<en_pot_type>(0)
+      , boost::counting_iterator<en_pot_type>(nparticle)
+    );
+
+    // mark force as up to date
+    read_cache(particle.force());
+    unsigned int count = 0;
+    particle.on_rearrange([&]() { ++count; });
+
+    // reverse the order of every second half of a block of 4 particles
+    std::vector<unsigned int> index(nparticle);
+    std::iota(index.begin(), index.end(), 0);
+    for (unsigned int i = 0; i + 4 <= nparticle; i += 4) {
+        std::swap(index[i + 2], index[i + 3]);
+    }
+    std::reverse(index.begin(), index.end());
+    particle.rearrange(index);
+    BOOST_CHECK_EQUAL( count, 1u );
+
+    std::vector<position_type> position(nparticle);
+    get_position(const_particle, position.begin());
+    std::vector<species_type> species(nparticle);
+    get_species(const_particle, species.begin());
+    std::vector<tag_type> tag(nparticle);
+    get_tag(const_particle, tag.begin());
+    std::vector<tag_type> reverse_tag(nparticle);
+    get_reverse_tag(const_particle, reverse_tag.begin());
+    std::vector<force_type> force(nparticle);
+    get_force(particle, force.begin());
+    std::vector<en_pot_type> en_pot(nparticle);
+    get_potential_energy(particle, en_pot.begin());
+
+    for (unsigned int i = 0; i < nparticle; ++i) {
+        unsigned int j = index[i];
+        BOOST_CHECK_EQUAL( position[i], lattice(j) );
+        BOOST_CHECK_EQUAL( species[i], j );
+        BOOST_CHECK_EQUAL( tag[i], j );
+        BOOST_CHECK_EQUAL( reverse_tag[j], i );
+        BOOST_CHECK_EQUAL( force[i], force_type(lattice(j)) );
+        BOOST_CHECK_EQUAL( en_pot[i], j );
+    }
+}
+
 template <typename particle_type>
 static void
 test_suite_host(std::size_t nparticle, unsigned int nspecies, boost::unit_test::test_suite* ts)
@@ -723,6 +792,12 @@ test_suite_host(std::size_t nparticle, unsigned int nspecies, boost::unit_test::
         test_stress_pot(particle);
     };
     ts->add(BOOST_TEST_CASE( stress_pot ));
+
+    auto rearrange = [=]() {
+        particle_type particle(nparticle, nspecies);
+        test_rearrange(particle);
+    };
+    ts->add(BOOST_TEST_CASE( rearrange ));
 }
 
 #ifdef HALMD_WITH_GPU
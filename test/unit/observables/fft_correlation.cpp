@@ -0,0 +1,119 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE fft_correlation
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <halmd/mdsim/clock.hpp>
+#include <halmd/numeric/accumulator.hpp>
+#include <halmd/observables/dynamics/fft_correlation.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd;
+using namespace std;
+
+/**
+ * Compare FFT-based correlation of vector-valued time series with the
+ * direct average over all pairs of time origins.
+ */
+static void test_fft_correlation(unsigned int ncomp, unsigned int window, bool cross)
+{
+    typedef observables::dynamics::fft_correlation fft_correlation_type;
+
+    BOOST_TEST_MESSAGE("components: " << ncomp << ", window: " << window << ", cross-correlation: " << cross);
+
+    unsigned int const nsample = 1000;
+    unsigned int const interval = 5;
+    double const timestep = 0.01;
+    double const maximum_lag_time = 1.;
+
+    // correlated random series from autoregressive process
+    std::mt19937 gen;
+    std::normal_distribution<double> normal;
+    vector<vector<double>> series1(nsample, vector<double>(ncomp));
+    vector<vector<double>> series2(nsample, vector<double>(ncomp));
+    for (unsigned int t = 0; t < nsample; ++t) {
+        for (unsigned int i = 0; i < ncomp; ++i) {
+            series1[t][i] = (t > 0 ? 0.9 * series1[t - 1][i] : 1.) + normal(gen);
+            series2[t][i] = 0.5 * series1[t][i] + normal(gen) + 0.3;
+        }
+    }
+
+    auto clock = std::make_shared<mdsim::clock>();
+    clock->set_timestep(timestep);
+    unsigned int t = 0;
+    auto acquire1 = [&]() { return series1[t]; };
+    auto acquire2 = [&]() { return series2[t]; };
+    auto tcf = cross
+      ? std::make_shared<fft_correlation_type>(clock, acquire1, acquire2, maximum_lag_time, interval, window)
+      : std::make_shared<fft_correlation_type>(clock, acquire1, maximum_lag_time, interval, window);
+
+    unsigned int const nlag = tcf->size();
+    BOOST_CHECK_EQUAL(nlag, 21u);
+    BOOST_CHECK_CLOSE_FRACTION(tcf->time()[0][nlag - 1], maximum_lag_time, 1e-12);
+
+    for (t = 0; t < nsample; ++t) {
+        tcf->sample();
+        for (unsigned int s = 0; s < interval; ++s) {
+            clock->advance();
+        }
+    }
+    tcf->finalise();
+
+    // direct evaluation
+    auto const& second = cross ? series2 : series1;
+    auto const& tcf_mean = fft_correlation_type::get_mean(tcf)();
+    auto const& tcf_error = fft_correlation_type::get_error(tcf)();
+    auto const& tcf_count = fft_correlation_type::get_count(tcf)();
+    for (unsigned int k = 0; k < nlag; ++k) {
+        accumulator<double> acc;
+        for (unsigned int t = 0; t + k < nsample; ++t) {
+            double value = 0;
+            for (unsigned int i = 0; i < ncomp; ++i) {
+                value += series1[t][i] * second[t + k][i];
+            }
+            acc(value);
+        }
+        BOOST_CHECK_EQUAL(tcf_count[0][k], count(acc));
+        BOOST_CHECK_CLOSE_FRACTION(tcf_mean[0][k], mean(acc), 1e-10);
+        BOOST_CHECK_CLOSE_FRACTION(tcf_error[0][k], error_of_mean(acc), 1e-8);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( fft_correlation_scalar )
+{
+    test_fft_correlation(1, 0, false);
+    test_fft_correlation(1, 100, false);
+    test_fft_correlation(1, 100, true);
+}
+
+BOOST_AUTO_TEST_CASE( fft_correlation_vector )
+{
+    test_fft_correlation(3, 0, false);
+    test_fft_correlation(3, 128, false);
+    test_fft_correlation(3, 0, true);
+    test_fft_correlation(3, 77, true);
+}
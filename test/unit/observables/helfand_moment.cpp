@@ -0,0 +1,179 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE helfand_moment
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <halmd/mdsim/clock.hpp>
+#include <halmd/numeric/accumulator.hpp>
+#include <halmd/observables/dynamics/helfand_moment.hpp>
+#include <halmd/observables/samples/blocking_scheme.hpp>
+#include <halmd/observables/thermodynamics.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd;
+using namespace std;
+
+/**
+ * Thermodynamics module with a prescribed stress tensor at each step.
+ */
+template <int dimension>
+class stress_tensor_sequence
+  : public observables::thermodynamics<dimension>
+{
+public:
+    typedef observables::thermodynamics<dimension> _Base;
+    typedef typename _Base::vector_type vector_type;
+    typedef typename _Base::stress_tensor_type stress_tensor_type;
+
+    stress_tensor_sequence(shared_ptr<mdsim::clock const> clock, unsigned int nparticle)
+      : clock_(clock), nparticle_(nparticle), zero_(0) {}
+
+    /** stress tensor at given step */
+    static stress_tensor_type value(mdsim::clock::step_type step)
+    {
+        stress_tensor_type stress_tensor;
+        for (unsigned int i = 0; i < stress_tensor_type::static_size; ++i) {
+            stress_tensor[i] = (i + 1) * ((step % 7) - 3.) + 0.5 * step;
+        }
+        return stress_tensor;
+    }
+
+    virtual unsigned int particle_number() const { return nparticle_; }
+    virtual double volume() const { return 1; }
+    virtual double en_pot() { return 0; }
+    virtual double en_kin() { return 0; }
+    virtual vector_type const& v_cm() { return zero_; }
+    virtual vector_type const& r_cm() { return zero_; }
+    virtual double mean_mass() { return 1; }
+    virtual double virial() { return 0; }
+    virtual void aux_enable() {}
+
+    virtual stress_tensor_type const& stress_tensor()
+    {
+        stress_tensor_ = value(clock_->step());
+        return stress_tensor_;
+    }
+
+private:
+    shared_ptr<mdsim::clock const> clock_;
+    unsigned int nparticle_;
+    vector_type zero_;
+    stress_tensor_type stress_tensor_;
+};
+
+/**
+ * Integrate the Helfand moment over a number of steps, and compare the
+ * samples acquired by a blocking scheme and their correlation with the
+ * directly summed off-diagonal elements of the stress tensor.
+ */
+template <int dimension>
+static void test_helfand_moment(unsigned int interval)
+{
+    typedef observables::dynamics::helfand_moment<dimension> helfand_moment_type;
+    typedef typename helfand_moment_type::sample_type sample_type;
+    typedef stress_tensor_sequence<dimension> thermodynamics_type;
+    typedef observables::samples::blocking_scheme<sample_type> blocking_scheme_type;
+
+    unsigned int const nparticle = 1000;
+    unsigned int const nstep = 60;
+    double const timestep = 0.01;
+
+    BOOST_TEST_MESSAGE("dimension: " << dimension << ", integration interval: " << interval);
+
+    auto clock = make_shared<mdsim::clock>();
+    clock->set_timestep(timestep);
+    auto thermodynamics = make_shared<thermodynamics_type>(clock, nparticle);
+    auto helfand_moment = make_shared<helfand_moment_type>(clock, thermodynamics, interval);
+    blocking_scheme_type blocking_scheme([=]() { return helfand_moment->acquire(); }, 1, nstep + 1);
+
+    // directly summed Helfand moment, with one sample per step
+    double const dt = interval * timestep;
+    sample_type moment(0);
+    vector<sample_type> reference;
+    for (unsigned int step = 0; step <= nstep; ++step) {
+        if (step % interval == 0) {
+            auto stress_tensor = thermodynamics_type::value(step);
+            for (unsigned int i = 0; i < sample_type::static_size; ++i) {
+                moment[i] += stress_tensor[dimension + i] * dt;
+            }
+            // integration by the sampler, which is repeated to check that
+            // the stress tensor is added only once per step
+            helfand_moment->integrate();
+            helfand_moment->integrate();
+        }
+        reference.push_back(moment);
+        // samples are acquired also between the integration steps
+        if (step % 2 == 0) {
+            blocking_scheme.push_back(0);
+        }
+        BOOST_CHECK_EQUAL(*helfand_moment->acquire(), moment);
+        clock->advance();
+    }
+
+    auto const& block = blocking_scheme.index(0);
+    BOOST_REQUIRE_EQUAL(block.size(), nstep / 2 + 1);
+    for (unsigned int n = 0; n < block.size(); ++n) {
+        BOOST_CHECK_EQUAL(*block[n], reference[2 * n]);
+    }
+
+    // mean-square difference of the Helfand moment per particle
+    for (unsigned int n = 1; n < block.size(); ++n) {
+        accumulator<double> result;
+        for (unsigned int m = 0; m + n < block.size(); ++m) {
+            (*helfand_moment)(*block[m], *block[m + n], result);
+        }
+        accumulator<double> expected;
+        for (unsigned int m = 0; m + n < block.size(); ++m) {
+            sample_type delta = reference[2 * (m + n)] - reference[2 * m];
+            expected(inner_prod(delta, delta) / nparticle);
+        }
+        BOOST_CHECK_EQUAL(count(result), count(expected));
+        BOOST_CHECK_CLOSE_FRACTION(mean(result), mean(expected), 1e-14);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( helfand_moment_2d )
+{
+    test_helfand_moment<2>(1);
+    test_helfand_moment<2>(3);
+}
+
+BOOST_AUTO_TEST_CASE( helfand_moment_3d )
+{
+    test_helfand_moment<3>(1);
+    test_helfand_moment<3>(4);
+}
+
+/**
+ * The integration interval must be non-zero.
+ */
+BOOST_AUTO_TEST_CASE( helfand_moment_interval )
+{
+    auto clock = make_shared<mdsim::clock>();
+    auto thermodynamics = make_shared<stress_tensor_sequence<3>>(clock, 1);
+    BOOST_CHECK_THROW(observables::dynamics::helfand_moment<3>(clock, thermodynamics, 0), invalid_argument);
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE partitioned
+#include <boost/test/unit_test.hpp>
+
+#include <boost/multi_array.hpp>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <halmd/numeric/accumulator.hpp>
+#include <halmd/observables/host/dynamics/mean_square_displacement.hpp>
+#include <halmd/observables/host/dynamics/partitioned.hpp>
+#include <halmd/observables/host/dynamics/velocity_autocorrelation.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd;
+using namespace std;
+
+/**
+ * Compare correlation functions resolved by groups of particles with the
+ * correlation functions of the separate groups.
+ */
+template <typename tcf_type>
+static void test_partitioned(bool by_species)
+{
+    typedef typename tcf_type::sample_type sample_type;
+    typedef observables::host::dynamics::partitioned<tcf_type> partitioned_type;
+
+    unsigned int const nparticle = 1000;
+    unsigned int const ngroup = 3;
+
+    BOOST_TEST_MESSAGE("partition by species: " << by_species);
+
+    // two samples with random positions and velocities
+    std::mt19937 gen;
+    std::normal_distribution<double> normal;
+    std::uniform_int_distribution<unsigned int> uniform(0, ngroup - 1);
+    sample_type first(nparticle), second(nparticle);
+    std::vector<unsigned int> partition(nparticle);
+    for (unsigned int i = 0; i < nparticle; ++i) {
+        for (unsigned int j = 0; j < sample_type::vector_type::static_size; ++j) {
+            first.position()[i][j] = normal(gen);
+            second.position()[i][j] = normal(gen);
+            first.velocity()[i][j] = normal(gen);
+            second.velocity()[i][j] = normal(gen);
+        }
+        partition[i] = uniform(gen);
+        first.species()[i] = second.species()[i] = partition[i];
+    }
+
+    auto tcf = by_species ? partitioned_type(ngroup) : partitioned_type(partition);
+    BOOST_CHECK_EQUAL(*tcf.result_shape(), ngroup);
+
+    boost::multi_array<accumulator<double>, 1> result(boost::extents[ngroup]);
+    tcf(first, second, result);
+
+    // correlation functions of the separate groups
+    for (unsigned int group = 0; group < ngroup; ++group) {
+        std::vector<unsigned int> index;
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            if (partition[i] == group) {
+                index.push_back(i);
+            }
+        }
+        sample_type first_group(index.size()), second_group(index.size());
+        for (unsigned int i = 0; i < index.size(); ++i) {
+            first_group.position()[i] = first.position()[index[i]];
+            second_group.position()[i] = second.position()[index[i]];
+            first_group.velocity()[i] = first.velocity()[index[i]];
+            second_group.velocity()[i] = second.velocity()[index[i]];
+        }
+        accumulator<double> acc;
+        tcf_type()(first_group, second_group, acc);
+
+        BOOST_CHECK_EQUAL(count(result[group]), count(acc));
+        BOOST_CHECK_CLOSE_FRACTION(mean(result[group]), mean(acc), 1e-12);
+        BOOST_CHECK_CLOSE_FRACTION(variance(result[group]), variance(acc), 1e-10);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( partitioned_mean_square_displacement )
+{
+    typedef observables::host::dynamics::mean_square_displacement<3, double> tcf_type;
+    test_partitioned<tcf_type>(true);
+    test_partitioned<tcf_type>(false);
+}
+
+BOOST_AUTO_TEST_CASE( partitioned_velocity_autocorrelation )
+{
+    typedef observables::host::dynamics::velocity_autocorrelation<2, float> tcf_type;
+    test_partitioned<tcf_type>(true);
+    test_partitioned<tcf_type>(false);
+}
+
+/**
+ * A partition must have an entry for each particle of the samples.
+ */
+BOOST_AUTO_TEST_CASE( partitioned_mismatching_size )
+{
+    typedef observables::host::dynamics::mean_square_displacement<3, double> tcf_type;
+    typedef observables::host::dynamics::partitioned<tcf_type> partitioned_type;
+    typedef tcf_type::sample_type sample_type;
+
+    unsigned int const nparticle = 100;
+    sample_type first(nparticle), second(nparticle);
+    boost::multi_array<accumulator<double>, 1> result(boost::extents[2]);
+
+    partitioned_type shorter(std::vector<unsigned int>(nparticle - 1, 1));
+    BOOST_CHECK_THROW(shorter(first, second, result), std::invalid_argument);
+    partitioned_type longer(std::vector<unsigned int>(nparticle + 1, 1));
+    BOOST_CHECK_THROW(longer(first, second, result), std::invalid_argument);
+    BOOST_CHECK_THROW(partitioned_type(std::vector<unsigned int>()), std::invalid_argument);
+}
+
+/**
+ * The species of the particles must be less than the number of species.
+ */
+BOOST_AUTO_TEST_CASE( partitioned_invalid_species )
+{
+    typedef observables::host::dynamics::mean_square_displacement<3, double> tcf_type;
+    typedef observables::host::dynamics::partitioned<tcf_type> partitioned_type;
+    typedef tcf_type::sample_type sample_type;
+
+    unsigned int const nparticle = 100;
+    unsigned int const nspecies = 2;
+    sample_type first(nparticle), second(nparticle);
+    for (unsigned int i = 0; i < nparticle; ++i) {
+        first.species()[i] = second.species()[i] = i % nspecies;
+    }
+    boost::multi_array<accumulator<double>, 1> result(boost::extents[nspecies]);
+
+    partitioned_type tcf(nspecies);
+    BOOST_CHECK_NO_THROW(tcf(first, second, result));
+    first.species()[nparticle / 2] = nspecies;
+    BOOST_CHECK_THROW(tcf(first, second, result), std::invalid_argument);
+}
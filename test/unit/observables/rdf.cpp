@@ -0,0 +1,177 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE rdf
+#include <boost/test/unit_test.hpp>
+
+#include <boost/numeric/ublas/banded.hpp>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/host/max_displacement.hpp>
+#include <halmd/mdsim/host/neighbours/from_particle.hpp>
+#include <halmd/mdsim/host/particle.hpp>
+#include <halmd/observables/host/rdf.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd;
+using namespace std;
+
+/**
+ * Compare radial distribution functions from neighbour lists with a direct
+ * evaluation over all pairs of particles.
+ */
+template <int dimension>
+void test_rdf(bool distinct)
+{
+    typedef mdsim::box<dimension> box_type;
+    typedef mdsim::host::particle<dimension, double> particle_type;
+    typedef mdsim::host::max_displacement<dimension, double> displacement_type;
+    typedef mdsim::host::neighbours::from_particle<dimension, double> neighbour_type;
+    typedef observables::host::rdf<dimension, double> rdf_type;
+    typedef typename particle_type::vector_type vector_type;
+
+    BOOST_TEST_MESSAGE("distinct particle instances: " << distinct);
+
+    unsigned int const npart = 1000;
+    unsigned int const nspecies = 2;
+    double const r_cut = 2.5;
+    unsigned int const nbin = 25;
+
+    boost::numeric::ublas::diagonal_matrix<typename box_type::matrix_type::value_type> edges(dimension);
+    for (unsigned int i = 0; i < dimension; ++i) {
+        edges(i, i) = (dimension == 3) ? 10 + i : 30 + i;
+    }
+    auto box = std::make_shared<box_type>(edges);
+
+    // set up particle instances with random positions and species
+    std::mt19937 gen;
+    std::uniform_real_distribution<double> uniform(-0.5, 0.5);
+    vector<shared_ptr<particle_type>> particle;
+    vector<vector<vector_type>> position;
+    vector<vector<unsigned int>> species;
+    for (unsigned int n = 0; n < (distinct ? 2u : 1u); ++n) {
+        particle.push_back(std::make_shared<particle_type>(npart, nspecies));
+        position.emplace_back(npart);
+        species.emplace_back(npart);
+        for (unsigned int i = 0; i < npart; ++i) {
+            for (unsigned int j = 0; j < dimension; ++j) {
+                position[n][i][j] = uniform(gen) * box->length()[j];
+            }
+            species[n][i] = (i % 3 == 0) ? 1 : 0;
+        }
+        set_position(*particle[n], position[n].begin());
+        set_species(*particle[n], species[n].begin());
+    }
+    unsigned int const second = distinct ? 1 : 0;
+
+    auto displacement1 = std::make_shared<displacement_type>(particle.front(), box);
+    auto displacement2 = distinct ? std::make_shared<displacement_type>(particle.back(), box) : displacement1;
+    typename neighbour_type::matrix_type r_cut_matrix(nspecies, nspecies);
+    for (unsigned int a = 0; a < nspecies; ++a) {
+        for (unsigned int b = 0; b < nspecies; ++b) {
+            r_cut_matrix(a, b) = r_cut;
+        }
+    }
+    auto neighbour = std::make_shared<neighbour_type>(
+        make_pair(particle.front(), particle.back())
+      , make_pair(displacement1, displacement2)
+      , box
+      , r_cut_matrix
+      , 0.5
+    );
+    auto rdf = std::make_shared<rdf_type>(
+        make_pair(particle.front(), particle.back())
+      , box
+      , neighbour
+      , r_cut
+      , nbin
+    );
+
+    rdf->sample();
+    rdf->sample(); // skipped, positions unchanged
+    BOOST_CHECK_EQUAL(rdf->count(), 1u);
+
+    // histogram over all pairs
+    vector<double> histogram(nspecies * nspecies * nbin, 0);
+    vector<double> count(nspecies, 0);
+    for (unsigned int i = 0; i < npart; ++i) {
+        ++count[species[second][i]];
+        for (unsigned int j = 0; j < npart; ++j) {
+            if (!distinct && i == j) {
+                continue;
+            }
+            vector_type r = position[0][i] - position[second][j];
+            box->reduce_periodic(r);
+            double d = norm_2(r);
+            if (d < r_cut) {
+                unsigned int k = d * nbin / r_cut;
+                histogram[(species[0][i] * nspecies + species[second][j]) * nbin + k] += 1;
+            }
+        }
+    }
+
+    auto const& value = rdf->value();
+    BOOST_REQUIRE_EQUAL(value.size(), histogram.size());
+    double const unit_volume = (dimension == 3) ? 4 * M_PI / 3 : M_PI;
+    double const dr = r_cut / nbin;
+    for (unsigned int a = 0; a < nspecies; ++a) {
+        for (unsigned int b = 0; b < nspecies; ++b) {
+            double density = (count[b] - (!distinct && a == b ? 1 : 0)) / box->volume();
+            // count[a] of first instance equals that of second instance by construction
+            double norm = count[a] * density;
+            for (unsigned int k = 0; k < nbin; ++k) {
+                double shell = unit_volume * (pow((k + 1) * dr, dimension) - pow(k * dr, dimension));
+                unsigned int index = (a * nspecies + b) * nbin + k;
+                BOOST_CHECK_CLOSE_FRACTION(value[index], histogram[index] / (norm * shell), 1e-12);
+            }
+        }
+    }
+
+    // the positions are uncorrelated, g(r) ≈ 1 beyond the first few bins
+    double mean = 0;
+    for (unsigned int k = nbin / 2; k < nbin; ++k) {
+        mean += value[k];
+    }
+    mean /= nbin - nbin / 2;
+    BOOST_CHECK_CLOSE_FRACTION(mean, 1, 0.1);
+
+    rdf->reset();
+    BOOST_CHECK_EQUAL(rdf->count(), 0u);
+    rdf->sample();
+    BOOST_CHECK_EQUAL(rdf->count(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE( rdf_host_2d )
+{
+    test_rdf<2>(false);
+    test_rdf<2>(true);
+}
+
+BOOST_AUTO_TEST_CASE( rdf_host_3d )
+{
+    test_rdf<3>(false);
+    test_rdf<3>(true);
+}
@@ -31,10 +31,12 @@
 #include <limits>
 #include <memory>
 #include <numeric>
+#include <random>
 
 #include <halmd/mdsim/box.hpp>
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/mdsim/host/particle_groups/all.hpp>
+#include <halmd/mdsim/host/particle_groups/from_range.hpp>
 #include <halmd/mdsim/host/positions/lattice.hpp>
 #include <halmd/numeric/accumulator.hpp>
 #include <halmd/observables/host/density_mode.hpp>
@@ -288,6 +290,94 @@ BOOST_AUTO_TEST_CASE( ssf_host_3d ) {
     lattice<host_modules<3, double> >().test();
 }
 
+/**
+ * test density modes of several particle groups accumulated in a shared loop
+ * over the particles against a direct evaluation of the exponentials
+ */
+template <int dimension, typename float_type>
+void density_mode_share()
+{
+    typedef mdsim::box<dimension> box_type;
+    typedef mdsim::host::particle<dimension, float_type> particle_type;
+    typedef mdsim::host::particle_groups::from_range<particle_type> particle_group_type;
+    typedef observables::host::density_mode<dimension, float_type> density_mode_type;
+    typedef observables::utility::wavevector<dimension> wavevector_type;
+    typedef typename particle_type::vector_type vector_type;
+    typedef typename wavevector_type::vector_type wavevector_vector_type;
+
+    unsigned int const npart = 1000;
+    boost::numeric::ublas::diagonal_matrix<typename box_type::matrix_type::value_type> edges(dimension);
+    for (unsigned int i = 0; i < dimension; ++i) {
+        edges(i, i) = 10 + 3 * i;
+    }
+    auto box = std::make_shared<box_type>(edges);
+    auto particle = std::make_shared<particle_type>(npart, 1);
+
+    vector<double> wavenumber = {1, 2.5, 8};
+    auto wavevector = std::make_shared<wavevector_type>(wavenumber, box->length(), 0.05, 2 * dimension);
+    auto const& q = wavevector->value();
+    BOOST_TEST_MESSAGE("number of wavevectors: " << q.size());
+
+    typedef typename particle_group_type::range_type range_type;
+    vector<range_type> range = {{0, 400}, {300, npart}, {200, 201}};
+    vector<shared_ptr<particle_group_type>> group;
+    vector<shared_ptr<density_mode_type>> density_mode;
+    for (auto const& r : range) {
+        group.push_back(std::make_shared<particle_group_type>(particle, r));
+        if (density_mode.empty()) {
+            density_mode.push_back(std::make_shared<density_mode_type>(particle, group.back(), wavevector));
+        }
+        else {
+            density_mode.push_back(std::make_shared<density_mode_type>(density_mode.front(), group.back()));
+        }
+    }
+
+    std::mt19937 gen;
+    std::uniform_real_distribution<double> uniform(0, 1);
+    for (unsigned int step = 0; step < 2; ++step) {
+        vector<vector_type> position(npart);
+        for (auto& r : position) {
+            for (unsigned int j = 0; j < dimension; ++j) {
+                r[j] = (uniform(gen) - 0.5) * box->length()[j];
+            }
+        }
+        set_position(*particle, position.begin());
+
+        // acquire groups in reverse order to trigger the shared loop from
+        // a sharing instance
+        vector<shared_ptr<typename density_mode_type::result_type const>> result(range.size());
+        for (unsigned int k = range.size(); k > 0; --k) {
+            result[k - 1] = density_mode[k - 1]->acquire();
+        }
+        for (unsigned int k = 0; k < range.size(); ++k) {
+            // results are cached
+            BOOST_CHECK(density_mode[k]->acquire() == result[k]);
+            BOOST_CHECK(density_mode[k]->wavevector() == wavevector);
+            BOOST_REQUIRE_EQUAL(result[k]->size(), q.size());
+
+            unsigned int count = range[k].second - range[k].first;
+            for (unsigned int m = 0; m < q.size(); ++m) {
+                double re = 0, im = 0;
+                for (unsigned int i = range[k].first; i < range[k].second; ++i) {
+                    double q_r = inner_prod(q[m], static_cast<wavevector_vector_type>(position[i]));
+                    re += cos(q_r);
+                    im -= sin(q_r);
+                }
+                double tolerance = count * 100 * numeric_limits<double>::epsilon();
+                BOOST_CHECK_SMALL((*result[k])[m][0] - re, tolerance);
+                BOOST_CHECK_SMALL((*result[k])[m][1] - im, tolerance);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( density_mode_share_host_2d ) {
+    density_mode_share<2, double>();
+}
+BOOST_AUTO_TEST_CASE( density_mode_share_host_3d ) {
+    density_mode_share<3, double>();
+}
+
 #ifdef HALMD_WITH_GPU
 template <int dimension, typename float_type>
 struct gpu_modules
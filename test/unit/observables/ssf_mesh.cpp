@@ -0,0 +1,164 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE ssf_mesh
+#include <boost/test/unit_test.hpp>
+
+#include <boost/numeric/ublas/banded.hpp>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/host/particle.hpp>
+#include <halmd/mdsim/host/particle_groups/all.hpp>
+#include <halmd/numeric/accumulator.hpp>
+#include <halmd/observables/host/ssf_mesh.hpp>
+#include <halmd/observables/utility/wavevector.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd;
+using namespace std;
+
+/**
+ * Compare static structure factor on the mesh with the exact structure factor
+ * of random particle positions, for wavenumbers small compared to the inverse
+ * mesh spacing.
+ */
+template <int dimension>
+void test_ssf_mesh(unsigned int order, double tolerance)
+{
+    typedef mdsim::box<dimension> box_type;
+    typedef mdsim::host::particle<dimension, double> particle_type;
+    typedef mdsim::host::particle_groups::all<particle_type> particle_group_type;
+    typedef observables::host::ssf_mesh<dimension, double> ssf_mesh_type;
+    typedef observables::utility::wavevector<dimension> wavevector_type;
+    typedef typename particle_type::vector_type vector_type;
+    typedef fixed_vector<double, dimension> wavevector_vector_type;
+
+    BOOST_TEST_MESSAGE("assignment order: " << order);
+
+    unsigned int const npart = 2000;
+    boost::numeric::ublas::diagonal_matrix<typename box_type::matrix_type::value_type> edges(dimension);
+    for (unsigned int i = 0; i < dimension; ++i) {
+        edges(i, i) = 10 + 2 * i;
+    }
+    auto box = std::make_shared<box_type>(edges);
+    auto particle = std::make_shared<particle_type>(npart, 1);
+    auto group = std::make_shared<particle_group_type>(particle);
+
+    std::mt19937 gen;
+    std::uniform_real_distribution<double> uniform(-0.5, 0.5);
+    vector<vector_type> position(npart);
+    for (auto& r : position) {
+        for (unsigned int j = 0; j < dimension; ++j) {
+            r[j] = uniform(gen) * box->length()[j];
+        }
+    }
+    set_position(*particle, position.begin());
+
+    typename ssf_mesh_type::shape_type shape(32);
+    vector<double> wavenumber = {0.8, 1.5};
+    double const q_tolerance = 0.05;
+    auto wavevector = std::make_shared<wavevector_type>(wavenumber, box->length(), q_tolerance, 1);
+    auto ssf = std::make_shared<ssf_mesh_type>(particle, group, wavevector, shape, order, npart);
+
+    auto const& result = ssf->sample();
+    auto const& grid = ssf->grid();
+    BOOST_CHECK_EQUAL(result.size(), wavenumber.size());
+
+    // enumerate full reciprocal mesh and map onto output of r2c transform
+    vector<accumulator<double>> acc(wavenumber.size());
+    unsigned int nmesh = 1;
+    for (unsigned int j = 0; j < dimension; ++j) {
+        nmesh *= shape[j];
+    }
+    double max_error = 0;
+    for (unsigned int k = 0; k < nmesh; ++k) {
+        fixed_vector<int, dimension> n;
+        unsigned int m = k;
+        for (int j = dimension - 1; j >= 0; --j) {
+            int x = m % shape[j];
+            m /= shape[j];
+            n[j] = (2 * x < int(shape[j])) ? x : x - int(shape[j]);
+        }
+        wavevector_vector_type q;
+        for (unsigned int j = 0; j < dimension; ++j) {
+            q[j] = 2 * M_PI * n[j] / box->length()[j];
+        }
+        double q_norm = norm_2(q);
+        if (q_norm > wavenumber.back() * (1 + q_tolerance) || q_norm == 0) {
+            continue;
+        }
+
+        // exact structure factor
+        double re = 0, im = 0;
+        for (auto const& r : position) {
+            double q_r = inner_prod(q, static_cast<wavevector_vector_type>(r));
+            re += cos(q_r);
+            im -= sin(q_r);
+        }
+        double S_q = (re * re + im * im) / npart;
+
+        // index of S(q) or S(-q) in output of real-to-complex transform
+        fixed_vector<int, dimension> n_half = (n[dimension - 1] < 0) ? fixed_vector<int, dimension>(-n) : n;
+        unsigned int index = 0;
+        for (unsigned int j = 0; j < dimension; ++j) {
+            int extent = (j < dimension - 1) ? shape[j] : shape[j] / 2 + 1;
+            int x = (n_half[j] + int(shape[j])) % int(shape[j]);
+            index = index * extent + x;
+        }
+        BOOST_CHECK_SMALL(grid[index] - S_q, tolerance * max(S_q, 1.));
+        max_error = max(max_error, fabs(grid[index] - S_q) / max(S_q, 1.));
+
+        for (unsigned int i = 0; i < wavenumber.size(); ++i) {
+            if (fabs(q_norm - wavenumber[i]) <= q_tolerance * wavenumber[i]) {
+                acc[i](grid[index]);
+            }
+        }
+    }
+    BOOST_TEST_MESSAGE("maximum relative deviation: " << max_error);
+
+    for (unsigned int i = 0; i < wavenumber.size(); ++i) {
+        BOOST_CHECK_EQUAL(result[i][2], count(acc[i]));
+        BOOST_CHECK_CLOSE_FRACTION(result[i][0], mean(acc[i]), 1e-12);
+        BOOST_CHECK_CLOSE_FRACTION(result[i][1], error_of_mean(acc[i]), 1e-12);
+    }
+
+    // result is cached
+    BOOST_CHECK(&ssf->sample() == &result);
+}
+
+BOOST_AUTO_TEST_CASE( ssf_mesh_host_2d )
+{
+    test_ssf_mesh<2>(2, 5e-2);
+    test_ssf_mesh<2>(3, 1e-2);
+    test_ssf_mesh<2>(4, 5e-3);
+}
+
+BOOST_AUTO_TEST_CASE( ssf_mesh_host_3d )
+{
+    test_ssf_mesh<3>(2, 5e-2);
+    test_ssf_mesh<3>(3, 1e-2);
+    test_ssf_mesh<3>(4, 5e-3);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright © 2026  The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE recycler
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <halmd/utility/owner_equal.hpp>
+#include <halmd/utility/raw_array.hpp>
+#include <halmd/utility/recycler.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd;
+
+typedef raw_array<double> array_type;
+
+static std::shared_ptr<array_type> get(recycler<array_type>& pool, std::size_t size)
+{
+    return pool.get(
+        [&](array_type const& array) { return array.size() == size; }
+      , [&]() { return new array_type(size); }
+    );
+}
+
+BOOST_AUTO_TEST_CASE( reuse )
+{
+    recycler<array_type> pool(2);
+
+    auto first = get(pool, 100);
+    double const* memory = &(*first)[0];
+    std::weak_ptr<array_type> observer = first;
+    BOOST_CHECK_EQUAL(pool.size(), 0u);
+
+    // released object is reused with a new owner
+    first.reset();
+    BOOST_CHECK_EQUAL(pool.size(), 1u);
+    auto second = get(pool, 100);
+    BOOST_CHECK_EQUAL(&(*second)[0], memory);
+    BOOST_CHECK_EQUAL(pool.size(), 0u);
+    BOOST_CHECK(observer.expired());
+    BOOST_CHECK(!owner_equal(observer, second));
+
+    // objects held elsewhere are not reused
+    auto third = get(pool, 100);
+    BOOST_CHECK(&(*third)[0] != memory);
+
+    // mismatching objects are discarded
+    second.reset();
+    auto fourth = get(pool, 50);
+    BOOST_CHECK_EQUAL(fourth->size(), 50u);
+    BOOST_CHECK_EQUAL(pool.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE( capacity )
+{
+    recycler<array_type> pool(2);
+    std::vector<std::shared_ptr<array_type>> array;
+    for (unsigned int i = 0; i < 4; ++i) {
+        array.push_back(get(pool, 10));
+    }
+    array.clear();
+    BOOST_CHECK_EQUAL(pool.size(), 2u);
+    pool.clear();
+    BOOST_CHECK_EQUAL(pool.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE( lifetime )
+{
+    std::shared_ptr<array_type> array;
+    {
+        recycler<array_type> pool;
+        array = get(pool, 10);
+    }
+    // release after destruction of recycler deletes the object
+    array.reset();
+}